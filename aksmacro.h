@@ -82,6 +82,16 @@
 #endif
 #endif
 
+/* If AKS_EMULATE_WIN_UNICODE is selected on POSIX, define both Unicode
+ * mode macros so that the Windows Unicode translation layer is built
+ * over an emulated wide-character API; on Windows it has no effect */
+#ifdef AKS_POSIX
+#ifdef AKS_EMULATE_WIN_UNICODE
+#define AKS_WIN_WAPI
+#define AKS_WIN_WCRT
+#endif
+#endif
+
 /* * * * * * * *
  *             *
  * ANSI check  *
@@ -108,6 +118,278 @@
 #endif
 #endif
 
+/* * * * * * * * *
+ *               *
+ * Linkage mode  *
+ *               *
+ * * * * * * * * */
+
+/* By default, every function the header defines is static, so each
+ * translation unit that includes it compiles a private copy of the
+ * functions it uses.  AKS_EXTERN gives the public functions external
+ * linkage instead; exactly one translation unit must then also define
+ * AKS_IMPLEMENTATION to emit the definitions, while the rest only see
+ * declarations.  AKS_IMPLEMENTATION on its own implies AKS_EXTERN. */
+#ifdef AKS_IMPLEMENTATION
+#ifndef AKS_EXTERN
+#define AKS_EXTERN
+#endif
+#endif
+
+#ifdef AKS_EXTERN
+#ifdef AKS_INLINE
+#error aksmacro: AKS_EXTERN and AKS_INLINE are mutually exclusive.
+#endif
+#endif
+
+/* Define the linkage macros if not already defined:
+ * 
+ *   AKS_API - storage class of public functions
+ *   AKS_INTERNAL - storage class of internal helper functions
+ *   AKS_API_DATA - storage class of tables read by public macros
+ *   AKS_BODIES - defined if function bodies are compiled in this
+ *   translation unit */
+#ifndef AKS_LINKAGE_INCLUDED
+#define AKS_LINKAGE_INCLUDED
+
+#ifdef AKS_INLINE
+#ifdef _MSC_VER
+#define AKS_INLINE_KEYWORD __inline
+#else
+#ifdef __GNUC__
+#define AKS_INLINE_KEYWORD __inline__
+#else
+#define AKS_INLINE_KEYWORD inline
+#endif
+#endif
+
+#define AKS_API static AKS_INLINE_KEYWORD
+#define AKS_INTERNAL static AKS_INLINE_KEYWORD
+#define AKS_API_DATA static
+#define AKS_BODIES
+
+#else
+#ifdef AKS_EXTERN
+#define AKS_API
+#define AKS_INTERNAL static
+#define AKS_API_DATA
+#ifdef AKS_IMPLEMENTATION
+#define AKS_BODIES
+#endif
+
+#else
+#define AKS_API static
+#define AKS_INTERNAL static
+#define AKS_API_DATA static
+#define AKS_BODIES
+#endif
+#endif
+
+#endif
+
+/* * * * * * * * * *
+ *                 *
+ * Path extensions *
+ *                 *
+ * * * * * * * * * */
+
+/* Extensions that take UTF-8 paths use the translation layer, so
+ * define AKS_TRANSLATE for them if not already defined */
+#ifdef AKS_TMPFILE
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+#ifdef AKS_DIR
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+#ifdef AKS_STAT
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+#ifdef AKS_SPAWN
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+#ifdef AKS_SYNC
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+#ifdef AKS_PREALLOC
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+#ifdef AKS_DIRECT
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+/* The string builder hands its buffer to the translation layer, so
+ * define AKS_TRANSLATE for it as well */
+#ifdef AKS_SBUF
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+/* Tracing writes its trace through the translation layer and traces
+ * the translation functions, so define AKS_TRANSLATE for it too */
+#ifdef AKS_TRACE
+#ifndef AKS_TRANSLATE
+#define AKS_TRANSLATE
+#endif
+#endif
+
+/* Preallocated output uses the aks_off64 type, so define AKS_FILE64 for
+ * it if not already defined */
+#ifdef AKS_PREALLOC
+#ifndef AKS_FILE64
+#define AKS_FILE64
+#endif
+#endif
+
+/* * * * * * * * * * * *
+ *                     *
+ * POSIX declarations  *
+ *                     *
+ * * * * * * * * * * * */
+
+/* Extensions that call POSIX functions beyond standard C must check
+ * that the system headers declare them, since that depends on the
+ * feature test macros in effect */
+#ifdef AKS_TMPFILE
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_STAT
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_SPAWN
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_SYNC
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_STDIO_UNLOCKED
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_DIRECT
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_VECIO
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_PREALLOC
+#define AKS_POSIX_DECL_CHECK
+#endif
+
+#ifdef AKS_POSIX
+#ifdef AKS_POSIX_DECL_CHECK
+#ifndef AKS_POSIX_DECL_INCLUDED
+#define AKS_POSIX_DECL_INCLUDED
+
+/* Get the feature test macros that the system sets by default */
+#include <unistd.h>
+
+/* Note whether any feature test macro is set at all */
+#ifdef _POSIX_SOURCE
+#define AKS_POSIX_DECL_FTM
+#endif
+
+#ifdef _POSIX_C_SOURCE
+#define AKS_POSIX_DECL_FTM
+#endif
+
+#ifdef _XOPEN_SOURCE
+#define AKS_POSIX_DECL_FTM
+#endif
+
+/* The BSD and GNU feature test macros declare everything, and so does
+ * the absence of any feature test macro outside of strict modes */
+#ifdef _DEFAULT_SOURCE
+#define AKS_POSIX_DECL_MISC
+#endif
+
+#ifdef _BSD_SOURCE
+#define AKS_POSIX_DECL_MISC
+#endif
+
+#ifdef _GNU_SOURCE
+#define AKS_POSIX_DECL_MISC
+#endif
+
+#ifndef AKS_POSIX_DECL_FTM
+#ifndef __STRICT_ANSI__
+#ifndef AKS_POSIX_DECL_MISC
+#define AKS_POSIX_DECL_MISC
+#endif
+#endif
+#endif
+
+/* POSIX revision implied by _XOPEN_SOURCE */
+#ifdef _XOPEN_SOURCE
+#if (_XOPEN_SOURCE - 0) >= 700
+#define AKS_POSIX_DECL_XOPEN 200809L
+#elif (_XOPEN_SOURCE - 0) >= 600
+#define AKS_POSIX_DECL_XOPEN 200112L
+#elif (_XOPEN_SOURCE - 0) >= 500
+#define AKS_POSIX_DECL_XOPEN 199506L
+#else
+#define AKS_POSIX_DECL_XOPEN 1L
+#endif
+#else
+#define AKS_POSIX_DECL_XOPEN 0L
+#endif
+
+/* POSIX revision requested by _POSIX_C_SOURCE or _POSIX_SOURCE */
+#ifdef _POSIX_C_SOURCE
+#define AKS_POSIX_DECL_PCS (_POSIX_C_SOURCE - 0)
+#else
+#ifdef _POSIX_SOURCE
+#define AKS_POSIX_DECL_PCS 1L
+#else
+#define AKS_POSIX_DECL_PCS 0L
+#endif
+#endif
+
+/*
+ * The POSIX revision, as a _POSIX_C_SOURCE value, whose interfaces the
+ * system headers declare, or zero if none are declared.
+ * 
+ * AKS_POSIX_DECL_XOPEN is also at least 199506L when the X/Open
+ * extensions of that time, such as mkstemp(), are declared.
+ */
+#ifdef AKS_POSIX_DECL_MISC
+#define AKS_POSIX_DECL 200809L
+#elif AKS_POSIX_DECL_XOPEN > AKS_POSIX_DECL_PCS
+#define AKS_POSIX_DECL AKS_POSIX_DECL_XOPEN
+#else
+#define AKS_POSIX_DECL AKS_POSIX_DECL_PCS
+#endif
+
+#endif
+#endif
+#endif
+
 /* * * * * * * * * * *
  *                   *
  * seterr extension  *
@@ -196,123 +478,666 @@
 
 /* * * * * * * * * * *
  *                   *
- * Translation layer *
+ * Unicode emulation *
  *                   *
  * * * * * * * * * * */
 
-/* If AKS_TRANSLATE selected and AKS_TRANSLATE_INCLUDED hasn't been
- * defined yet, define AKS_TRANSLATE_INCLUDED and then define the
- * translation layer functions appropriate for the platform */
-#ifdef AKS_TRANSLATE
-#ifndef AKS_TRANSLATE_INCLUDED
-#define AKS_TRANSLATE_INCLUDED
-
+/* If the Windows Unicode translation layer is being emulated on POSIX
+ * and AKS_EMULATE_WIN_UNICODE_INCLUDED hasn't been defined yet, define
+ * it and then define a portable UTF-8/UTF-16 transcoder along with the
+ * parts of the Windows wide-character API that the translation layer
+ * calls */
+#ifdef AKS_EMULATE_WIN_UNICODE
 #ifdef AKS_POSIX
-/* POSIX implementation of translation layer ======================== */
+#ifdef AKS_TRANSLATE
+#ifndef AKS_EMULATE_WIN_UNICODE_INCLUDED
+#define AKS_EMULATE_WIN_UNICODE_INCLUDED
 
+#include <errno.h>
+#include <limits.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 /*
- * Define the generic character type.
+ * The wchar_t type is 32 bits wide on POSIX, so the emulated UTF-16
+ * code units are held in an unsigned short, as they are in a wchar_t on
+ * Windows.
  */
-typedef char aks_tchar;
+typedef unsigned short aks_emu_wchar;
+
+#ifdef AKS_BODIES
 
 /*
- * Convert an 8-bit string to a generic string.
+ * Transcode UTF-8 into UTF-16.
  * 
- * On POSIX, this just makes a dynamic copy of the string.
+ * This follows MultiByteToWideChar() with the CP_UTF8 code page and the
+ * MB_ERR_INVALID_CHARS flag.  If srclen is -1, the source is nul
+ * terminated and the terminating nul is transcoded too.  Overlong
+ * forms, encoded surrogates, code points beyond U+10FFFF, and truncated
+ * sequences are all errors.  If cap is zero, nothing is written and the
+ * number of code units the transcoding requires is returned.
  * 
  * Parameters:
  * 
- *   pStr - the 8-bit string
+ *   pSrc - the UTF-8 source
+ * 
+ *   srclen - the number of bytes in the source, or -1
+ * 
+ *   pDst - the buffer to receive the UTF-16, or NULL if cap is zero
+ * 
+ *   cap - the number of code units the buffer can hold
  * 
  * Return:
  * 
- *   the dynamically allocated generic string copy, or NULL if error
+ *   the number of code units written or required, or zero if the
+ *   source is invalid or the buffer is too small
  */
-static aks_tchar *aks_toapi(const char *pStr) {
+AKS_INTERNAL int aks_emu_utf8to16(
+    const char          * pSrc,
+          int             srclen,
+          aks_emu_wchar * pDst,
+          int             cap) {
   
-  aks_tchar *pResult = NULL;
+  const unsigned char *ps = NULL;
+  const unsigned char *pe = NULL;
+  unsigned long c = 0;
+  unsigned long lo = 0;
+  size_t len = 0;
+  int extra = 0;
+  int count = 0;
+  int err = 0;
+  int i = 0;
   
-  /* Only proceed if non-NULL value passed */
-  if (pStr != NULL) {
+  /* Check parameters, measuring a nul-terminated source */
+  if ((pSrc == NULL) || (cap < 0) || ((cap > 0) && (pDst == NULL))) {
+    err = 1;
+  }
+  if ((!err) && (srclen == -1)) {
+    len = strlen(pSrc);
+    if (len < (size_t) INT_MAX) {
+      srclen = (int) (len + 1);
+    } else {
+      err = 1;
+    }
+  }
+  if ((!err) && (srclen < 1)) {
+    err = 1;
+  }
+  
+  if (!err) {
+    ps = (const unsigned char *) pSrc;
+    pe = ps + srclen;
+  }
+  
+  while ((!err) && (ps < pe)) {
     
-    /* Allocate copy */
-    pResult = (aks_tchar *) malloc(strlen(pStr) + 1);
+    /* Determine the number of continuation bytes from the lead byte,
+     * along with the smallest code point that may use that many */
+    c = *ps++;
+    if (c < 0x80) {
+      extra = 0;
+      lo = 0;
+    } else if ((c >= 0xc2) && (c <= 0xdf)) {
+      extra = 1;
+      lo = 0x80;
+      c &= 0x1f;
+    } else if ((c >= 0xe0) && (c <= 0xef)) {
+      extra = 2;
+      lo = 0x800;
+      c &= 0x0f;
+    } else if ((c >= 0xf0) && (c <= 0xf4)) {
+      extra = 3;
+      lo = 0x10000;
+      c &= 0x07;
+    } else {
+      err = 1;
+      break;
+    }
     
-    /* Perform copy operation */
-    if (pResult != NULL) {
-      strcpy(pResult, pStr);
+    /* Gather the continuation bytes */
+    if ((pe - ps) < extra) {
+      err = 1;
+      break;
+    }
+    for(i = 0; i < extra; i++) {
+      if ((*ps & 0xc0) != 0x80) {
+        err = 1;
+        break;
+      }
+      c = (c << 6) | (*ps++ & 0x3f);
+    }
+    
+    /* Reject overlong forms, surrogates, and values beyond Unicode */
+    if ((!err) && ((c < lo) || (c > 0x10ffff) ||
+          ((c >= 0xd800) && (c <= 0xdfff)))) {
+      err = 1;
+    }
+    if (err) {
+      break;
+    }
+    
+    /* Store a single code unit, or a surrogate pair above the BMP */
+    if (c < 0x10000) {
+      if (cap > 0) {
+        if (count >= cap) {
+          err = 1;
+          break;
+        }
+        pDst[count] = (aks_emu_wchar) c;
+      }
+      count++;
+      
+    } else {
+      if (cap > 0) {
+        if ((cap - count) < 2) {
+          err = 1;
+          break;
+        }
+        c -= 0x10000;
+        pDst[count] = (aks_emu_wchar) (0xd800 + (c >> 10));
+        pDst[count + 1] = (aks_emu_wchar) (0xdc00 + (c & 0x3ff));
+      }
+      count += 2;
     }
   }
   
-  /* Return result */
-  return pResult;
+  if (err) {
+    count = 0;
+  }
+  return count;
 }
 
 /*
- * Convert a generic string to an 8-bit string.
+ * Transcode UTF-16 into UTF-8.
  * 
- * On POSIX, this just makes a dynamic copy of the string.
+ * This follows WideCharToMultiByte() with the CP_UTF8 code page and
+ * the WC_ERR_INVALID_CHARS flag.  If srclen is -1, the source is nul
+ * terminated and the terminating nul is transcoded too.  Unpaired
+ * surrogates are errors.  If cap is zero, nothing is written and the
+ * number of bytes the transcoding requires is returned.
  * 
  * Parameters:
  * 
- *   pStr - the generic string
+ *   pSrc - the UTF-16 source
+ * 
+ *   srclen - the number of code units in the source, or -1
+ * 
+ *   pDst - the buffer to receive the UTF-8, or NULL if cap is zero
+ * 
+ *   cap - the number of bytes the buffer can hold
  * 
  * Return:
  * 
- *   the dynamically allocated 8-bit string copy, or NULL if error
+ *   the number of bytes written or required, or zero if the source is
+ *   invalid or the buffer is too small
  */
-static char *aks_fromapi(const aks_tchar *pStr) {
+AKS_INTERNAL int aks_emu_utf16to8(
+    const aks_emu_wchar * pSrc,
+          int             srclen,
+          char          * pDst,
+          int             cap) {
   
-  char *pResult = NULL;
+  unsigned char *pb = NULL;
+  unsigned long c = 0;
+  int count = 0;
+  int err = 0;
+  int n = 0;
+  int i = 0;
   
-  /* Only proceed if non-NULL value passed */
-  if (pStr != NULL) {
+  /* Check parameters, measuring a nul-terminated source */
+  if ((pSrc == NULL) || (cap < 0) || ((cap > 0) && (pDst == NULL))) {
+    err = 1;
+  }
+  if ((!err) && (srclen == -1)) {
+    for(srclen = 0; pSrc[srclen] != 0; srclen++) {
+      if (srclen >= INT_MAX - 1) {
+        err = 1;
+        break;
+      }
+    }
+    srclen++;
+  }
+  if ((!err) && (srclen < 1)) {
+    err = 1;
+  }
+  
+  while ((!err) && (i < srclen)) {
     
-    /* Allocate copy */
-    pResult = (char *) malloc(strlen(pStr) + 1);
+    /* Decode a code point, combining surrogate pairs */
+    c = pSrc[i++];
+    if ((c >= 0xd800) && (c <= 0xdbff)) {
+      if ((i < srclen) && (pSrc[i] >= 0xdc00) && (pSrc[i] <= 0xdfff)) {
+        c = 0x10000 + ((c - 0xd800) << 10) + (pSrc[i++] - 0xdc00);
+      } else {
+        err = 1;
+        break;
+      }
+    } else if ((c >= 0xdc00) && (c <= 0xdfff)) {
+      err = 1;
+      break;
+    }
     
-    /* Perform copy operation */
-    if (pResult != NULL) {
-      strcpy(pResult, pStr);
+    /* Determine the length of the encoding */
+    if (c < 0x80) {
+      n = 1;
+    } else if (c < 0x800) {
+      n = 2;
+    } else if (c < 0x10000) {
+      n = 3;
+    } else {
+      n = 4;
+    }
+    if (count > INT_MAX - n) {
+      err = 1;
+      break;
+    }
+    
+    /* Store the encoding */
+    if (cap > 0) {
+      if ((cap - count) < n) {
+        err = 1;
+        break;
+      }
+      pb = ((unsigned char *) pDst) + count;
+      if (n == 1) {
+        pb[0] = (unsigned char) c;
+      } else if (n == 2) {
+        pb[0] = (unsigned char) (0xc0 | (c >> 6));
+        pb[1] = (unsigned char) (0x80 | (c & 0x3f));
+      } else if (n == 3) {
+        pb[0] = (unsigned char) (0xe0 | (c >> 12));
+        pb[1] = (unsigned char) (0x80 | ((c >> 6) & 0x3f));
+        pb[2] = (unsigned char) (0x80 | (c & 0x3f));
+      } else {
+        pb[0] = (unsigned char) (0xf0 | (c >> 18));
+        pb[1] = (unsigned char) (0x80 | ((c >> 12) & 0x3f));
+        pb[2] = (unsigned char) (0x80 | ((c >> 6) & 0x3f));
+        pb[3] = (unsigned char) (0x80 | (c & 0x3f));
+      }
     }
+    count += n;
   }
   
-  /* Return result */
-  return pResult;
+  if (err) {
+    count = 0;
+  }
+  return count;
 }
 
 /*
- * On POSIX, the translation functions are macros that just call
- * through.
+ * Make a dynamically allocated UTF-8 copy of an emulated wide string.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the UTF-16 string
+ * 
+ * Return:
+ * 
+ *   the UTF-8 copy, or NULL if error, in which case errno is set
  */
-#define removet(f) remove(f)
-#define renamet(t, v) rename(t, v)
-#define tmpnamt(s) tmpnam(s)
-#define fopent(f, m) fopen(f, m)
-#define freopent(f, m, s) freopen(f, m, s)
+AKS_INTERNAL char *aks_emu_narrow(const aks_emu_wchar *pStr) {
+  
+  char *pResult = NULL;
+  int sz = 0;
+  
+  sz = aks_emu_utf16to8(pStr, -1, NULL, 0);
+  if (sz > 0) {
+    pResult = (char *) malloc((size_t) sz);
+  } else {
+    aks_seterr(EINVAL);
+  }
+  
+  if (pResult != NULL) {
+    aks_emu_utf16to8(pStr, -1, pResult, sz);
+  }
+  
+  return pResult;
+}
 
-#define getenvt(n) getenv(n)
-#define systemt(s) system(s)
+/*
+ * Make a dynamically allocated UTF-16 copy of a UTF-8 string.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the UTF-8 string
+ * 
+ * Return:
+ * 
+ *   the UTF-16 copy, or NULL if error, in which case errno is set
+ */
+AKS_INTERNAL aks_emu_wchar *aks_emu_widen(const char *pStr) {
+  
+  aks_emu_wchar *pResult = NULL;
+  int sz = 0;
+  
+  sz = aks_emu_utf8to16(pStr, -1, NULL, 0);
+  if (sz > 0) {
+    pResult = (aks_emu_wchar *) malloc(
+                ((size_t) sz) * sizeof(aks_emu_wchar));
+  } else {
+    aks_seterr(EINVAL);
+  }
+  
+  if (pResult != NULL) {
+    aks_emu_utf8to16(pStr, -1, pResult, sz);
+  }
+  
+  return pResult;
+}
 
-#else
-#ifdef UNICODE
+/*
+ * The emulated wide-character CRT functions convert their arguments
+ * back to UTF-8 and call through to the 8-bit functions.  Returned
+ * strings are kept in static buffers, as the Windows CRT does.
+ */
+AKS_INTERNAL int aks_emu_wremove(const aks_emu_wchar *f) {
+  char *pf = NULL;
+  int result = -1;
+  
+  pf = aks_emu_narrow(f);
+  if (pf != NULL) {
+    result = remove(pf);
+    free(pf);
+  }
+  
+  return result;
+}
+
+AKS_INTERNAL int aks_emu_wrename(
+    const aks_emu_wchar * t,
+    const aks_emu_wchar * v) {
+  
+  char *pt = NULL;
+  char *pv = NULL;
+  int result = -1;
+  
+  pt = aks_emu_narrow(t);
+  if (pt != NULL) {
+    pv = aks_emu_narrow(v);
+  }
+  
+  if (pv != NULL) {
+    result = rename(pt, pv);
+  }
+  
+  free(pt);
+  free(pv);
+  return result;
+}
+
+AKS_INTERNAL aks_emu_wchar *aks_emu_wtmpnam(aks_emu_wchar *s) {
+  static aks_emu_wchar sb[L_tmpnam];
+  char nb[L_tmpnam];
+  aks_emu_wchar *result = NULL;
+  
+  /* Generate the name, then widen it into the given buffer or the
+   * static one, both of which hold L_tmpnam code units */
+  if (tmpnam(nb) != NULL) {
+    result = (s != NULL) ? s : sb;
+    if (aks_emu_utf8to16(nb, -1, result, L_tmpnam) < 1) {
+      result = NULL;
+    }
+  }
+  
+  return result;
+}
+
+AKS_INTERNAL FILE *aks_emu_wfopen(
+    const aks_emu_wchar * f,
+    const aks_emu_wchar * m) {
+  
+  char *pf = NULL;
+  char *pm = NULL;
+  FILE *result = NULL;
+  
+  pf = aks_emu_narrow(f);
+  if (pf != NULL) {
+    pm = aks_emu_narrow(m);
+  }
+  
+  if (pm != NULL) {
+    result = fopen(pf, pm);
+  }
+  
+  free(pf);
+  free(pm);
+  return result;
+}
+
+AKS_INTERNAL FILE *aks_emu_wfreopen(
+    const aks_emu_wchar * f,
+    const aks_emu_wchar * m,
+          FILE          * s) {
+  
+  char *pf = NULL;
+  char *pm = NULL;
+  FILE *result = NULL;
+  
+  pf = aks_emu_narrow(f);
+  if (pf != NULL) {
+    pm = aks_emu_narrow(m);
+  }
+  
+  /* The given stream is closed even if the call cannot be made */
+  if (pm != NULL) {
+    result = freopen(pf, pm, s);
+  } else {
+    fclose(s);
+  }
+  
+  free(pf);
+  free(pm);
+  return result;
+}
+
+AKS_INTERNAL aks_emu_wchar *aks_emu_wgetenv(const aks_emu_wchar *n) {
+  static aks_emu_wchar *pb = NULL;
+  const char *pv = NULL;
+  char *pn = NULL;
+  
+  /* Release the previous result */
+  if (pb != NULL) {
+    free(pb);
+    pb = NULL;
+  }
+  
+  pn = aks_emu_narrow(n);
+  if (pn != NULL) {
+    pv = getenv(pn);
+    free(pn);
+  }
+  
+  if (pv != NULL) {
+    pb = aks_emu_widen(pv);
+  }
+  
+  return pb;
+}
+
+AKS_INTERNAL int aks_emu_wsystem(const aks_emu_wchar *s) {
+  char *ps = NULL;
+  int result = -1;
+  
+  /* NULL asks whether a command processor is available */
+  if (s == NULL) {
+    result = system(NULL);
+    
+  } else {
+    ps = aks_emu_narrow(s);
+    if (ps != NULL) {
+      result = system(ps);
+      free(ps);
+    }
+  }
+  
+  return result;
+}
+
+#endif
+
+/*
+ * Route the Windows calls made by the translation layer to the
+ * emulation.  The code page and flags are not passed on, since the
+ * translation layer always asks for strict UTF-8.
+ */
+#define MultiByteToWideChar(cp, fl, s, n, d, sz) \
+  aks_emu_utf8to16(s, n, d, sz)
+#define WideCharToMultiByte(cp, fl, s, n, d, sz, dc, ud) \
+  aks_emu_utf16to8(s, n, d, sz)
+
+#define _wremove(f) aks_emu_wremove(f)
+#define _wrename(t, v) aks_emu_wrename(t, v)
+#define _wtmpnam(s) aks_emu_wtmpnam(s)
+#define _wfopen(f, m) aks_emu_wfopen(f, m)
+#define _wfreopen(f, m, s) aks_emu_wfreopen(f, m, s)
+
+#define _wgetenv(n) aks_emu_wgetenv(n)
+#define _wsystem(s) aks_emu_wsystem(s)
+
+#endif
+#endif
+#endif
+#endif
+
+/* * * * * * * * * * *
+ *                   *
+ * Translation layer *
+ *                   *
+ * * * * * * * * * * */
+
+/* If AKS_TRANSLATE selected and AKS_TRANSLATE_INCLUDED hasn't been
+ * defined yet, define AKS_TRANSLATE_INCLUDED and then define the
+ * translation layer functions appropriate for the platform */
+#ifdef AKS_TRANSLATE
+#ifndef AKS_TRANSLATE_INCLUDED
+#define AKS_TRANSLATE_INCLUDED
+
+#ifdef AKS_POSIX
+#ifndef AKS_WIN_WAPI
+/* POSIX implementation of translation layer ======================== */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Define the generic character type.
+ */
+typedef char aks_tchar;
+
+#ifdef AKS_BODIES
+
+/*
+ * Convert an 8-bit string to a generic string.
+ * 
+ * On POSIX, this just makes a dynamic copy of the string.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the 8-bit string
+ * 
+ * Return:
+ * 
+ *   the dynamically allocated generic string copy, or NULL if error
+ */
+AKS_API aks_tchar *aks_toapi(const char *pStr) {
+  
+  aks_tchar *pResult = NULL;
+  
+  /* Only proceed if non-NULL value passed */
+  if (pStr != NULL) {
+    
+    /* Allocate copy */
+    pResult = (aks_tchar *) malloc(strlen(pStr) + 1);
+    
+    /* Perform copy operation */
+    if (pResult != NULL) {
+      strcpy(pResult, pStr);
+    }
+  }
+  
+  /* Return result */
+  return pResult;
+}
+
+/*
+ * Convert a generic string to an 8-bit string.
+ * 
+ * On POSIX, this just makes a dynamic copy of the string.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the generic string
+ * 
+ * Return:
+ * 
+ *   the dynamically allocated 8-bit string copy, or NULL if error
+ */
+AKS_API char *aks_fromapi(const aks_tchar *pStr) {
+  
+  char *pResult = NULL;
+  
+  /* Only proceed if non-NULL value passed */
+  if (pStr != NULL) {
+    
+    /* Allocate copy */
+    pResult = (char *) malloc(strlen(pStr) + 1);
+    
+    /* Perform copy operation */
+    if (pResult != NULL) {
+      strcpy(pResult, pStr);
+    }
+  }
+  
+  /* Return result */
+  return pResult;
+}
+
+#endif
+
+/*
+ * On POSIX, the translation functions are macros that just call
+ * through.
+ */
+#define removet(f) remove(f)
+#define renamet(t, v) rename(t, v)
+#define tmpnamt(s) tmpnam(s)
+#define fopent(f, m) fopen(f, m)
+#define freopent(f, m, s) freopen(f, m, s)
+
+#define getenvt(n) getenv(n)
+#define systemt(s) system(s)
+
+#endif
+#endif
+
+#ifdef AKS_WIN_WAPI
 /* Windows Unicode implementation of translation layer ============== */
 
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#ifdef AKS_WIN
 #include <windows.h>
+#endif
 
 /*
  * Define the generic character type.
+ * 
+ * When the Unicode mode is emulated on POSIX, this is the 16-bit
+ * emulated wide character rather than the 32-bit wchar_t.
  */
+#ifdef AKS_WIN
 typedef wchar_t aks_tchar;
+#else
+typedef aks_emu_wchar aks_tchar;
+#endif
+
+#ifdef AKS_BODIES
 
 /*
  * Convert an 8-bit string to a generic string.
@@ -330,7 +1155,7 @@ typedef wchar_t aks_tchar;
  *   the dynamically allocated generic UTF-16 string copy, or NULL if
  *   error
  */
-static aks_tchar *aks_toapi(const char *pStr) {
+AKS_API aks_tchar *aks_toapi(const char *pStr) {
   
   aks_tchar *pResult = NULL;
   int sz = 0;
@@ -387,7 +1212,7 @@ static aks_tchar *aks_toapi(const char *pStr) {
  * 
  *   the dynamically allocated UTF-8 string copy, or NULL if error
  */
-static char *aks_fromapi(const aks_tchar *pStr) {
+AKS_API char *aks_fromapi(const aks_tchar *pStr) {
   
   char *pResult = NULL;
   int sz = 0;
@@ -438,7 +1263,7 @@ static char *aks_fromapi(const aks_tchar *pStr) {
  * parameter conversions, calling the wide-character versions, and
  * simulating errors if there is a translation problem.
  */
-static int removet(const char *f) {
+AKS_API int removet(const char *f) {
   aks_tchar *tf = NULL;
   int result = 0;
   
@@ -455,7 +1280,7 @@ static int removet(const char *f) {
   return result;
 }
 
-static int renamet(const char *t, const char *v) {
+AKS_API int renamet(const char *t, const char *v) {
   aks_tchar *tt = NULL;
   aks_tchar *tv = NULL;
   int result = 0;
@@ -482,7 +1307,7 @@ static int renamet(const char *t, const char *v) {
   return result;
 }
 
-static char *tmpnamt(char *s) {
+AKS_API char *tmpnamt(char *s) {
   /* This function is different because the pointer is a buffer that
    * will be filled in rather than a string argument */
   
@@ -496,7 +1321,7 @@ static char *tmpnamt(char *s) {
   if (s != NULL) {
     /* Result buffer passed, begin by setting an empty string result in
      * case of error */
-    c[0] = (char) 0;
+    s[0] = (char) 0;
     
     /* First we want to dynamically allocate a wide buffer to get the
      * result from the API call */
@@ -561,7 +1386,7 @@ static char *tmpnamt(char *s) {
   return retval;
 }
 
-static FILE *fopent(const char *f, const char *m) {
+AKS_API FILE *fopent(const char *f, const char *m) {
   aks_tchar *tf = NULL;
   aks_tchar *tm = NULL;
   FILE *result = NULL;
@@ -588,7 +1413,7 @@ static FILE *fopent(const char *f, const char *m) {
   return result;
 }
 
-static FILE *freopent(const char *f, const char *m, FILE *s) {
+AKS_API FILE *freopent(const char *f, const char *m, FILE *s) {
   aks_tchar *tf = NULL;
   aks_tchar *tm = NULL;
   FILE *result = NULL;
@@ -618,7 +1443,7 @@ static FILE *freopent(const char *f, const char *m, FILE *s) {
   return result;
 }
 
-static char *getenvt(const char *n) {
+AKS_API char *getenvt(const char *n) {
   /* This function is a bit different because it must simulate a static
    * buffer */
   
@@ -649,7 +1474,7 @@ static char *getenvt(const char *n) {
   return pb;
 }
 
-static int systemt(const char *s) {
+AKS_API int systemt(const char *s) {
   aks_tchar *ts = NULL;
   int result = 0;
   
@@ -666,7 +1491,21 @@ static int systemt(const char *s) {
   return result;
 }
 
-#else
+#endif
+
+/* Public function declarations */
+AKS_API int removet(const char *f);
+AKS_API int renamet(const char *t, const char *v);
+AKS_API char *tmpnamt(char *s);
+AKS_API FILE *fopent(const char *f, const char *m);
+AKS_API FILE *freopent(const char *f, const char *m, FILE *s);
+AKS_API char *getenvt(const char *n);
+AKS_API int systemt(const char *s);
+
+#endif
+
+#ifdef AKS_WIN
+#ifndef AKS_WIN_WAPI
 /* Windows ANSI implementation of translation layer ================= */
 
 #include <stddef.h>
@@ -679,6 +1518,8 @@ static int systemt(const char *s) {
  */
 typedef char aks_tchar;
 
+#ifdef AKS_BODIES
+
 /*
  * Convert an 8-bit string to a generic string.
  * 
@@ -693,7 +1534,7 @@ typedef char aks_tchar;
  * 
  *   the dynamically allocated generic string copy, or NULL if error
  */
-static aks_tchar *aks_toapi(const char *pStr) {
+AKS_API aks_tchar *aks_toapi(const char *pStr) {
   
   aks_tchar *pResult = NULL;
   
@@ -727,7 +1568,7 @@ static aks_tchar *aks_toapi(const char *pStr) {
  * 
  *   the dynamically allocated 8-bit string copy, or NULL if error
  */
-static char *aks_fromapi(const aks_tchar *pStr) {
+AKS_API char *aks_fromapi(const aks_tchar *pStr) {
   
   char *pResult = NULL;
   
@@ -747,6 +1588,8 @@ static char *aks_fromapi(const aks_tchar *pStr) {
   return pResult;
 }
 
+#endif
+
 /*
  * On Windows in ANSI mode, the translation functions are macros that
  * just call through.
@@ -763,6 +1606,10 @@ static char *aks_fromapi(const aks_tchar *pStr) {
 #endif
 #endif
 
+/* Public function declarations */
+AKS_API aks_tchar *aks_toapi(const char *pStr);
+AKS_API char *aks_fromapi(const aks_tchar *pStr);
+
 #endif
 #endif
 
@@ -781,6 +1628,7 @@ static char *aks_fromapi(const aks_tchar *pStr) {
 #define AKS_TRANSLATE_MAIN_INCLUDED
 
 #ifdef AKS_POSIX
+#ifndef AKS_WIN_WAPI
 /* POSIX implementation of main translation ========================= */
 
 /* In POSIX, just prototype the translated main and call it from the
@@ -790,8 +1638,10 @@ int main(int argc, char *argv[]) {
   return maint(argc, argv);
 }
 
-#else
-#ifdef UNICODE
+#endif
+#endif
+
+#ifdef AKS_WIN_WAPI
 /* Windows Unicode implementation of translation layer ============== */
 
 /* In Windows in Unicode mode, first prototype the translated main */
@@ -799,7 +1649,7 @@ static int maint(int argc, char *argv[]);
 
 /* Now define an actual main using the wide-character version and have
  * it translate parameters and call through to the maint */
-int wmain(int argc, wchar_t *argv[]) {
+int wmain(int argc, aks_tchar *argv[]) {
   
   char **ppa = NULL;
   int last_i = 0;
@@ -865,28 +1715,81 @@ int wmain(int argc, wchar_t *argv[]) {
   return retval;
 }
 
-#else
-/* Windows ANSI implementation of translation layer ================= */
-
-/* In Windows in ANSI mode, just prototype the translated main and call
- * it from the actual main */
-static int maint(int argc, char *argv[]);
+#ifdef AKS_POSIX
+/* When the Unicode mode is emulated on POSIX, define an actual main
+ * that translates its arguments from UTF-8 to UTF-16, as the Windows
+ * CRT would, and then calls through to the wmain */
 int main(int argc, char *argv[]) {
-  return maint(argc, argv);
-}
-
-#endif
-#endif
-
-#endif
-#endif
-
-/* * * * * * * * *
- *               *
- * File64 check  *
- *               *
- * * * * * * * * */
-
+  
+  aks_tchar **ppw = NULL;
+  int i = 0;
+  int retval = EXIT_FAILURE;
+  
+  /* Allocate a NULL-terminated array for the translation and translate
+   * each argument */
+  if ((argv != NULL) && (argc >= 0)) {
+    ppw = (aks_tchar **) calloc((size_t) argc + 1, sizeof(aks_tchar *));
+    if (ppw == NULL) {
+      fprintf(stderr, "Out of memory!\n");
+    }
+    
+    if (ppw != NULL) {
+      for(i = 0; i < argc; i++) {
+        ppw[i] = aks_toapi(argv[i]);
+        if (ppw[i] == NULL) {
+          fprintf(stderr, "Translation in main failed!\n");
+          break;
+        }
+      }
+    }
+  }
+  
+  /* Call through with translated arguments, or leave the result as
+   * failure if we encountered an error before this */
+  if (argv == NULL) {
+    retval = wmain(argc, NULL);
+  } else if ((ppw != NULL) && (i >= argc)) {
+    retval = wmain(argc, ppw);
+  }
+  
+  /* Release the translated arguments */
+  if (ppw != NULL) {
+    for(i = 0; i < argc; i++) {
+      free(ppw[i]);
+    }
+    free(ppw);
+  }
+  
+  /* Return the return value */
+  return retval;
+}
+#endif
+
+#endif
+
+#ifdef AKS_WIN
+#ifndef AKS_WIN_WAPI
+/* Windows ANSI implementation of translation layer ================= */
+
+/* In Windows in ANSI mode, just prototype the translated main and call
+ * it from the actual main */
+static int maint(int argc, char *argv[]);
+int main(int argc, char *argv[]) {
+  return maint(argc, argv);
+}
+
+#endif
+#endif
+
+#endif
+#endif
+
+/* * * * * * * * *
+ *               *
+ * File64 check  *
+ *               *
+ * * * * * * * * */
+
 /* If we are on POSIX and 64-bit file support was requested, check that
  * the appropriate compilation macro was provided */
 #ifdef AKS_POSIX
@@ -976,3 +1879,11851 @@ typedef off_t aks_off64;
 
 #endif
 #endif
+
+/* * * * * * * * * *
+ *                 *
+ * SIMD detection  *
+ *                 *
+ * * * * * * * * * */
+
+/* Unless AKS_NO_SIMD is defined, define AKS_SIMD_SSE2 if the compiler
+ * is targeting x86 with SSE2 available, and define AKS_SIMD_NEON if the
+ * compiler is targeting 64-bit ARM with NEON available */
+#ifndef AKS_NO_SIMD
+
+#ifdef __SSE2__
+#ifndef AKS_SIMD_SSE2
+#define AKS_SIMD_SSE2
+#endif
+#endif
+
+#ifdef _M_X64
+#ifndef AKS_SIMD_SSE2
+#define AKS_SIMD_SSE2
+#endif
+#endif
+
+#ifdef _M_IX86_FP
+#if (_M_IX86_FP >= 2)
+#ifndef AKS_SIMD_SSE2
+#define AKS_SIMD_SSE2
+#endif
+#endif
+#endif
+
+#ifdef __aarch64__
+#ifdef __ARM_NEON
+#ifndef AKS_SIMD_NEON
+#define AKS_SIMD_NEON
+#endif
+#endif
+#endif
+
+#ifdef _M_ARM64
+#ifndef AKS_SIMD_NEON
+#define AKS_SIMD_NEON
+#endif
+#endif
+
+#endif
+
+/* * * * * * * * * * * * * *
+ *                         *
+ * US-ASCII classification *
+ *                         *
+ * * * * * * * * * * * * * */
+
+/* Only proceed if ASCII functions requested and not already defined */
+#ifdef AKS_ASCII
+#ifndef AKS_ASCII_INCLUDED
+#define AKS_ASCII_INCLUDED
+
+/* Include appropriate headers */
+#include <stddef.h>
+
+#ifdef AKS_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+
+#ifdef AKS_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+/*
+ * Character class bits.
+ * 
+ * AKS_ASCII_UPPER must be 0x20 and AKS_ASCII_LOWER must be 0x40 because
+ * the case conversion macros use the class bits directly as the case
+ * difference between US-ASCII letters.
+ */
+#define AKS_ASCII_CNTRL  0x01
+#define AKS_ASCII_SPACE  0x02
+#define AKS_ASCII_DIGIT  0x04
+#define AKS_ASCII_XDIGIT 0x08
+#define AKS_ASCII_PUNCT  0x10
+#define AKS_ASCII_UPPER  0x20
+#define AKS_ASCII_LOWER  0x40
+#define AKS_ASCII_PRINT  0x80
+
+#define AKS_ASCII_ALPHA (AKS_ASCII_UPPER | AKS_ASCII_LOWER)
+#define AKS_ASCII_ALNUM (AKS_ASCII_ALPHA | AKS_ASCII_DIGIT)
+#define AKS_ASCII_GRAPH (AKS_ASCII_ALNUM | AKS_ASCII_PUNCT)
+
+/*
+ * Class table, indexed by unsigned byte value.
+ * 
+ * Bytes in range 0x80-0xFF are not US-ASCII and have no class bits set.
+ * The classification macros read the table directly, so it has the
+ * same linkage as the public functions.
+ */
+#ifdef AKS_BODIES
+AKS_API_DATA const unsigned char aks_ascii_ctab[256] = {
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,  /* 00-07 */
+  0x01, 0x03, 0x03, 0x03, 0x03, 0x03, 0x01, 0x01,  /* 08-0F */
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,  /* 10-17 */
+  0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,  /* 18-1F */
+  0x82, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,  /* 20-27 */
+  0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,  /* 28-2F */
+  0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c, 0x8c,  /* 30-37 */
+  0x8c, 0x8c, 0x90, 0x90, 0x90, 0x90, 0x90, 0x90,  /* 38-3F */
+  0x90, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa8, 0xa0,  /* 40-47 */
+  0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0,  /* 48-4F */
+  0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0, 0xa0,  /* 50-57 */
+  0xa0, 0xa0, 0xa0, 0x90, 0x90, 0x90, 0x90, 0x90,  /* 58-5F */
+  0x90, 0xc8, 0xc8, 0xc8, 0xc8, 0xc8, 0xc8, 0xc0,  /* 60-67 */
+  0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,  /* 68-6F */
+  0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0, 0xc0,  /* 70-77 */
+  0xc0, 0xc0, 0xc0, 0x90, 0x90, 0x90, 0x90, 0x01   /* 78-7F */
+};
+#else
+extern const unsigned char aks_ascii_ctab[256];
+#endif
+
+/*
+ * Classification macros.
+ * 
+ * Each of these returns non-zero if the character is in the class, zero
+ * otherwise.  The argument may be any char, unsigned char, or int value
+ * including EOF.  Only the low eight bits of the argument are examined.
+ */
+#define aks_isclass(c, cls) \
+  (aks_ascii_ctab[(unsigned char) (c)] & (cls))
+
+#define aks_iscntrl(c)  aks_isclass(c, AKS_ASCII_CNTRL)
+#define aks_isspace(c)  aks_isclass(c, AKS_ASCII_SPACE)
+#define aks_isdigit(c)  aks_isclass(c, AKS_ASCII_DIGIT)
+#define aks_isxdigit(c) aks_isclass(c, AKS_ASCII_XDIGIT)
+#define aks_ispunct(c)  aks_isclass(c, AKS_ASCII_PUNCT)
+#define aks_isupper(c)  aks_isclass(c, AKS_ASCII_UPPER)
+#define aks_islower(c)  aks_isclass(c, AKS_ASCII_LOWER)
+#define aks_isprint(c)  aks_isclass(c, AKS_ASCII_PRINT)
+#define aks_isalpha(c)  aks_isclass(c, AKS_ASCII_ALPHA)
+#define aks_isalnum(c)  aks_isclass(c, AKS_ASCII_ALNUM)
+#define aks_isgraph(c)  aks_isclass(c, AKS_ASCII_GRAPH)
+
+/*
+ * Case conversion macros.
+ * 
+ * These return the argument unchanged unless it is a US-ASCII letter of
+ * the other case.  The class bit of the letter is the case difference,
+ * so there is no branch.
+ */
+#define aks_tolower(c) \
+  ((int) (c) | (aks_ascii_ctab[(unsigned char) (c)] & AKS_ASCII_UPPER))
+
+#define aks_toupper(c) \
+  ((int) (c) ^ ((aks_ascii_ctab[(unsigned char) (c)] & AKS_ASCII_LOWER) \
+                  >> 1))
+
+#ifdef AKS_BODIES
+
+/*
+ * Table of the byte ranges that make up each class, used by the SIMD
+ * implementations of the bulk functions.  Each record is a class bit
+ * followed by the first and last byte value of a range.
+ */
+#define AKS_ASCII_RANGE_COUNT 15
+static const unsigned char aks_ascii_rtab[AKS_ASCII_RANGE_COUNT * 3] = {
+  AKS_ASCII_CNTRL,  0x00, 0x1f,
+  AKS_ASCII_CNTRL,  0x7f, 0x7f,
+  AKS_ASCII_SPACE,  0x09, 0x0d,
+  AKS_ASCII_SPACE,  0x20, 0x20,
+  AKS_ASCII_DIGIT,  0x30, 0x39,
+  AKS_ASCII_XDIGIT, 0x30, 0x39,
+  AKS_ASCII_XDIGIT, 0x41, 0x46,
+  AKS_ASCII_XDIGIT, 0x61, 0x66,
+  AKS_ASCII_PUNCT,  0x21, 0x2f,
+  AKS_ASCII_PUNCT,  0x3a, 0x40,
+  AKS_ASCII_PUNCT,  0x5b, 0x60,
+  AKS_ASCII_PUNCT,  0x7b, 0x7e,
+  AKS_ASCII_UPPER,  0x41, 0x5a,
+  AKS_ASCII_LOWER,  0x61, 0x7a,
+  AKS_ASCII_PRINT,  0x20, 0x7e
+};
+
+/*
+ * Convert all US-ASCII uppercase letters in a buffer to lowercase.
+ * 
+ * All other bytes, including bytes in range 0x80-0xFF, are unchanged.
+ * The buffer does not need to be nul-terminated.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to convert in place
+ * 
+ *   len - the number of bytes in the buffer
+ */
+AKS_API void aks_ascii_lower(char *pBuf, size_t len) {
+  
+  size_t i = 0;
+#ifdef AKS_SIMD_SSE2
+  __m128i v;
+  __m128i m;
+  
+  /* Convert 16 bytes at a time; (v - 'A') <= 25 unsigned selects the
+   * uppercase letters */
+  for( ; i + 16 <= len; i += 16) {
+    v = _mm_loadu_si128((const __m128i *) (pBuf + i));
+    m = _mm_subs_epu8(
+          _mm_sub_epi8(v, _mm_set1_epi8(0x41)),
+          _mm_set1_epi8(0x19));
+    m = _mm_cmpeq_epi8(m, _mm_setzero_si128());
+    v = _mm_or_si128(v, _mm_and_si128(m, _mm_set1_epi8(0x20)));
+    _mm_storeu_si128((__m128i *) (pBuf + i), v);
+  }
+#endif
+#ifdef AKS_SIMD_NEON
+  uint8x16_t v;
+  uint8x16_t m;
+  
+  /* Convert 16 bytes at a time */
+  for( ; i + 16 <= len; i += 16) {
+    v = vld1q_u8((const uint8_t *) (pBuf + i));
+    m = vcleq_u8(vsubq_u8(v, vdupq_n_u8(0x41)), vdupq_n_u8(0x19));
+    v = vorrq_u8(v, vandq_u8(m, vdupq_n_u8(0x20)));
+    vst1q_u8((uint8_t *) (pBuf + i), v);
+  }
+#endif
+  
+  /* Convert any remaining bytes with the table */
+  for( ; i < len; i++) {
+    pBuf[i] = (char) aks_tolower(pBuf[i]);
+  }
+}
+
+/*
+ * Convert all US-ASCII lowercase letters in a buffer to uppercase.
+ * 
+ * All other bytes, including bytes in range 0x80-0xFF, are unchanged.
+ * The buffer does not need to be nul-terminated.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to convert in place
+ * 
+ *   len - the number of bytes in the buffer
+ */
+AKS_API void aks_ascii_upper(char *pBuf, size_t len) {
+  
+  size_t i = 0;
+#ifdef AKS_SIMD_SSE2
+  __m128i v;
+  __m128i m;
+  
+  /* Convert 16 bytes at a time; (v - 'a') <= 25 unsigned selects the
+   * lowercase letters */
+  for( ; i + 16 <= len; i += 16) {
+    v = _mm_loadu_si128((const __m128i *) (pBuf + i));
+    m = _mm_subs_epu8(
+          _mm_sub_epi8(v, _mm_set1_epi8(0x61)),
+          _mm_set1_epi8(0x19));
+    m = _mm_cmpeq_epi8(m, _mm_setzero_si128());
+    v = _mm_xor_si128(v, _mm_and_si128(m, _mm_set1_epi8(0x20)));
+    _mm_storeu_si128((__m128i *) (pBuf + i), v);
+  }
+#endif
+#ifdef AKS_SIMD_NEON
+  uint8x16_t v;
+  uint8x16_t m;
+  
+  /* Convert 16 bytes at a time */
+  for( ; i + 16 <= len; i += 16) {
+    v = vld1q_u8((const uint8_t *) (pBuf + i));
+    m = vcleq_u8(vsubq_u8(v, vdupq_n_u8(0x61)), vdupq_n_u8(0x19));
+    v = veorq_u8(v, vandq_u8(m, vdupq_n_u8(0x20)));
+    vst1q_u8((uint8_t *) (pBuf + i), v);
+  }
+#endif
+  
+  /* Convert any remaining bytes with the table */
+  for( ; i < len; i++) {
+    pBuf[i] = (char) aks_toupper(pBuf[i]);
+  }
+}
+
+/*
+ * Measure a run of bytes that are either all inside or all outside a
+ * set of character classes.
+ * 
+ * This is the shared implementation of aks_ascii_span() and
+ * aks_ascii_cspan().  If inv is zero, the run is of bytes that have at
+ * least one of the class bits in cls.  If inv is non-zero, the run is
+ * of bytes that have none of the class bits in cls.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to scan
+ * 
+ *   len - the number of bytes in the buffer
+ * 
+ *   cls - the class bits
+ * 
+ *   inv - non-zero to invert the test
+ * 
+ * Return:
+ * 
+ *   the length of the run at the start of the buffer
+ */
+AKS_INTERNAL size_t aks_ascii_run(
+    const char * pBuf,
+    size_t       len,
+    int          cls,
+    int          inv) {
+  
+  size_t i = 0;
+  int j = 0;
+  int rc = 0;
+  unsigned char want = 0;
+#ifdef AKS_SIMD_SSE2
+  __m128i vlo[AKS_ASCII_RANGE_COUNT];
+  __m128i vdf[AKS_ASCII_RANGE_COUNT];
+  __m128i v;
+  __m128i m;
+  int full = 0;
+#endif
+#ifdef AKS_SIMD_NEON
+  uint8x16_t vlo[AKS_ASCII_RANGE_COUNT];
+  uint8x16_t vdf[AKS_ASCII_RANGE_COUNT];
+  uint8x16_t v;
+  uint8x16_t m;
+#endif
+  
+  /* Determine the table result that continues the run */
+  want = (unsigned char) (inv ? 0 : 1);
+  
+  /* Gather the ranges that make up the requested classes */
+  for(j = 0; j < AKS_ASCII_RANGE_COUNT; j++) {
+    if (aks_ascii_rtab[j * 3] & cls) {
+#ifdef AKS_SIMD_SSE2
+      vlo[rc] = _mm_set1_epi8((char) aks_ascii_rtab[j * 3 + 1]);
+      vdf[rc] = _mm_set1_epi8((char)
+                  (aks_ascii_rtab[j * 3 + 2] - aks_ascii_rtab[j * 3 + 1]));
+#endif
+#ifdef AKS_SIMD_NEON
+      vlo[rc] = vdupq_n_u8(aks_ascii_rtab[j * 3 + 1]);
+      vdf[rc] = vdupq_n_u8((uint8_t)
+                  (aks_ascii_rtab[j * 3 + 2] - aks_ascii_rtab[j * 3 + 1]));
+#endif
+      rc++;
+    }
+  }
+  
+  /* Skip over whole 16-byte blocks that continue the run; stop at the
+   * first block that does not, and leave it to the table loop */
+#ifdef AKS_SIMD_SSE2
+  full = (inv ? 0 : 0xffff);
+  for( ; i + 16 <= len; i += 16) {
+    v = _mm_loadu_si128((const __m128i *) (pBuf + i));
+    m = _mm_setzero_si128();
+    for(j = 0; j < rc; j++) {
+      m = _mm_or_si128(m, _mm_cmpeq_epi8(
+            _mm_subs_epu8(_mm_sub_epi8(v, vlo[j]), vdf[j]),
+            _mm_setzero_si128()));
+    }
+    if (_mm_movemask_epi8(m) != full) {
+      break;
+    }
+  }
+#endif
+#ifdef AKS_SIMD_NEON
+  for( ; i + 16 <= len; i += 16) {
+    v = vld1q_u8((const uint8_t *) (pBuf + i));
+    m = vdupq_n_u8(0);
+    for(j = 0; j < rc; j++) {
+      m = vorrq_u8(m, vcleq_u8(vsubq_u8(v, vlo[j]), vdf[j]));
+    }
+    if (inv) {
+      if (vmaxvq_u8(m) != 0) {
+        break;
+      }
+    } else {
+      if (vminvq_u8(m) == 0) {
+        break;
+      }
+    }
+  }
+#endif
+  
+  /* Finish with the table */
+  for( ; i < len; i++) {
+    if ((aks_isclass(pBuf[i], cls) ? 1 : 0) != want) {
+      break;
+    }
+  }
+  
+  /* Return the run length */
+  return i;
+}
+
+/*
+ * Determine the length of the run of bytes at the start of a buffer
+ * that are in any of the given character classes.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to scan
+ * 
+ *   len - the number of bytes in the buffer
+ * 
+ *   cls - one or more AKS_ASCII_ class bits combined with OR
+ * 
+ * Return:
+ * 
+ *   the length of the run, which is len if all bytes match
+ */
+AKS_API size_t aks_ascii_span(const char *pBuf, size_t len, int cls) {
+  return aks_ascii_run(pBuf, len, cls, 0);
+}
+
+/*
+ * Determine the length of the run of bytes at the start of a buffer
+ * that are in none of the given character classes.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to scan
+ * 
+ *   len - the number of bytes in the buffer
+ * 
+ *   cls - one or more AKS_ASCII_ class bits combined with OR
+ * 
+ * Return:
+ * 
+ *   the length of the run, which is len if no bytes match
+ */
+AKS_API size_t aks_ascii_cspan(const char *pBuf, size_t len, int cls) {
+  return aks_ascii_run(pBuf, len, cls, 1);
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API void aks_ascii_lower(char *pBuf, size_t len);
+AKS_API void aks_ascii_upper(char *pBuf, size_t len);
+AKS_API size_t aks_ascii_span(const char *pBuf, size_t len, int cls);
+AKS_API size_t aks_ascii_cspan(const char *pBuf, size_t len, int cls);
+
+#endif
+#endif
+
+/* * * * * * * * * * * *
+ *                     *
+ * Integer formatting  *
+ *                     *
+ * * * * * * * * * * * */
+
+/* If AKS_DBLFMT selected, define AKS_INTFMT if not already defined */
+#ifdef AKS_DBLFMT
+#ifndef AKS_INTFMT
+#define AKS_INTFMT
+#endif
+#endif
+
+/* If AKS_SBUF selected, define AKS_INTFMT if not already defined */
+#ifdef AKS_SBUF
+#ifndef AKS_INTFMT
+#define AKS_INTFMT
+#endif
+#endif
+
+/* If AKS_TRACE selected, define AKS_INTFMT if not already defined */
+#ifdef AKS_TRACE
+#ifndef AKS_INTFMT
+#define AKS_INTFMT
+#endif
+#endif
+
+/* Only proceed if integer formatting requested and not already
+ * defined */
+#ifdef AKS_INTFMT
+#ifndef AKS_INTFMT_INCLUDED
+#define AKS_INTFMT_INCLUDED
+
+/* Include appropriate headers */
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The size of a buffer that is large enough to hold any formatted
+ * 64-bit integer, including the sign and the terminating nul.
+ */
+#define AKS_FMT_INT_BUFSIZE 21
+
+#ifdef AKS_BODIES
+
+/*
+ * Table of all two-digit decimal pairs from "00" to "99".
+ */
+static const char aks_fmt_pairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+/*
+ * Format an unsigned 64-bit integer in decimal.
+ * 
+ * The buffer must have room for at least AKS_FMT_INT_BUFSIZE bytes.
+ * The result is nul-terminated.  No locale settings are consulted.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to write the decimal string into
+ * 
+ *   v - the value to format
+ * 
+ * Return:
+ * 
+ *   the number of characters written, not including the nul
+ */
+AKS_API size_t aks_fmt_u64(char *pBuf, uint64_t v) {
+  
+  size_t len = 1;
+  size_t i = 0;
+  uint64_t t = 0;
+  unsigned int d = 0;
+  
+  /* Count the digits so that the string can be written in place from
+   * the end */
+  for(t = v; t >= 10; t /= 10) {
+    len++;
+  }
+  pBuf[len] = (char) 0;
+  
+  /* Write two digits at a time */
+  i = len;
+  while (v >= 100) {
+    d = (unsigned int) (v % 100) * 2;
+    v /= 100;
+    pBuf[--i] = aks_fmt_pairs[d + 1];
+    pBuf[--i] = aks_fmt_pairs[d];
+  }
+  
+  /* Write the remaining one or two digits */
+  if (v >= 10) {
+    d = (unsigned int) v * 2;
+    pBuf[--i] = aks_fmt_pairs[d + 1];
+    pBuf[--i] = aks_fmt_pairs[d];
+  } else {
+    pBuf[--i] = (char) ('0' + (int) v);
+  }
+  
+  /* Return the length */
+  return len;
+}
+
+/*
+ * Format a signed 64-bit integer in decimal.
+ * 
+ * The buffer must have room for at least AKS_FMT_INT_BUFSIZE bytes.
+ * The result is nul-terminated.  Negative values have a leading
+ * hyphen-minus and non-negative values have no sign.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to write the decimal string into
+ * 
+ *   v - the value to format
+ * 
+ * Return:
+ * 
+ *   the number of characters written, not including the nul
+ */
+AKS_API size_t aks_fmt_i64(char *pBuf, int64_t v) {
+  
+  /* Negate in unsigned arithmetic so that the most negative value does
+   * not overflow */
+  if (v < 0) {
+    pBuf[0] = '-';
+    return aks_fmt_u64(pBuf + 1, ((uint64_t) 0) - ((uint64_t) v)) + 1;
+  }
+  
+  return aks_fmt_u64(pBuf, (uint64_t) v);
+}
+
+/*
+ * Parse an unsigned decimal integer into a 64-bit value.
+ * 
+ * The whole input must be a sequence of one or more ASCII decimal
+ * digits.  Signs, whitespace, and digit grouping are not accepted.  The
+ * input does not need to be nul-terminated.  No locale settings are
+ * consulted.
+ * 
+ * On error, *pv is not modified.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the characters to parse
+ * 
+ *   len - the number of characters
+ * 
+ *   pv - receives the parsed value
+ * 
+ * Return:
+ * 
+ *   zero if successful, EINVAL if the input is not a decimal integer,
+ *   or ERANGE if the value does not fit in 64 bits
+ */
+AKS_API int aks_parse_u64(const char *pStr, size_t len, uint64_t *pv) {
+  
+  uint64_t v = 0;
+  unsigned int d = 0;
+  size_t i = 0;
+  
+  /* Input must not be empty */
+  if (len < 1) {
+    return EINVAL;
+  }
+  
+  /* Skip leading zeros so they do not count towards the digit limit */
+  while ((len > 1) && (pStr[0] == '0')) {
+    pStr++;
+    len--;
+  }
+  
+  /* Any 19-digit value fits, so accumulate up to 19 digits without an
+   * overflow check */
+  for(i = 0; (i < len) && (i < 19); i++) {
+    d = (unsigned int) ((unsigned char) pStr[i]) - (unsigned int) '0';
+    if (d > 9) {
+      return EINVAL;
+    }
+    v = v * 10 + d;
+  }
+  
+  /* Check a twentieth digit against the limit */
+  if (i < len) {
+    d = (unsigned int) ((unsigned char) pStr[i]) - (unsigned int) '0';
+    if (d > 9) {
+      return EINVAL;
+    }
+    if (v > (UINT64_MAX - d) / 10) {
+      return ERANGE;
+    }
+    v = v * 10 + d;
+    i++;
+  }
+  
+  /* Anything beyond twenty digits is either invalid or out of range */
+  if (i < len) {
+    for( ; i < len; i++) {
+      d = (unsigned int) ((unsigned char) pStr[i]) - (unsigned int) '0';
+      if (d > 9) {
+        return EINVAL;
+      }
+    }
+    return ERANGE;
+  }
+  
+  /* Store the result */
+  *pv = v;
+  return 0;
+}
+
+/*
+ * Parse a signed decimal integer into a 64-bit value.
+ * 
+ * The input is an optional "+" or "-" sign followed by one or more
+ * ASCII decimal digits, with no whitespace.  The input does not need to
+ * be nul-terminated.  No locale settings are consulted.
+ * 
+ * On error, *pv is not modified.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the characters to parse
+ * 
+ *   len - the number of characters
+ * 
+ *   pv - receives the parsed value
+ * 
+ * Return:
+ * 
+ *   zero if successful, EINVAL if the input is not a decimal integer,
+ *   or ERANGE if the value does not fit in a signed 64-bit integer
+ */
+AKS_API int aks_parse_i64(const char *pStr, size_t len, int64_t *pv) {
+  
+  uint64_t m = 0;
+  int neg = 0;
+  int err = 0;
+  
+  /* Handle the sign */
+  if (len > 0) {
+    if (pStr[0] == '-') {
+      neg = 1;
+      pStr++;
+      len--;
+    } else if (pStr[0] == '+') {
+      pStr++;
+      len--;
+    }
+  }
+  
+  /* Parse the magnitude */
+  err = aks_parse_u64(pStr, len, &m);
+  if (err) {
+    return err;
+  }
+  
+  /* Range check the magnitude and store the result; the most negative
+   * value is built without overflowing */
+  if (neg) {
+    if (m > ((uint64_t) INT64_MAX) + 1) {
+      return ERANGE;
+    }
+    if (m == ((uint64_t) INT64_MAX) + 1) {
+      *pv = INT64_MIN;
+    } else {
+      *pv = -((int64_t) m);
+    }
+    
+  } else {
+    if (m > (uint64_t) INT64_MAX) {
+      return ERANGE;
+    }
+    *pv = (int64_t) m;
+  }
+  
+  return 0;
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API size_t aks_fmt_u64(char *pBuf, uint64_t v);
+AKS_API size_t aks_fmt_i64(char *pBuf, int64_t v);
+AKS_API int aks_parse_u64(const char *pStr, size_t len, uint64_t *pv);
+AKS_API int aks_parse_i64(const char *pStr, size_t len, int64_t *pv);
+
+#endif
+#endif
+
+/* * * * * * * * * * * * * * *
+ *                           *
+ * Floating-point formatting *
+ *                           *
+ * * * * * * * * * * * * * * */
+
+/* Only proceed if floating-point formatting requested and not already
+ * defined */
+#ifdef AKS_DBLFMT
+#ifndef AKS_DBLFMT_INCLUDED
+#define AKS_DBLFMT_INCLUDED
+
+/* Include appropriate headers */
+#include <errno.h>
+#include <float.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#ifdef _M_X64
+#include <intrin.h>
+#define AKS_DBL_MSVC64
+#endif
+#endif
+
+/*
+ * The size of a buffer that is large enough to hold any double
+ * formatted by aks_fmt_double(), including the terminating nul.
+ */
+#define AKS_FMT_DBL_BUFSIZE 32
+
+/*
+ * The range of decimal exponents covered by the power table.
+ */
+#define AKS_DBL_POW10_MIN (-342)
+#define AKS_DBL_POW10_MAX 324
+
+#ifdef AKS_BODIES
+
+/*
+ * 128-bit significands of the powers of ten from 10^-342 to 10^324,
+ * normalized so that the most significant bit is set, stored as pairs
+ * of high and low 64-bit words.
+ * 
+ * Non-negative powers are truncated.  Negative powers are the quotient
+ * of a power of two divided by the power of five, plus one, truncated
+ * to 128 bits.  This is the table used by the Eisel-Lemire algorithm
+ * for parsing.  The shortest-output formatter needs the truncated
+ * significand plus one, which it derives from this table.
+ */
+static const uint64_t aks_dbl_pow10[
+    (AKS_DBL_POW10_MAX - AKS_DBL_POW10_MIN + 1) * 2] = {
+  UINT64_C(0xeef453d6923bd65a), UINT64_C(0x113faa2906a13b3f),  /* -342 */
+  UINT64_C(0x9558b4661b6565f8), UINT64_C(0x4ac7ca59a424c507),  /* -341 */
+  UINT64_C(0xbaaee17fa23ebf76), UINT64_C(0x5d79bcf00d2df649),  /* -340 */
+  UINT64_C(0xe95a99df8ace6f53), UINT64_C(0xf4d82c2c107973dc),  /* -339 */
+  UINT64_C(0x91d8a02bb6c10594), UINT64_C(0x79071b9b8a4be869),  /* -338 */
+  UINT64_C(0xb64ec836a47146f9), UINT64_C(0x9748e2826cdee284),  /* -337 */
+  UINT64_C(0xe3e27a444d8d98b7), UINT64_C(0xfd1b1b2308169b25),  /* -336 */
+  UINT64_C(0x8e6d8c6ab0787f72), UINT64_C(0xfe30f0f5e50e20f7),  /* -335 */
+  UINT64_C(0xb208ef855c969f4f), UINT64_C(0xbdbd2d335e51a935),  /* -334 */
+  UINT64_C(0xde8b2b66b3bc4723), UINT64_C(0xad2c788035e61382),  /* -333 */
+  UINT64_C(0x8b16fb203055ac76), UINT64_C(0x4c3bcb5021afcc31),  /* -332 */
+  UINT64_C(0xaddcb9e83c6b1793), UINT64_C(0xdf4abe242a1bbf3d),  /* -331 */
+  UINT64_C(0xd953e8624b85dd78), UINT64_C(0xd71d6dad34a2af0d),  /* -330 */
+  UINT64_C(0x87d4713d6f33aa6b), UINT64_C(0x8672648c40e5ad68),  /* -329 */
+  UINT64_C(0xa9c98d8ccb009506), UINT64_C(0x680efdaf511f18c2),  /* -328 */
+  UINT64_C(0xd43bf0effdc0ba48), UINT64_C(0x0212bd1b2566def2),  /* -327 */
+  UINT64_C(0x84a57695fe98746d), UINT64_C(0x014bb630f7604b57),  /* -326 */
+  UINT64_C(0xa5ced43b7e3e9188), UINT64_C(0x419ea3bd35385e2d),  /* -325 */
+  UINT64_C(0xcf42894a5dce35ea), UINT64_C(0x52064cac828675b9),  /* -324 */
+  UINT64_C(0x818995ce7aa0e1b2), UINT64_C(0x7343efebd1940993),  /* -323 */
+  UINT64_C(0xa1ebfb4219491a1f), UINT64_C(0x1014ebe6c5f90bf8),  /* -322 */
+  UINT64_C(0xca66fa129f9b60a6), UINT64_C(0xd41a26e077774ef6),  /* -321 */
+  UINT64_C(0xfd00b897478238d0), UINT64_C(0x8920b098955522b4),  /* -320 */
+  UINT64_C(0x9e20735e8cb16382), UINT64_C(0x55b46e5f5d5535b0),  /* -319 */
+  UINT64_C(0xc5a890362fddbc62), UINT64_C(0xeb2189f734aa831d),  /* -318 */
+  UINT64_C(0xf712b443bbd52b7b), UINT64_C(0xa5e9ec7501d523e4),  /* -317 */
+  UINT64_C(0x9a6bb0aa55653b2d), UINT64_C(0x47b233c92125366e),  /* -316 */
+  UINT64_C(0xc1069cd4eabe89f8), UINT64_C(0x999ec0bb696e840a),  /* -315 */
+  UINT64_C(0xf148440a256e2c76), UINT64_C(0xc00670ea43ca250d),  /* -314 */
+  UINT64_C(0x96cd2a865764dbca), UINT64_C(0x380406926a5e5728),  /* -313 */
+  UINT64_C(0xbc807527ed3e12bc), UINT64_C(0xc605083704f5ecf2),  /* -312 */
+  UINT64_C(0xeba09271e88d976b), UINT64_C(0xf7864a44c633682e),  /* -311 */
+  UINT64_C(0x93445b8731587ea3), UINT64_C(0x7ab3ee6afbe0211d),  /* -310 */
+  UINT64_C(0xb8157268fdae9e4c), UINT64_C(0x5960ea05bad82964),  /* -309 */
+  UINT64_C(0xe61acf033d1a45df), UINT64_C(0x6fb92487298e33bd),  /* -308 */
+  UINT64_C(0x8fd0c16206306bab), UINT64_C(0xa5d3b6d479f8e056),  /* -307 */
+  UINT64_C(0xb3c4f1ba87bc8696), UINT64_C(0x8f48a4899877186c),  /* -306 */
+  UINT64_C(0xe0b62e2929aba83c), UINT64_C(0x331acdabfe94de87),  /* -305 */
+  UINT64_C(0x8c71dcd9ba0b4925), UINT64_C(0x9ff0c08b7f1d0b14),  /* -304 */
+  UINT64_C(0xaf8e5410288e1b6f), UINT64_C(0x07ecf0ae5ee44dd9),  /* -303 */
+  UINT64_C(0xdb71e91432b1a24a), UINT64_C(0xc9e82cd9f69d6150),  /* -302 */
+  UINT64_C(0x892731ac9faf056e), UINT64_C(0xbe311c083a225cd2),  /* -301 */
+  UINT64_C(0xab70fe17c79ac6ca), UINT64_C(0x6dbd630a48aaf406),  /* -300 */
+  UINT64_C(0xd64d3d9db981787d), UINT64_C(0x092cbbccdad5b108),  /* -299 */
+  UINT64_C(0x85f0468293f0eb4e), UINT64_C(0x25bbf56008c58ea5),  /* -298 */
+  UINT64_C(0xa76c582338ed2621), UINT64_C(0xaf2af2b80af6f24e),  /* -297 */
+  UINT64_C(0xd1476e2c07286faa), UINT64_C(0x1af5af660db4aee1),  /* -296 */
+  UINT64_C(0x82cca4db847945ca), UINT64_C(0x50d98d9fc890ed4d),  /* -295 */
+  UINT64_C(0xa37fce126597973c), UINT64_C(0xe50ff107bab528a0),  /* -294 */
+  UINT64_C(0xcc5fc196fefd7d0c), UINT64_C(0x1e53ed49a96272c8),  /* -293 */
+  UINT64_C(0xff77b1fcbebcdc4f), UINT64_C(0x25e8e89c13bb0f7a),  /* -292 */
+  UINT64_C(0x9faacf3df73609b1), UINT64_C(0x77b191618c54e9ac),  /* -291 */
+  UINT64_C(0xc795830d75038c1d), UINT64_C(0xd59df5b9ef6a2417),  /* -290 */
+  UINT64_C(0xf97ae3d0d2446f25), UINT64_C(0x4b0573286b44ad1d),  /* -289 */
+  UINT64_C(0x9becce62836ac577), UINT64_C(0x4ee367f9430aec32),  /* -288 */
+  UINT64_C(0xc2e801fb244576d5), UINT64_C(0x229c41f793cda73f),  /* -287 */
+  UINT64_C(0xf3a20279ed56d48a), UINT64_C(0x6b43527578c1110f),  /* -286 */
+  UINT64_C(0x9845418c345644d6), UINT64_C(0x830a13896b78aaa9),  /* -285 */
+  UINT64_C(0xbe5691ef416bd60c), UINT64_C(0x23cc986bc656d553),  /* -284 */
+  UINT64_C(0xedec366b11c6cb8f), UINT64_C(0x2cbfbe86b7ec8aa8),  /* -283 */
+  UINT64_C(0x94b3a202eb1c3f39), UINT64_C(0x7bf7d71432f3d6a9),  /* -282 */
+  UINT64_C(0xb9e08a83a5e34f07), UINT64_C(0xdaf5ccd93fb0cc53),  /* -281 */
+  UINT64_C(0xe858ad248f5c22c9), UINT64_C(0xd1b3400f8f9cff68),  /* -280 */
+  UINT64_C(0x91376c36d99995be), UINT64_C(0x23100809b9c21fa1),  /* -279 */
+  UINT64_C(0xb58547448ffffb2d), UINT64_C(0xabd40a0c2832a78a),  /* -278 */
+  UINT64_C(0xe2e69915b3fff9f9), UINT64_C(0x16c90c8f323f516c),  /* -277 */
+  UINT64_C(0x8dd01fad907ffc3b), UINT64_C(0xae3da7d97f6792e3),  /* -276 */
+  UINT64_C(0xb1442798f49ffb4a), UINT64_C(0x99cd11cfdf41779c),  /* -275 */
+  UINT64_C(0xdd95317f31c7fa1d), UINT64_C(0x40405643d711d583),  /* -274 */
+  UINT64_C(0x8a7d3eef7f1cfc52), UINT64_C(0x482835ea666b2572),  /* -273 */
+  UINT64_C(0xad1c8eab5ee43b66), UINT64_C(0xda3243650005eecf),  /* -272 */
+  UINT64_C(0xd863b256369d4a40), UINT64_C(0x90bed43e40076a82),  /* -271 */
+  UINT64_C(0x873e4f75e2224e68), UINT64_C(0x5a7744a6e804a291),  /* -270 */
+  UINT64_C(0xa90de3535aaae202), UINT64_C(0x711515d0a205cb36),  /* -269 */
+  UINT64_C(0xd3515c2831559a83), UINT64_C(0x0d5a5b44ca873e03),  /* -268 */
+  UINT64_C(0x8412d9991ed58091), UINT64_C(0xe858790afe9486c2),  /* -267 */
+  UINT64_C(0xa5178fff668ae0b6), UINT64_C(0x626e974dbe39a872),  /* -266 */
+  UINT64_C(0xce5d73ff402d98e3), UINT64_C(0xfb0a3d212dc8128f),  /* -265 */
+  UINT64_C(0x80fa687f881c7f8e), UINT64_C(0x7ce66634bc9d0b99),  /* -264 */
+  UINT64_C(0xa139029f6a239f72), UINT64_C(0x1c1fffc1ebc44e80),  /* -263 */
+  UINT64_C(0xc987434744ac874e), UINT64_C(0xa327ffb266b56220),  /* -262 */
+  UINT64_C(0xfbe9141915d7a922), UINT64_C(0x4bf1ff9f0062baa8),  /* -261 */
+  UINT64_C(0x9d71ac8fada6c9b5), UINT64_C(0x6f773fc3603db4a9),  /* -260 */
+  UINT64_C(0xc4ce17b399107c22), UINT64_C(0xcb550fb4384d21d3),  /* -259 */
+  UINT64_C(0xf6019da07f549b2b), UINT64_C(0x7e2a53a146606a48),  /* -258 */
+  UINT64_C(0x99c102844f94e0fb), UINT64_C(0x2eda7444cbfc426d),  /* -257 */
+  UINT64_C(0xc0314325637a1939), UINT64_C(0xfa911155fefb5308),  /* -256 */
+  UINT64_C(0xf03d93eebc589f88), UINT64_C(0x793555ab7eba27ca),  /* -255 */
+  UINT64_C(0x96267c7535b763b5), UINT64_C(0x4bc1558b2f3458de),  /* -254 */
+  UINT64_C(0xbbb01b9283253ca2), UINT64_C(0x9eb1aaedfb016f16),  /* -253 */
+  UINT64_C(0xea9c227723ee8bcb), UINT64_C(0x465e15a979c1cadc),  /* -252 */
+  UINT64_C(0x92a1958a7675175f), UINT64_C(0x0bfacd89ec191ec9),  /* -251 */
+  UINT64_C(0xb749faed14125d36), UINT64_C(0xcef980ec671f667b),  /* -250 */
+  UINT64_C(0xe51c79a85916f484), UINT64_C(0x82b7e12780e7401a),  /* -249 */
+  UINT64_C(0x8f31cc0937ae58d2), UINT64_C(0xd1b2ecb8b0908810),  /* -248 */
+  UINT64_C(0xb2fe3f0b8599ef07), UINT64_C(0x861fa7e6dcb4aa15),  /* -247 */
+  UINT64_C(0xdfbdcece67006ac9), UINT64_C(0x67a791e093e1d49a),  /* -246 */
+  UINT64_C(0x8bd6a141006042bd), UINT64_C(0xe0c8bb2c5c6d24e0),  /* -245 */
+  UINT64_C(0xaecc49914078536d), UINT64_C(0x58fae9f773886e18),  /* -244 */
+  UINT64_C(0xda7f5bf590966848), UINT64_C(0xaf39a475506a899e),  /* -243 */
+  UINT64_C(0x888f99797a5e012d), UINT64_C(0x6d8406c952429603),  /* -242 */
+  UINT64_C(0xaab37fd7d8f58178), UINT64_C(0xc8e5087ba6d33b83),  /* -241 */
+  UINT64_C(0xd5605fcdcf32e1d6), UINT64_C(0xfb1e4a9a90880a64),  /* -240 */
+  UINT64_C(0x855c3be0a17fcd26), UINT64_C(0x5cf2eea09a55067f),  /* -239 */
+  UINT64_C(0xa6b34ad8c9dfc06f), UINT64_C(0xf42faa48c0ea481e),  /* -238 */
+  UINT64_C(0xd0601d8efc57b08b), UINT64_C(0xf13b94daf124da26),  /* -237 */
+  UINT64_C(0x823c12795db6ce57), UINT64_C(0x76c53d08d6b70858),  /* -236 */
+  UINT64_C(0xa2cb1717b52481ed), UINT64_C(0x54768c4b0c64ca6e),  /* -235 */
+  UINT64_C(0xcb7ddcdda26da268), UINT64_C(0xa9942f5dcf7dfd09),  /* -234 */
+  UINT64_C(0xfe5d54150b090b02), UINT64_C(0xd3f93b35435d7c4c),  /* -233 */
+  UINT64_C(0x9efa548d26e5a6e1), UINT64_C(0xc47bc5014a1a6daf),  /* -232 */
+  UINT64_C(0xc6b8e9b0709f109a), UINT64_C(0x359ab6419ca1091b),  /* -231 */
+  UINT64_C(0xf867241c8cc6d4c0), UINT64_C(0xc30163d203c94b62),  /* -230 */
+  UINT64_C(0x9b407691d7fc44f8), UINT64_C(0x79e0de63425dcf1d),  /* -229 */
+  UINT64_C(0xc21094364dfb5636), UINT64_C(0x985915fc12f542e4),  /* -228 */
+  UINT64_C(0xf294b943e17a2bc4), UINT64_C(0x3e6f5b7b17b2939d),  /* -227 */
+  UINT64_C(0x979cf3ca6cec5b5a), UINT64_C(0xa705992ceecf9c42),  /* -226 */
+  UINT64_C(0xbd8430bd08277231), UINT64_C(0x50c6ff782a838353),  /* -225 */
+  UINT64_C(0xece53cec4a314ebd), UINT64_C(0xa4f8bf5635246428),  /* -224 */
+  UINT64_C(0x940f4613ae5ed136), UINT64_C(0x871b7795e136be99),  /* -223 */
+  UINT64_C(0xb913179899f68584), UINT64_C(0x28e2557b59846e3f),  /* -222 */
+  UINT64_C(0xe757dd7ec07426e5), UINT64_C(0x331aeada2fe589cf),  /* -221 */
+  UINT64_C(0x9096ea6f3848984f), UINT64_C(0x3ff0d2c85def7621),  /* -220 */
+  UINT64_C(0xb4bca50b065abe63), UINT64_C(0x0fed077a756b53a9),  /* -219 */
+  UINT64_C(0xe1ebce4dc7f16dfb), UINT64_C(0xd3e8495912c62894),  /* -218 */
+  UINT64_C(0x8d3360f09cf6e4bd), UINT64_C(0x64712dd7abbbd95c),  /* -217 */
+  UINT64_C(0xb080392cc4349dec), UINT64_C(0xbd8d794d96aacfb3),  /* -216 */
+  UINT64_C(0xdca04777f541c567), UINT64_C(0xecf0d7a0fc5583a0),  /* -215 */
+  UINT64_C(0x89e42caaf9491b60), UINT64_C(0xf41686c49db57244),  /* -214 */
+  UINT64_C(0xac5d37d5b79b6239), UINT64_C(0x311c2875c522ced5),  /* -213 */
+  UINT64_C(0xd77485cb25823ac7), UINT64_C(0x7d633293366b828b),  /* -212 */
+  UINT64_C(0x86a8d39ef77164bc), UINT64_C(0xae5dff9c02033197),  /* -211 */
+  UINT64_C(0xa8530886b54dbdeb), UINT64_C(0xd9f57f830283fdfc),  /* -210 */
+  UINT64_C(0xd267caa862a12d66), UINT64_C(0xd072df63c324fd7b),  /* -209 */
+  UINT64_C(0x8380dea93da4bc60), UINT64_C(0x4247cb9e59f71e6d),  /* -208 */
+  UINT64_C(0xa46116538d0deb78), UINT64_C(0x52d9be85f074e608),  /* -207 */
+  UINT64_C(0xcd795be870516656), UINT64_C(0x67902e276c921f8b),  /* -206 */
+  UINT64_C(0x806bd9714632dff6), UINT64_C(0x00ba1cd8a3db53b6),  /* -205 */
+  UINT64_C(0xa086cfcd97bf97f3), UINT64_C(0x80e8a40eccd228a4),  /* -204 */
+  UINT64_C(0xc8a883c0fdaf7df0), UINT64_C(0x6122cd128006b2cd),  /* -203 */
+  UINT64_C(0xfad2a4b13d1b5d6c), UINT64_C(0x796b805720085f81),  /* -202 */
+  UINT64_C(0x9cc3a6eec6311a63), UINT64_C(0xcbe3303674053bb0),  /* -201 */
+  UINT64_C(0xc3f490aa77bd60fc), UINT64_C(0xbedbfc4411068a9c),  /* -200 */
+  UINT64_C(0xf4f1b4d515acb93b), UINT64_C(0xee92fb5515482d44),  /* -199 */
+  UINT64_C(0x991711052d8bf3c5), UINT64_C(0x751bdd152d4d1c4a),  /* -198 */
+  UINT64_C(0xbf5cd54678eef0b6), UINT64_C(0xd262d45a78a0635d),  /* -197 */
+  UINT64_C(0xef340a98172aace4), UINT64_C(0x86fb897116c87c34),  /* -196 */
+  UINT64_C(0x9580869f0e7aac0e), UINT64_C(0xd45d35e6ae3d4da0),  /* -195 */
+  UINT64_C(0xbae0a846d2195712), UINT64_C(0x8974836059cca109),  /* -194 */
+  UINT64_C(0xe998d258869facd7), UINT64_C(0x2bd1a438703fc94b),  /* -193 */
+  UINT64_C(0x91ff83775423cc06), UINT64_C(0x7b6306a34627ddcf),  /* -192 */
+  UINT64_C(0xb67f6455292cbf08), UINT64_C(0x1a3bc84c17b1d542),  /* -191 */
+  UINT64_C(0xe41f3d6a7377eeca), UINT64_C(0x20caba5f1d9e4a93),  /* -190 */
+  UINT64_C(0x8e938662882af53e), UINT64_C(0x547eb47b7282ee9c),  /* -189 */
+  UINT64_C(0xb23867fb2a35b28d), UINT64_C(0xe99e619a4f23aa43),  /* -188 */
+  UINT64_C(0xdec681f9f4c31f31), UINT64_C(0x6405fa00e2ec94d4),  /* -187 */
+  UINT64_C(0x8b3c113c38f9f37e), UINT64_C(0xde83bc408dd3dd04),  /* -186 */
+  UINT64_C(0xae0b158b4738705e), UINT64_C(0x9624ab50b148d445),  /* -185 */
+  UINT64_C(0xd98ddaee19068c76), UINT64_C(0x3badd624dd9b0957),  /* -184 */
+  UINT64_C(0x87f8a8d4cfa417c9), UINT64_C(0xe54ca5d70a80e5d6),  /* -183 */
+  UINT64_C(0xa9f6d30a038d1dbc), UINT64_C(0x5e9fcf4ccd211f4c),  /* -182 */
+  UINT64_C(0xd47487cc8470652b), UINT64_C(0x7647c3200069671f),  /* -181 */
+  UINT64_C(0x84c8d4dfd2c63f3b), UINT64_C(0x29ecd9f40041e073),  /* -180 */
+  UINT64_C(0xa5fb0a17c777cf09), UINT64_C(0xf468107100525890),  /* -179 */
+  UINT64_C(0xcf79cc9db955c2cc), UINT64_C(0x7182148d4066eeb4),  /* -178 */
+  UINT64_C(0x81ac1fe293d599bf), UINT64_C(0xc6f14cd848405530),  /* -177 */
+  UINT64_C(0xa21727db38cb002f), UINT64_C(0xb8ada00e5a506a7c),  /* -176 */
+  UINT64_C(0xca9cf1d206fdc03b), UINT64_C(0xa6d90811f0e4851c),  /* -175 */
+  UINT64_C(0xfd442e4688bd304a), UINT64_C(0x908f4a166d1da663),  /* -174 */
+  UINT64_C(0x9e4a9cec15763e2e), UINT64_C(0x9a598e4e043287fe),  /* -173 */
+  UINT64_C(0xc5dd44271ad3cdba), UINT64_C(0x40eff1e1853f29fd),  /* -172 */
+  UINT64_C(0xf7549530e188c128), UINT64_C(0xd12bee59e68ef47c),  /* -171 */
+  UINT64_C(0x9a94dd3e8cf578b9), UINT64_C(0x82bb74f8301958ce),  /* -170 */
+  UINT64_C(0xc13a148e3032d6e7), UINT64_C(0xe36a52363c1faf01),  /* -169 */
+  UINT64_C(0xf18899b1bc3f8ca1), UINT64_C(0xdc44e6c3cb279ac1),  /* -168 */
+  UINT64_C(0x96f5600f15a7b7e5), UINT64_C(0x29ab103a5ef8c0b9),  /* -167 */
+  UINT64_C(0xbcb2b812db11a5de), UINT64_C(0x7415d448f6b6f0e7),  /* -166 */
+  UINT64_C(0xebdf661791d60f56), UINT64_C(0x111b495b3464ad21),  /* -165 */
+  UINT64_C(0x936b9fcebb25c995), UINT64_C(0xcab10dd900beec34),  /* -164 */
+  UINT64_C(0xb84687c269ef3bfb), UINT64_C(0x3d5d514f40eea742),  /* -163 */
+  UINT64_C(0xe65829b3046b0afa), UINT64_C(0x0cb4a5a3112a5112),  /* -162 */
+  UINT64_C(0x8ff71a0fe2c2e6dc), UINT64_C(0x47f0e785eaba72ab),  /* -161 */
+  UINT64_C(0xb3f4e093db73a093), UINT64_C(0x59ed216765690f56),  /* -160 */
+  UINT64_C(0xe0f218b8d25088b8), UINT64_C(0x306869c13ec3532c),  /* -159 */
+  UINT64_C(0x8c974f7383725573), UINT64_C(0x1e414218c73a13fb),  /* -158 */
+  UINT64_C(0xafbd2350644eeacf), UINT64_C(0xe5d1929ef90898fa),  /* -157 */
+  UINT64_C(0xdbac6c247d62a583), UINT64_C(0xdf45f746b74abf39),  /* -156 */
+  UINT64_C(0x894bc396ce5da772), UINT64_C(0x6b8bba8c328eb783),  /* -155 */
+  UINT64_C(0xab9eb47c81f5114f), UINT64_C(0x066ea92f3f326564),  /* -154 */
+  UINT64_C(0xd686619ba27255a2), UINT64_C(0xc80a537b0efefebd),  /* -153 */
+  UINT64_C(0x8613fd0145877585), UINT64_C(0xbd06742ce95f5f36),  /* -152 */
+  UINT64_C(0xa798fc4196e952e7), UINT64_C(0x2c48113823b73704),  /* -151 */
+  UINT64_C(0xd17f3b51fca3a7a0), UINT64_C(0xf75a15862ca504c5),  /* -150 */
+  UINT64_C(0x82ef85133de648c4), UINT64_C(0x9a984d73dbe722fb),  /* -149 */
+  UINT64_C(0xa3ab66580d5fdaf5), UINT64_C(0xc13e60d0d2e0ebba),  /* -148 */
+  UINT64_C(0xcc963fee10b7d1b3), UINT64_C(0x318df905079926a8),  /* -147 */
+  UINT64_C(0xffbbcfe994e5c61f), UINT64_C(0xfdf17746497f7052),  /* -146 */
+  UINT64_C(0x9fd561f1fd0f9bd3), UINT64_C(0xfeb6ea8bedefa633),  /* -145 */
+  UINT64_C(0xc7caba6e7c5382c8), UINT64_C(0xfe64a52ee96b8fc0),  /* -144 */
+  UINT64_C(0xf9bd690a1b68637b), UINT64_C(0x3dfdce7aa3c673b0),  /* -143 */
+  UINT64_C(0x9c1661a651213e2d), UINT64_C(0x06bea10ca65c084e),  /* -142 */
+  UINT64_C(0xc31bfa0fe5698db8), UINT64_C(0x486e494fcff30a62),  /* -141 */
+  UINT64_C(0xf3e2f893dec3f126), UINT64_C(0x5a89dba3c3efccfa),  /* -140 */
+  UINT64_C(0x986ddb5c6b3a76b7), UINT64_C(0xf89629465a75e01c),  /* -139 */
+  UINT64_C(0xbe89523386091465), UINT64_C(0xf6bbb397f1135823),  /* -138 */
+  UINT64_C(0xee2ba6c0678b597f), UINT64_C(0x746aa07ded582e2c),  /* -137 */
+  UINT64_C(0x94db483840b717ef), UINT64_C(0xa8c2a44eb4571cdc),  /* -136 */
+  UINT64_C(0xba121a4650e4ddeb), UINT64_C(0x92f34d62616ce413),  /* -135 */
+  UINT64_C(0xe896a0d7e51e1566), UINT64_C(0x77b020baf9c81d17),  /* -134 */
+  UINT64_C(0x915e2486ef32cd60), UINT64_C(0x0ace1474dc1d122e),  /* -133 */
+  UINT64_C(0xb5b5ada8aaff80b8), UINT64_C(0x0d819992132456ba),  /* -132 */
+  UINT64_C(0xe3231912d5bf60e6), UINT64_C(0x10e1fff697ed6c69),  /* -131 */
+  UINT64_C(0x8df5efabc5979c8f), UINT64_C(0xca8d3ffa1ef463c1),  /* -130 */
+  UINT64_C(0xb1736b96b6fd83b3), UINT64_C(0xbd308ff8a6b17cb2),  /* -129 */
+  UINT64_C(0xddd0467c64bce4a0), UINT64_C(0xac7cb3f6d05ddbde),  /* -128 */
+  UINT64_C(0x8aa22c0dbef60ee4), UINT64_C(0x6bcdf07a423aa96b),  /* -127 */
+  UINT64_C(0xad4ab7112eb3929d), UINT64_C(0x86c16c98d2c953c6),  /* -126 */
+  UINT64_C(0xd89d64d57a607744), UINT64_C(0xe871c7bf077ba8b7),  /* -125 */
+  UINT64_C(0x87625f056c7c4a8b), UINT64_C(0x11471cd764ad4972),  /* -124 */
+  UINT64_C(0xa93af6c6c79b5d2d), UINT64_C(0xd598e40d3dd89bcf),  /* -123 */
+  UINT64_C(0xd389b47879823479), UINT64_C(0x4aff1d108d4ec2c3),  /* -122 */
+  UINT64_C(0x843610cb4bf160cb), UINT64_C(0xcedf722a585139ba),  /* -121 */
+  UINT64_C(0xa54394fe1eedb8fe), UINT64_C(0xc2974eb4ee658828),  /* -120 */
+  UINT64_C(0xce947a3da6a9273e), UINT64_C(0x733d226229feea32),  /* -119 */
+  UINT64_C(0x811ccc668829b887), UINT64_C(0x0806357d5a3f525f),  /* -118 */
+  UINT64_C(0xa163ff802a3426a8), UINT64_C(0xca07c2dcb0cf26f7),  /* -117 */
+  UINT64_C(0xc9bcff6034c13052), UINT64_C(0xfc89b393dd02f0b5),  /* -116 */
+  UINT64_C(0xfc2c3f3841f17c67), UINT64_C(0xbbac2078d443ace2),  /* -115 */
+  UINT64_C(0x9d9ba7832936edc0), UINT64_C(0xd54b944b84aa4c0d),  /* -114 */
+  UINT64_C(0xc5029163f384a931), UINT64_C(0x0a9e795e65d4df11),  /* -113 */
+  UINT64_C(0xf64335bcf065d37d), UINT64_C(0x4d4617b5ff4a16d5),  /* -112 */
+  UINT64_C(0x99ea0196163fa42e), UINT64_C(0x504bced1bf8e4e45),  /* -111 */
+  UINT64_C(0xc06481fb9bcf8d39), UINT64_C(0xe45ec2862f71e1d6),  /* -110 */
+  UINT64_C(0xf07da27a82c37088), UINT64_C(0x5d767327bb4e5a4c),  /* -109 */
+  UINT64_C(0x964e858c91ba2655), UINT64_C(0x3a6a07f8d510f86f),  /* -108 */
+  UINT64_C(0xbbe226efb628afea), UINT64_C(0x890489f70a55368b),  /* -107 */
+  UINT64_C(0xeadab0aba3b2dbe5), UINT64_C(0x2b45ac74ccea842e),  /* -106 */
+  UINT64_C(0x92c8ae6b464fc96f), UINT64_C(0x3b0b8bc90012929d),  /* -105 */
+  UINT64_C(0xb77ada0617e3bbcb), UINT64_C(0x09ce6ebb40173744),  /* -104 */
+  UINT64_C(0xe55990879ddcaabd), UINT64_C(0xcc420a6a101d0515),  /* -103 */
+  UINT64_C(0x8f57fa54c2a9eab6), UINT64_C(0x9fa946824a12232d),  /* -102 */
+  UINT64_C(0xb32df8e9f3546564), UINT64_C(0x47939822dc96abf9),  /* -101 */
+  UINT64_C(0xdff9772470297ebd), UINT64_C(0x59787e2b93bc56f7),  /* -100 */
+  UINT64_C(0x8bfbea76c619ef36), UINT64_C(0x57eb4edb3c55b65a),  /* -99 */
+  UINT64_C(0xaefae51477a06b03), UINT64_C(0xede622920b6b23f1),  /* -98 */
+  UINT64_C(0xdab99e59958885c4), UINT64_C(0xe95fab368e45eced),  /* -97 */
+  UINT64_C(0x88b402f7fd75539b), UINT64_C(0x11dbcb0218ebb414),  /* -96 */
+  UINT64_C(0xaae103b5fcd2a881), UINT64_C(0xd652bdc29f26a119),  /* -95 */
+  UINT64_C(0xd59944a37c0752a2), UINT64_C(0x4be76d3346f0495f),  /* -94 */
+  UINT64_C(0x857fcae62d8493a5), UINT64_C(0x6f70a4400c562ddb),  /* -93 */
+  UINT64_C(0xa6dfbd9fb8e5b88e), UINT64_C(0xcb4ccd500f6bb952),  /* -92 */
+  UINT64_C(0xd097ad07a71f26b2), UINT64_C(0x7e2000a41346a7a7),  /* -91 */
+  UINT64_C(0x825ecc24c873782f), UINT64_C(0x8ed400668c0c28c8),  /* -90 */
+  UINT64_C(0xa2f67f2dfa90563b), UINT64_C(0x728900802f0f32fa),  /* -89 */
+  UINT64_C(0xcbb41ef979346bca), UINT64_C(0x4f2b40a03ad2ffb9),  /* -88 */
+  UINT64_C(0xfea126b7d78186bc), UINT64_C(0xe2f610c84987bfa8),  /* -87 */
+  UINT64_C(0x9f24b832e6b0f436), UINT64_C(0x0dd9ca7d2df4d7c9),  /* -86 */
+  UINT64_C(0xc6ede63fa05d3143), UINT64_C(0x91503d1c79720dbb),  /* -85 */
+  UINT64_C(0xf8a95fcf88747d94), UINT64_C(0x75a44c6397ce912a),  /* -84 */
+  UINT64_C(0x9b69dbe1b548ce7c), UINT64_C(0xc986afbe3ee11aba),  /* -83 */
+  UINT64_C(0xc24452da229b021b), UINT64_C(0xfbe85badce996168),  /* -82 */
+  UINT64_C(0xf2d56790ab41c2a2), UINT64_C(0xfae27299423fb9c3),  /* -81 */
+  UINT64_C(0x97c560ba6b0919a5), UINT64_C(0xdccd879fc967d41a),  /* -80 */
+  UINT64_C(0xbdb6b8e905cb600f), UINT64_C(0x5400e987bbc1c920),  /* -79 */
+  UINT64_C(0xed246723473e3813), UINT64_C(0x290123e9aab23b68),  /* -78 */
+  UINT64_C(0x9436c0760c86e30b), UINT64_C(0xf9a0b6720aaf6521),  /* -77 */
+  UINT64_C(0xb94470938fa89bce), UINT64_C(0xf808e40e8d5b3e69),  /* -76 */
+  UINT64_C(0xe7958cb87392c2c2), UINT64_C(0xb60b1d1230b20e04),  /* -75 */
+  UINT64_C(0x90bd77f3483bb9b9), UINT64_C(0xb1c6f22b5e6f48c2),  /* -74 */
+  UINT64_C(0xb4ecd5f01a4aa828), UINT64_C(0x1e38aeb6360b1af3),  /* -73 */
+  UINT64_C(0xe2280b6c20dd5232), UINT64_C(0x25c6da63c38de1b0),  /* -72 */
+  UINT64_C(0x8d590723948a535f), UINT64_C(0x579c487e5a38ad0e),  /* -71 */
+  UINT64_C(0xb0af48ec79ace837), UINT64_C(0x2d835a9df0c6d851),  /* -70 */
+  UINT64_C(0xdcdb1b2798182244), UINT64_C(0xf8e431456cf88e65),  /* -69 */
+  UINT64_C(0x8a08f0f8bf0f156b), UINT64_C(0x1b8e9ecb641b58ff),  /* -68 */
+  UINT64_C(0xac8b2d36eed2dac5), UINT64_C(0xe272467e3d222f3f),  /* -67 */
+  UINT64_C(0xd7adf884aa879177), UINT64_C(0x5b0ed81dcc6abb0f),  /* -66 */
+  UINT64_C(0x86ccbb52ea94baea), UINT64_C(0x98e947129fc2b4e9),  /* -65 */
+  UINT64_C(0xa87fea27a539e9a5), UINT64_C(0x3f2398d747b36224),  /* -64 */
+  UINT64_C(0xd29fe4b18e88640e), UINT64_C(0x8eec7f0d19a03aad),  /* -63 */
+  UINT64_C(0x83a3eeeef9153e89), UINT64_C(0x1953cf68300424ac),  /* -62 */
+  UINT64_C(0xa48ceaaab75a8e2b), UINT64_C(0x5fa8c3423c052dd7),  /* -61 */
+  UINT64_C(0xcdb02555653131b6), UINT64_C(0x3792f412cb06794d),  /* -60 */
+  UINT64_C(0x808e17555f3ebf11), UINT64_C(0xe2bbd88bbee40bd0),  /* -59 */
+  UINT64_C(0xa0b19d2ab70e6ed6), UINT64_C(0x5b6aceaeae9d0ec4),  /* -58 */
+  UINT64_C(0xc8de047564d20a8b), UINT64_C(0xf245825a5a445275),  /* -57 */
+  UINT64_C(0xfb158592be068d2e), UINT64_C(0xeed6e2f0f0d56712),  /* -56 */
+  UINT64_C(0x9ced737bb6c4183d), UINT64_C(0x55464dd69685606b),  /* -55 */
+  UINT64_C(0xc428d05aa4751e4c), UINT64_C(0xaa97e14c3c26b886),  /* -54 */
+  UINT64_C(0xf53304714d9265df), UINT64_C(0xd53dd99f4b3066a8),  /* -53 */
+  UINT64_C(0x993fe2c6d07b7fab), UINT64_C(0xe546a8038efe4029),  /* -52 */
+  UINT64_C(0xbf8fdb78849a5f96), UINT64_C(0xde98520472bdd033),  /* -51 */
+  UINT64_C(0xef73d256a5c0f77c), UINT64_C(0x963e66858f6d4440),  /* -50 */
+  UINT64_C(0x95a8637627989aad), UINT64_C(0xdde7001379a44aa8),  /* -49 */
+  UINT64_C(0xbb127c53b17ec159), UINT64_C(0x5560c018580d5d52),  /* -48 */
+  UINT64_C(0xe9d71b689dde71af), UINT64_C(0xaab8f01e6e10b4a6),  /* -47 */
+  UINT64_C(0x9226712162ab070d), UINT64_C(0xcab3961304ca70e8),  /* -46 */
+  UINT64_C(0xb6b00d69bb55c8d1), UINT64_C(0x3d607b97c5fd0d22),  /* -45 */
+  UINT64_C(0xe45c10c42a2b3b05), UINT64_C(0x8cb89a7db77c506a),  /* -44 */
+  UINT64_C(0x8eb98a7a9a5b04e3), UINT64_C(0x77f3608e92adb242),  /* -43 */
+  UINT64_C(0xb267ed1940f1c61c), UINT64_C(0x55f038b237591ed3),  /* -42 */
+  UINT64_C(0xdf01e85f912e37a3), UINT64_C(0x6b6c46dec52f6688),  /* -41 */
+  UINT64_C(0x8b61313bbabce2c6), UINT64_C(0x2323ac4b3b3da015),  /* -40 */
+  UINT64_C(0xae397d8aa96c1b77), UINT64_C(0xabec975e0a0d081a),  /* -39 */
+  UINT64_C(0xd9c7dced53c72255), UINT64_C(0x96e7bd358c904a21),  /* -38 */
+  UINT64_C(0x881cea14545c7575), UINT64_C(0x7e50d64177da2e54),  /* -37 */
+  UINT64_C(0xaa242499697392d2), UINT64_C(0xdde50bd1d5d0b9e9),  /* -36 */
+  UINT64_C(0xd4ad2dbfc3d07787), UINT64_C(0x955e4ec64b44e864),  /* -35 */
+  UINT64_C(0x84ec3c97da624ab4), UINT64_C(0xbd5af13bef0b113e),  /* -34 */
+  UINT64_C(0xa6274bbdd0fadd61), UINT64_C(0xecb1ad8aeacdd58e),  /* -33 */
+  UINT64_C(0xcfb11ead453994ba), UINT64_C(0x67de18eda5814af2),  /* -32 */
+  UINT64_C(0x81ceb32c4b43fcf4), UINT64_C(0x80eacf948770ced7),  /* -31 */
+  UINT64_C(0xa2425ff75e14fc31), UINT64_C(0xa1258379a94d028d),  /* -30 */
+  UINT64_C(0xcad2f7f5359a3b3e), UINT64_C(0x096ee45813a04330),  /* -29 */
+  UINT64_C(0xfd87b5f28300ca0d), UINT64_C(0x8bca9d6e188853fc),  /* -28 */
+  UINT64_C(0x9e74d1b791e07e48), UINT64_C(0x775ea264cf55347e),  /* -27 */
+  UINT64_C(0xc612062576589dda), UINT64_C(0x95364afe032a819e),  /* -26 */
+  UINT64_C(0xf79687aed3eec551), UINT64_C(0x3a83ddbd83f52205),  /* -25 */
+  UINT64_C(0x9abe14cd44753b52), UINT64_C(0xc4926a9672793543),  /* -24 */
+  UINT64_C(0xc16d9a0095928a27), UINT64_C(0x75b7053c0f178294),  /* -23 */
+  UINT64_C(0xf1c90080baf72cb1), UINT64_C(0x5324c68b12dd6339),  /* -22 */
+  UINT64_C(0x971da05074da7bee), UINT64_C(0xd3f6fc16ebca5e04),  /* -21 */
+  UINT64_C(0xbce5086492111aea), UINT64_C(0x88f4bb1ca6bcf585),  /* -20 */
+  UINT64_C(0xec1e4a7db69561a5), UINT64_C(0x2b31e9e3d06c32e6),  /* -19 */
+  UINT64_C(0x9392ee8e921d5d07), UINT64_C(0x3aff322e62439fd0),  /* -18 */
+  UINT64_C(0xb877aa3236a4b449), UINT64_C(0x09befeb9fad487c3),  /* -17 */
+  UINT64_C(0xe69594bec44de15b), UINT64_C(0x4c2ebe687989a9b4),  /* -16 */
+  UINT64_C(0x901d7cf73ab0acd9), UINT64_C(0x0f9d37014bf60a11),  /* -15 */
+  UINT64_C(0xb424dc35095cd80f), UINT64_C(0x538484c19ef38c95),  /* -14 */
+  UINT64_C(0xe12e13424bb40e13), UINT64_C(0x2865a5f206b06fba),  /* -13 */
+  UINT64_C(0x8cbccc096f5088cb), UINT64_C(0xf93f87b7442e45d4),  /* -12 */
+  UINT64_C(0xafebff0bcb24aafe), UINT64_C(0xf78f69a51539d749),  /* -11 */
+  UINT64_C(0xdbe6fecebdedd5be), UINT64_C(0xb573440e5a884d1c),  /* -10 */
+  UINT64_C(0x89705f4136b4a597), UINT64_C(0x31680a88f8953031),  /* -9 */
+  UINT64_C(0xabcc77118461cefc), UINT64_C(0xfdc20d2b36ba7c3e),  /* -8 */
+  UINT64_C(0xd6bf94d5e57a42bc), UINT64_C(0x3d32907604691b4d),  /* -7 */
+  UINT64_C(0x8637bd05af6c69b5), UINT64_C(0xa63f9a49c2c1b110),  /* -6 */
+  UINT64_C(0xa7c5ac471b478423), UINT64_C(0x0fcf80dc33721d54),  /* -5 */
+  UINT64_C(0xd1b71758e219652b), UINT64_C(0xd3c36113404ea4a9),  /* -4 */
+  UINT64_C(0x83126e978d4fdf3b), UINT64_C(0x645a1cac083126ea),  /* -3 */
+  UINT64_C(0xa3d70a3d70a3d70a), UINT64_C(0x3d70a3d70a3d70a4),  /* -2 */
+  UINT64_C(0xcccccccccccccccc), UINT64_C(0xcccccccccccccccd),  /* -1 */
+  UINT64_C(0x8000000000000000), UINT64_C(0x0000000000000000),  /* 0 */
+  UINT64_C(0xa000000000000000), UINT64_C(0x0000000000000000),  /* 1 */
+  UINT64_C(0xc800000000000000), UINT64_C(0x0000000000000000),  /* 2 */
+  UINT64_C(0xfa00000000000000), UINT64_C(0x0000000000000000),  /* 3 */
+  UINT64_C(0x9c40000000000000), UINT64_C(0x0000000000000000),  /* 4 */
+  UINT64_C(0xc350000000000000), UINT64_C(0x0000000000000000),  /* 5 */
+  UINT64_C(0xf424000000000000), UINT64_C(0x0000000000000000),  /* 6 */
+  UINT64_C(0x9896800000000000), UINT64_C(0x0000000000000000),  /* 7 */
+  UINT64_C(0xbebc200000000000), UINT64_C(0x0000000000000000),  /* 8 */
+  UINT64_C(0xee6b280000000000), UINT64_C(0x0000000000000000),  /* 9 */
+  UINT64_C(0x9502f90000000000), UINT64_C(0x0000000000000000),  /* 10 */
+  UINT64_C(0xba43b74000000000), UINT64_C(0x0000000000000000),  /* 11 */
+  UINT64_C(0xe8d4a51000000000), UINT64_C(0x0000000000000000),  /* 12 */
+  UINT64_C(0x9184e72a00000000), UINT64_C(0x0000000000000000),  /* 13 */
+  UINT64_C(0xb5e620f480000000), UINT64_C(0x0000000000000000),  /* 14 */
+  UINT64_C(0xe35fa931a0000000), UINT64_C(0x0000000000000000),  /* 15 */
+  UINT64_C(0x8e1bc9bf04000000), UINT64_C(0x0000000000000000),  /* 16 */
+  UINT64_C(0xb1a2bc2ec5000000), UINT64_C(0x0000000000000000),  /* 17 */
+  UINT64_C(0xde0b6b3a76400000), UINT64_C(0x0000000000000000),  /* 18 */
+  UINT64_C(0x8ac7230489e80000), UINT64_C(0x0000000000000000),  /* 19 */
+  UINT64_C(0xad78ebc5ac620000), UINT64_C(0x0000000000000000),  /* 20 */
+  UINT64_C(0xd8d726b7177a8000), UINT64_C(0x0000000000000000),  /* 21 */
+  UINT64_C(0x878678326eac9000), UINT64_C(0x0000000000000000),  /* 22 */
+  UINT64_C(0xa968163f0a57b400), UINT64_C(0x0000000000000000),  /* 23 */
+  UINT64_C(0xd3c21bcecceda100), UINT64_C(0x0000000000000000),  /* 24 */
+  UINT64_C(0x84595161401484a0), UINT64_C(0x0000000000000000),  /* 25 */
+  UINT64_C(0xa56fa5b99019a5c8), UINT64_C(0x0000000000000000),  /* 26 */
+  UINT64_C(0xcecb8f27f4200f3a), UINT64_C(0x0000000000000000),  /* 27 */
+  UINT64_C(0x813f3978f8940984), UINT64_C(0x4000000000000000),  /* 28 */
+  UINT64_C(0xa18f07d736b90be5), UINT64_C(0x5000000000000000),  /* 29 */
+  UINT64_C(0xc9f2c9cd04674ede), UINT64_C(0xa400000000000000),  /* 30 */
+  UINT64_C(0xfc6f7c4045812296), UINT64_C(0x4d00000000000000),  /* 31 */
+  UINT64_C(0x9dc5ada82b70b59d), UINT64_C(0xf020000000000000),  /* 32 */
+  UINT64_C(0xc5371912364ce305), UINT64_C(0x6c28000000000000),  /* 33 */
+  UINT64_C(0xf684df56c3e01bc6), UINT64_C(0xc732000000000000),  /* 34 */
+  UINT64_C(0x9a130b963a6c115c), UINT64_C(0x3c7f400000000000),  /* 35 */
+  UINT64_C(0xc097ce7bc90715b3), UINT64_C(0x4b9f100000000000),  /* 36 */
+  UINT64_C(0xf0bdc21abb48db20), UINT64_C(0x1e86d40000000000),  /* 37 */
+  UINT64_C(0x96769950b50d88f4), UINT64_C(0x1314448000000000),  /* 38 */
+  UINT64_C(0xbc143fa4e250eb31), UINT64_C(0x17d955a000000000),  /* 39 */
+  UINT64_C(0xeb194f8e1ae525fd), UINT64_C(0x5dcfab0800000000),  /* 40 */
+  UINT64_C(0x92efd1b8d0cf37be), UINT64_C(0x5aa1cae500000000),  /* 41 */
+  UINT64_C(0xb7abc627050305ad), UINT64_C(0xf14a3d9e40000000),  /* 42 */
+  UINT64_C(0xe596b7b0c643c719), UINT64_C(0x6d9ccd05d0000000),  /* 43 */
+  UINT64_C(0x8f7e32ce7bea5c6f), UINT64_C(0xe4820023a2000000),  /* 44 */
+  UINT64_C(0xb35dbf821ae4f38b), UINT64_C(0xdda2802c8a800000),  /* 45 */
+  UINT64_C(0xe0352f62a19e306e), UINT64_C(0xd50b2037ad200000),  /* 46 */
+  UINT64_C(0x8c213d9da502de45), UINT64_C(0x4526f422cc340000),  /* 47 */
+  UINT64_C(0xaf298d050e4395d6), UINT64_C(0x9670b12b7f410000),  /* 48 */
+  UINT64_C(0xdaf3f04651d47b4c), UINT64_C(0x3c0cdd765f114000),  /* 49 */
+  UINT64_C(0x88d8762bf324cd0f), UINT64_C(0xa5880a69fb6ac800),  /* 50 */
+  UINT64_C(0xab0e93b6efee0053), UINT64_C(0x8eea0d047a457a00),  /* 51 */
+  UINT64_C(0xd5d238a4abe98068), UINT64_C(0x72a4904598d6d880),  /* 52 */
+  UINT64_C(0x85a36366eb71f041), UINT64_C(0x47a6da2b7f864750),  /* 53 */
+  UINT64_C(0xa70c3c40a64e6c51), UINT64_C(0x999090b65f67d924),  /* 54 */
+  UINT64_C(0xd0cf4b50cfe20765), UINT64_C(0xfff4b4e3f741cf6d),  /* 55 */
+  UINT64_C(0x82818f1281ed449f), UINT64_C(0xbff8f10e7a8921a4),  /* 56 */
+  UINT64_C(0xa321f2d7226895c7), UINT64_C(0xaff72d52192b6a0d),  /* 57 */
+  UINT64_C(0xcbea6f8ceb02bb39), UINT64_C(0x9bf4f8a69f764490),  /* 58 */
+  UINT64_C(0xfee50b7025c36a08), UINT64_C(0x02f236d04753d5b4),  /* 59 */
+  UINT64_C(0x9f4f2726179a2245), UINT64_C(0x01d762422c946590),  /* 60 */
+  UINT64_C(0xc722f0ef9d80aad6), UINT64_C(0x424d3ad2b7b97ef5),  /* 61 */
+  UINT64_C(0xf8ebad2b84e0d58b), UINT64_C(0xd2e0898765a7deb2),  /* 62 */
+  UINT64_C(0x9b934c3b330c8577), UINT64_C(0x63cc55f49f88eb2f),  /* 63 */
+  UINT64_C(0xc2781f49ffcfa6d5), UINT64_C(0x3cbf6b71c76b25fb),  /* 64 */
+  UINT64_C(0xf316271c7fc3908a), UINT64_C(0x8bef464e3945ef7a),  /* 65 */
+  UINT64_C(0x97edd871cfda3a56), UINT64_C(0x97758bf0e3cbb5ac),  /* 66 */
+  UINT64_C(0xbde94e8e43d0c8ec), UINT64_C(0x3d52eeed1cbea317),  /* 67 */
+  UINT64_C(0xed63a231d4c4fb27), UINT64_C(0x4ca7aaa863ee4bdd),  /* 68 */
+  UINT64_C(0x945e455f24fb1cf8), UINT64_C(0x8fe8caa93e74ef6a),  /* 69 */
+  UINT64_C(0xb975d6b6ee39e436), UINT64_C(0xb3e2fd538e122b44),  /* 70 */
+  UINT64_C(0xe7d34c64a9c85d44), UINT64_C(0x60dbbca87196b616),  /* 71 */
+  UINT64_C(0x90e40fbeea1d3a4a), UINT64_C(0xbc8955e946fe31cd),  /* 72 */
+  UINT64_C(0xb51d13aea4a488dd), UINT64_C(0x6babab6398bdbe41),  /* 73 */
+  UINT64_C(0xe264589a4dcdab14), UINT64_C(0xc696963c7eed2dd1),  /* 74 */
+  UINT64_C(0x8d7eb76070a08aec), UINT64_C(0xfc1e1de5cf543ca2),  /* 75 */
+  UINT64_C(0xb0de65388cc8ada8), UINT64_C(0x3b25a55f43294bcb),  /* 76 */
+  UINT64_C(0xdd15fe86affad912), UINT64_C(0x49ef0eb713f39ebe),  /* 77 */
+  UINT64_C(0x8a2dbf142dfcc7ab), UINT64_C(0x6e3569326c784337),  /* 78 */
+  UINT64_C(0xacb92ed9397bf996), UINT64_C(0x49c2c37f07965404),  /* 79 */
+  UINT64_C(0xd7e77a8f87daf7fb), UINT64_C(0xdc33745ec97be906),  /* 80 */
+  UINT64_C(0x86f0ac99b4e8dafd), UINT64_C(0x69a028bb3ded71a3),  /* 81 */
+  UINT64_C(0xa8acd7c0222311bc), UINT64_C(0xc40832ea0d68ce0c),  /* 82 */
+  UINT64_C(0xd2d80db02aabd62b), UINT64_C(0xf50a3fa490c30190),  /* 83 */
+  UINT64_C(0x83c7088e1aab65db), UINT64_C(0x792667c6da79e0fa),  /* 84 */
+  UINT64_C(0xa4b8cab1a1563f52), UINT64_C(0x577001b891185938),  /* 85 */
+  UINT64_C(0xcde6fd5e09abcf26), UINT64_C(0xed4c0226b55e6f86),  /* 86 */
+  UINT64_C(0x80b05e5ac60b6178), UINT64_C(0x544f8158315b05b4),  /* 87 */
+  UINT64_C(0xa0dc75f1778e39d6), UINT64_C(0x696361ae3db1c721),  /* 88 */
+  UINT64_C(0xc913936dd571c84c), UINT64_C(0x03bc3a19cd1e38e9),  /* 89 */
+  UINT64_C(0xfb5878494ace3a5f), UINT64_C(0x04ab48a04065c723),  /* 90 */
+  UINT64_C(0x9d174b2dcec0e47b), UINT64_C(0x62eb0d64283f9c76),  /* 91 */
+  UINT64_C(0xc45d1df942711d9a), UINT64_C(0x3ba5d0bd324f8394),  /* 92 */
+  UINT64_C(0xf5746577930d6500), UINT64_C(0xca8f44ec7ee36479),  /* 93 */
+  UINT64_C(0x9968bf6abbe85f20), UINT64_C(0x7e998b13cf4e1ecb),  /* 94 */
+  UINT64_C(0xbfc2ef456ae276e8), UINT64_C(0x9e3fedd8c321a67e),  /* 95 */
+  UINT64_C(0xefb3ab16c59b14a2), UINT64_C(0xc5cfe94ef3ea101e),  /* 96 */
+  UINT64_C(0x95d04aee3b80ece5), UINT64_C(0xbba1f1d158724a12),  /* 97 */
+  UINT64_C(0xbb445da9ca61281f), UINT64_C(0x2a8a6e45ae8edc97),  /* 98 */
+  UINT64_C(0xea1575143cf97226), UINT64_C(0xf52d09d71a3293bd),  /* 99 */
+  UINT64_C(0x924d692ca61be758), UINT64_C(0x593c2626705f9c56),  /* 100 */
+  UINT64_C(0xb6e0c377cfa2e12e), UINT64_C(0x6f8b2fb00c77836c),  /* 101 */
+  UINT64_C(0xe498f455c38b997a), UINT64_C(0x0b6dfb9c0f956447),  /* 102 */
+  UINT64_C(0x8edf98b59a373fec), UINT64_C(0x4724bd4189bd5eac),  /* 103 */
+  UINT64_C(0xb2977ee300c50fe7), UINT64_C(0x58edec91ec2cb657),  /* 104 */
+  UINT64_C(0xdf3d5e9bc0f653e1), UINT64_C(0x2f2967b66737e3ed),  /* 105 */
+  UINT64_C(0x8b865b215899f46c), UINT64_C(0xbd79e0d20082ee74),  /* 106 */
+  UINT64_C(0xae67f1e9aec07187), UINT64_C(0xecd8590680a3aa11),  /* 107 */
+  UINT64_C(0xda01ee641a708de9), UINT64_C(0xe80e6f4820cc9495),  /* 108 */
+  UINT64_C(0x884134fe908658b2), UINT64_C(0x3109058d147fdcdd),  /* 109 */
+  UINT64_C(0xaa51823e34a7eede), UINT64_C(0xbd4b46f0599fd415),  /* 110 */
+  UINT64_C(0xd4e5e2cdc1d1ea96), UINT64_C(0x6c9e18ac7007c91a),  /* 111 */
+  UINT64_C(0x850fadc09923329e), UINT64_C(0x03e2cf6bc604ddb0),  /* 112 */
+  UINT64_C(0xa6539930bf6bff45), UINT64_C(0x84db8346b786151c),  /* 113 */
+  UINT64_C(0xcfe87f7cef46ff16), UINT64_C(0xe612641865679a63),  /* 114 */
+  UINT64_C(0x81f14fae158c5f6e), UINT64_C(0x4fcb7e8f3f60c07e),  /* 115 */
+  UINT64_C(0xa26da3999aef7749), UINT64_C(0xe3be5e330f38f09d),  /* 116 */
+  UINT64_C(0xcb090c8001ab551c), UINT64_C(0x5cadf5bfd3072cc5),  /* 117 */
+  UINT64_C(0xfdcb4fa002162a63), UINT64_C(0x73d9732fc7c8f7f6),  /* 118 */
+  UINT64_C(0x9e9f11c4014dda7e), UINT64_C(0x2867e7fddcdd9afa),  /* 119 */
+  UINT64_C(0xc646d63501a1511d), UINT64_C(0xb281e1fd541501b8),  /* 120 */
+  UINT64_C(0xf7d88bc24209a565), UINT64_C(0x1f225a7ca91a4226),  /* 121 */
+  UINT64_C(0x9ae757596946075f), UINT64_C(0x3375788de9b06958),  /* 122 */
+  UINT64_C(0xc1a12d2fc3978937), UINT64_C(0x0052d6b1641c83ae),  /* 123 */
+  UINT64_C(0xf209787bb47d6b84), UINT64_C(0xc0678c5dbd23a49a),  /* 124 */
+  UINT64_C(0x9745eb4d50ce6332), UINT64_C(0xf840b7ba963646e0),  /* 125 */
+  UINT64_C(0xbd176620a501fbff), UINT64_C(0xb650e5a93bc3d898),  /* 126 */
+  UINT64_C(0xec5d3fa8ce427aff), UINT64_C(0xa3e51f138ab4cebe),  /* 127 */
+  UINT64_C(0x93ba47c980e98cdf), UINT64_C(0xc66f336c36b10137),  /* 128 */
+  UINT64_C(0xb8a8d9bbe123f017), UINT64_C(0xb80b0047445d4184),  /* 129 */
+  UINT64_C(0xe6d3102ad96cec1d), UINT64_C(0xa60dc059157491e5),  /* 130 */
+  UINT64_C(0x9043ea1ac7e41392), UINT64_C(0x87c89837ad68db2f),  /* 131 */
+  UINT64_C(0xb454e4a179dd1877), UINT64_C(0x29babe4598c311fb),  /* 132 */
+  UINT64_C(0xe16a1dc9d8545e94), UINT64_C(0xf4296dd6fef3d67a),  /* 133 */
+  UINT64_C(0x8ce2529e2734bb1d), UINT64_C(0x1899e4a65f58660c),  /* 134 */
+  UINT64_C(0xb01ae745b101e9e4), UINT64_C(0x5ec05dcff72e7f8f),  /* 135 */
+  UINT64_C(0xdc21a1171d42645d), UINT64_C(0x76707543f4fa1f73),  /* 136 */
+  UINT64_C(0x899504ae72497eba), UINT64_C(0x6a06494a791c53a8),  /* 137 */
+  UINT64_C(0xabfa45da0edbde69), UINT64_C(0x0487db9d17636892),  /* 138 */
+  UINT64_C(0xd6f8d7509292d603), UINT64_C(0x45a9d2845d3c42b6),  /* 139 */
+  UINT64_C(0x865b86925b9bc5c2), UINT64_C(0x0b8a2392ba45a9b2),  /* 140 */
+  UINT64_C(0xa7f26836f282b732), UINT64_C(0x8e6cac7768d7141e),  /* 141 */
+  UINT64_C(0xd1ef0244af2364ff), UINT64_C(0x3207d795430cd926),  /* 142 */
+  UINT64_C(0x8335616aed761f1f), UINT64_C(0x7f44e6bd49e807b8),  /* 143 */
+  UINT64_C(0xa402b9c5a8d3a6e7), UINT64_C(0x5f16206c9c6209a6),  /* 144 */
+  UINT64_C(0xcd036837130890a1), UINT64_C(0x36dba887c37a8c0f),  /* 145 */
+  UINT64_C(0x802221226be55a64), UINT64_C(0xc2494954da2c9789),  /* 146 */
+  UINT64_C(0xa02aa96b06deb0fd), UINT64_C(0xf2db9baa10b7bd6c),  /* 147 */
+  UINT64_C(0xc83553c5c8965d3d), UINT64_C(0x6f92829494e5acc7),  /* 148 */
+  UINT64_C(0xfa42a8b73abbf48c), UINT64_C(0xcb772339ba1f17f9),  /* 149 */
+  UINT64_C(0x9c69a97284b578d7), UINT64_C(0xff2a760414536efb),  /* 150 */
+  UINT64_C(0xc38413cf25e2d70d), UINT64_C(0xfef5138519684aba),  /* 151 */
+  UINT64_C(0xf46518c2ef5b8cd1), UINT64_C(0x7eb258665fc25d69),  /* 152 */
+  UINT64_C(0x98bf2f79d5993802), UINT64_C(0xef2f773ffbd97a61),  /* 153 */
+  UINT64_C(0xbeeefb584aff8603), UINT64_C(0xaafb550ffacfd8fa),  /* 154 */
+  UINT64_C(0xeeaaba2e5dbf6784), UINT64_C(0x95ba2a53f983cf38),  /* 155 */
+  UINT64_C(0x952ab45cfa97a0b2), UINT64_C(0xdd945a747bf26183),  /* 156 */
+  UINT64_C(0xba756174393d88df), UINT64_C(0x94f971119aeef9e4),  /* 157 */
+  UINT64_C(0xe912b9d1478ceb17), UINT64_C(0x7a37cd5601aab85d),  /* 158 */
+  UINT64_C(0x91abb422ccb812ee), UINT64_C(0xac62e055c10ab33a),  /* 159 */
+  UINT64_C(0xb616a12b7fe617aa), UINT64_C(0x577b986b314d6009),  /* 160 */
+  UINT64_C(0xe39c49765fdf9d94), UINT64_C(0xed5a7e85fda0b80b),  /* 161 */
+  UINT64_C(0x8e41ade9fbebc27d), UINT64_C(0x14588f13be847307),  /* 162 */
+  UINT64_C(0xb1d219647ae6b31c), UINT64_C(0x596eb2d8ae258fc8),  /* 163 */
+  UINT64_C(0xde469fbd99a05fe3), UINT64_C(0x6fca5f8ed9aef3bb),  /* 164 */
+  UINT64_C(0x8aec23d680043bee), UINT64_C(0x25de7bb9480d5854),  /* 165 */
+  UINT64_C(0xada72ccc20054ae9), UINT64_C(0xaf561aa79a10ae6a),  /* 166 */
+  UINT64_C(0xd910f7ff28069da4), UINT64_C(0x1b2ba1518094da04),  /* 167 */
+  UINT64_C(0x87aa9aff79042286), UINT64_C(0x90fb44d2f05d0842),  /* 168 */
+  UINT64_C(0xa99541bf57452b28), UINT64_C(0x353a1607ac744a53),  /* 169 */
+  UINT64_C(0xd3fa922f2d1675f2), UINT64_C(0x42889b8997915ce8),  /* 170 */
+  UINT64_C(0x847c9b5d7c2e09b7), UINT64_C(0x69956135febada11),  /* 171 */
+  UINT64_C(0xa59bc234db398c25), UINT64_C(0x43fab9837e699095),  /* 172 */
+  UINT64_C(0xcf02b2c21207ef2e), UINT64_C(0x94f967e45e03f4bb),  /* 173 */
+  UINT64_C(0x8161afb94b44f57d), UINT64_C(0x1d1be0eebac278f5),  /* 174 */
+  UINT64_C(0xa1ba1ba79e1632dc), UINT64_C(0x6462d92a69731732),  /* 175 */
+  UINT64_C(0xca28a291859bbf93), UINT64_C(0x7d7b8f7503cfdcfe),  /* 176 */
+  UINT64_C(0xfcb2cb35e702af78), UINT64_C(0x5cda735244c3d43e),  /* 177 */
+  UINT64_C(0x9defbf01b061adab), UINT64_C(0x3a0888136afa64a7),  /* 178 */
+  UINT64_C(0xc56baec21c7a1916), UINT64_C(0x088aaa1845b8fdd0),  /* 179 */
+  UINT64_C(0xf6c69a72a3989f5b), UINT64_C(0x8aad549e57273d45),  /* 180 */
+  UINT64_C(0x9a3c2087a63f6399), UINT64_C(0x36ac54e2f678864b),  /* 181 */
+  UINT64_C(0xc0cb28a98fcf3c7f), UINT64_C(0x84576a1bb416a7dd),  /* 182 */
+  UINT64_C(0xf0fdf2d3f3c30b9f), UINT64_C(0x656d44a2a11c51d5),  /* 183 */
+  UINT64_C(0x969eb7c47859e743), UINT64_C(0x9f644ae5a4b1b325),  /* 184 */
+  UINT64_C(0xbc4665b596706114), UINT64_C(0x873d5d9f0dde1fee),  /* 185 */
+  UINT64_C(0xeb57ff22fc0c7959), UINT64_C(0xa90cb506d155a7ea),  /* 186 */
+  UINT64_C(0x9316ff75dd87cbd8), UINT64_C(0x09a7f12442d588f2),  /* 187 */
+  UINT64_C(0xb7dcbf5354e9bece), UINT64_C(0x0c11ed6d538aeb2f),  /* 188 */
+  UINT64_C(0xe5d3ef282a242e81), UINT64_C(0x8f1668c8a86da5fa),  /* 189 */
+  UINT64_C(0x8fa475791a569d10), UINT64_C(0xf96e017d694487bc),  /* 190 */
+  UINT64_C(0xb38d92d760ec4455), UINT64_C(0x37c981dcc395a9ac),  /* 191 */
+  UINT64_C(0xe070f78d3927556a), UINT64_C(0x85bbe253f47b1417),  /* 192 */
+  UINT64_C(0x8c469ab843b89562), UINT64_C(0x93956d7478ccec8e),  /* 193 */
+  UINT64_C(0xaf58416654a6babb), UINT64_C(0x387ac8d1970027b2),  /* 194 */
+  UINT64_C(0xdb2e51bfe9d0696a), UINT64_C(0x06997b05fcc0319e),  /* 195 */
+  UINT64_C(0x88fcf317f22241e2), UINT64_C(0x441fece3bdf81f03),  /* 196 */
+  UINT64_C(0xab3c2fddeeaad25a), UINT64_C(0xd527e81cad7626c3),  /* 197 */
+  UINT64_C(0xd60b3bd56a5586f1), UINT64_C(0x8a71e223d8d3b074),  /* 198 */
+  UINT64_C(0x85c7056562757456), UINT64_C(0xf6872d5667844e49),  /* 199 */
+  UINT64_C(0xa738c6bebb12d16c), UINT64_C(0xb428f8ac016561db),  /* 200 */
+  UINT64_C(0xd106f86e69d785c7), UINT64_C(0xe13336d701beba52),  /* 201 */
+  UINT64_C(0x82a45b450226b39c), UINT64_C(0xecc0024661173473),  /* 202 */
+  UINT64_C(0xa34d721642b06084), UINT64_C(0x27f002d7f95d0190),  /* 203 */
+  UINT64_C(0xcc20ce9bd35c78a5), UINT64_C(0x31ec038df7b441f4),  /* 204 */
+  UINT64_C(0xff290242c83396ce), UINT64_C(0x7e67047175a15271),  /* 205 */
+  UINT64_C(0x9f79a169bd203e41), UINT64_C(0x0f0062c6e984d386),  /* 206 */
+  UINT64_C(0xc75809c42c684dd1), UINT64_C(0x52c07b78a3e60868),  /* 207 */
+  UINT64_C(0xf92e0c3537826145), UINT64_C(0xa7709a56ccdf8a82),  /* 208 */
+  UINT64_C(0x9bbcc7a142b17ccb), UINT64_C(0x88a66076400bb691),  /* 209 */
+  UINT64_C(0xc2abf989935ddbfe), UINT64_C(0x6acff893d00ea435),  /* 210 */
+  UINT64_C(0xf356f7ebf83552fe), UINT64_C(0x0583f6b8c4124d43),  /* 211 */
+  UINT64_C(0x98165af37b2153de), UINT64_C(0xc3727a337a8b704a),  /* 212 */
+  UINT64_C(0xbe1bf1b059e9a8d6), UINT64_C(0x744f18c0592e4c5c),  /* 213 */
+  UINT64_C(0xeda2ee1c7064130c), UINT64_C(0x1162def06f79df73),  /* 214 */
+  UINT64_C(0x9485d4d1c63e8be7), UINT64_C(0x8addcb5645ac2ba8),  /* 215 */
+  UINT64_C(0xb9a74a0637ce2ee1), UINT64_C(0x6d953e2bd7173692),  /* 216 */
+  UINT64_C(0xe8111c87c5c1ba99), UINT64_C(0xc8fa8db6ccdd0437),  /* 217 */
+  UINT64_C(0x910ab1d4db9914a0), UINT64_C(0x1d9c9892400a22a2),  /* 218 */
+  UINT64_C(0xb54d5e4a127f59c8), UINT64_C(0x2503beb6d00cab4b),  /* 219 */
+  UINT64_C(0xe2a0b5dc971f303a), UINT64_C(0x2e44ae64840fd61d),  /* 220 */
+  UINT64_C(0x8da471a9de737e24), UINT64_C(0x5ceaecfed289e5d2),  /* 221 */
+  UINT64_C(0xb10d8e1456105dad), UINT64_C(0x7425a83e872c5f47),  /* 222 */
+  UINT64_C(0xdd50f1996b947518), UINT64_C(0xd12f124e28f77719),  /* 223 */
+  UINT64_C(0x8a5296ffe33cc92f), UINT64_C(0x82bd6b70d99aaa6f),  /* 224 */
+  UINT64_C(0xace73cbfdc0bfb7b), UINT64_C(0x636cc64d1001550b),  /* 225 */
+  UINT64_C(0xd8210befd30efa5a), UINT64_C(0x3c47f7e05401aa4e),  /* 226 */
+  UINT64_C(0x8714a775e3e95c78), UINT64_C(0x65acfaec34810a71),  /* 227 */
+  UINT64_C(0xa8d9d1535ce3b396), UINT64_C(0x7f1839a741a14d0d),  /* 228 */
+  UINT64_C(0xd31045a8341ca07c), UINT64_C(0x1ede48111209a050),  /* 229 */
+  UINT64_C(0x83ea2b892091e44d), UINT64_C(0x934aed0aab460432),  /* 230 */
+  UINT64_C(0xa4e4b66b68b65d60), UINT64_C(0xf81da84d5617853f),  /* 231 */
+  UINT64_C(0xce1de40642e3f4b9), UINT64_C(0x36251260ab9d668e),  /* 232 */
+  UINT64_C(0x80d2ae83e9ce78f3), UINT64_C(0xc1d72b7c6b426019),  /* 233 */
+  UINT64_C(0xa1075a24e4421730), UINT64_C(0xb24cf65b8612f81f),  /* 234 */
+  UINT64_C(0xc94930ae1d529cfc), UINT64_C(0xdee033f26797b627),  /* 235 */
+  UINT64_C(0xfb9b7cd9a4a7443c), UINT64_C(0x169840ef017da3b1),  /* 236 */
+  UINT64_C(0x9d412e0806e88aa5), UINT64_C(0x8e1f289560ee864e),  /* 237 */
+  UINT64_C(0xc491798a08a2ad4e), UINT64_C(0xf1a6f2bab92a27e2),  /* 238 */
+  UINT64_C(0xf5b5d7ec8acb58a2), UINT64_C(0xae10af696774b1db),  /* 239 */
+  UINT64_C(0x9991a6f3d6bf1765), UINT64_C(0xacca6da1e0a8ef29),  /* 240 */
+  UINT64_C(0xbff610b0cc6edd3f), UINT64_C(0x17fd090a58d32af3),  /* 241 */
+  UINT64_C(0xeff394dcff8a948e), UINT64_C(0xddfc4b4cef07f5b0),  /* 242 */
+  UINT64_C(0x95f83d0a1fb69cd9), UINT64_C(0x4abdaf101564f98e),  /* 243 */
+  UINT64_C(0xbb764c4ca7a4440f), UINT64_C(0x9d6d1ad41abe37f1),  /* 244 */
+  UINT64_C(0xea53df5fd18d5513), UINT64_C(0x84c86189216dc5ed),  /* 245 */
+  UINT64_C(0x92746b9be2f8552c), UINT64_C(0x32fd3cf5b4e49bb4),  /* 246 */
+  UINT64_C(0xb7118682dbb66a77), UINT64_C(0x3fbc8c33221dc2a1),  /* 247 */
+  UINT64_C(0xe4d5e82392a40515), UINT64_C(0x0fabaf3feaa5334a),  /* 248 */
+  UINT64_C(0x8f05b1163ba6832d), UINT64_C(0x29cb4d87f2a7400e),  /* 249 */
+  UINT64_C(0xb2c71d5bca9023f8), UINT64_C(0x743e20e9ef511012),  /* 250 */
+  UINT64_C(0xdf78e4b2bd342cf6), UINT64_C(0x914da9246b255416),  /* 251 */
+  UINT64_C(0x8bab8eefb6409c1a), UINT64_C(0x1ad089b6c2f7548e),  /* 252 */
+  UINT64_C(0xae9672aba3d0c320), UINT64_C(0xa184ac2473b529b1),  /* 253 */
+  UINT64_C(0xda3c0f568cc4f3e8), UINT64_C(0xc9e5d72d90a2741e),  /* 254 */
+  UINT64_C(0x8865899617fb1871), UINT64_C(0x7e2fa67c7a658892),  /* 255 */
+  UINT64_C(0xaa7eebfb9df9de8d), UINT64_C(0xddbb901b98feeab7),  /* 256 */
+  UINT64_C(0xd51ea6fa85785631), UINT64_C(0x552a74227f3ea565),  /* 257 */
+  UINT64_C(0x8533285c936b35de), UINT64_C(0xd53a88958f87275f),  /* 258 */
+  UINT64_C(0xa67ff273b8460356), UINT64_C(0x8a892abaf368f137),  /* 259 */
+  UINT64_C(0xd01fef10a657842c), UINT64_C(0x2d2b7569b0432d85),  /* 260 */
+  UINT64_C(0x8213f56a67f6b29b), UINT64_C(0x9c3b29620e29fc73),  /* 261 */
+  UINT64_C(0xa298f2c501f45f42), UINT64_C(0x8349f3ba91b47b8f),  /* 262 */
+  UINT64_C(0xcb3f2f7642717713), UINT64_C(0x241c70a936219a73),  /* 263 */
+  UINT64_C(0xfe0efb53d30dd4d7), UINT64_C(0xed238cd383aa0110),  /* 264 */
+  UINT64_C(0x9ec95d1463e8a506), UINT64_C(0xf4363804324a40aa),  /* 265 */
+  UINT64_C(0xc67bb4597ce2ce48), UINT64_C(0xb143c6053edcd0d5),  /* 266 */
+  UINT64_C(0xf81aa16fdc1b81da), UINT64_C(0xdd94b7868e94050a),  /* 267 */
+  UINT64_C(0x9b10a4e5e9913128), UINT64_C(0xca7cf2b4191c8326),  /* 268 */
+  UINT64_C(0xc1d4ce1f63f57d72), UINT64_C(0xfd1c2f611f63a3f0),  /* 269 */
+  UINT64_C(0xf24a01a73cf2dccf), UINT64_C(0xbc633b39673c8cec),  /* 270 */
+  UINT64_C(0x976e41088617ca01), UINT64_C(0xd5be0503e085d813),  /* 271 */
+  UINT64_C(0xbd49d14aa79dbc82), UINT64_C(0x4b2d8644d8a74e18),  /* 272 */
+  UINT64_C(0xec9c459d51852ba2), UINT64_C(0xddf8e7d60ed1219e),  /* 273 */
+  UINT64_C(0x93e1ab8252f33b45), UINT64_C(0xcabb90e5c942b503),  /* 274 */
+  UINT64_C(0xb8da1662e7b00a17), UINT64_C(0x3d6a751f3b936243),  /* 275 */
+  UINT64_C(0xe7109bfba19c0c9d), UINT64_C(0x0cc512670a783ad4),  /* 276 */
+  UINT64_C(0x906a617d450187e2), UINT64_C(0x27fb2b80668b24c5),  /* 277 */
+  UINT64_C(0xb484f9dc9641e9da), UINT64_C(0xb1f9f660802dedf6),  /* 278 */
+  UINT64_C(0xe1a63853bbd26451), UINT64_C(0x5e7873f8a0396973),  /* 279 */
+  UINT64_C(0x8d07e33455637eb2), UINT64_C(0xdb0b487b6423e1e8),  /* 280 */
+  UINT64_C(0xb049dc016abc5e5f), UINT64_C(0x91ce1a9a3d2cda62),  /* 281 */
+  UINT64_C(0xdc5c5301c56b75f7), UINT64_C(0x7641a140cc7810fb),  /* 282 */
+  UINT64_C(0x89b9b3e11b6329ba), UINT64_C(0xa9e904c87fcb0a9d),  /* 283 */
+  UINT64_C(0xac2820d9623bf429), UINT64_C(0x546345fa9fbdcd44),  /* 284 */
+  UINT64_C(0xd732290fbacaf133), UINT64_C(0xa97c177947ad4095),  /* 285 */
+  UINT64_C(0x867f59a9d4bed6c0), UINT64_C(0x49ed8eabcccc485d),  /* 286 */
+  UINT64_C(0xa81f301449ee8c70), UINT64_C(0x5c68f256bfff5a74),  /* 287 */
+  UINT64_C(0xd226fc195c6a2f8c), UINT64_C(0x73832eec6fff3111),  /* 288 */
+  UINT64_C(0x83585d8fd9c25db7), UINT64_C(0xc831fd53c5ff7eab),  /* 289 */
+  UINT64_C(0xa42e74f3d032f525), UINT64_C(0xba3e7ca8b77f5e55),  /* 290 */
+  UINT64_C(0xcd3a1230c43fb26f), UINT64_C(0x28ce1bd2e55f35eb),  /* 291 */
+  UINT64_C(0x80444b5e7aa7cf85), UINT64_C(0x7980d163cf5b81b3),  /* 292 */
+  UINT64_C(0xa0555e361951c366), UINT64_C(0xd7e105bcc332621f),  /* 293 */
+  UINT64_C(0xc86ab5c39fa63440), UINT64_C(0x8dd9472bf3fefaa7),  /* 294 */
+  UINT64_C(0xfa856334878fc150), UINT64_C(0xb14f98f6f0feb951),  /* 295 */
+  UINT64_C(0x9c935e00d4b9d8d2), UINT64_C(0x6ed1bf9a569f33d3),  /* 296 */
+  UINT64_C(0xc3b8358109e84f07), UINT64_C(0x0a862f80ec4700c8),  /* 297 */
+  UINT64_C(0xf4a642e14c6262c8), UINT64_C(0xcd27bb612758c0fa),  /* 298 */
+  UINT64_C(0x98e7e9cccfbd7dbd), UINT64_C(0x8038d51cb897789c),  /* 299 */
+  UINT64_C(0xbf21e44003acdd2c), UINT64_C(0xe0470a63e6bd56c3),  /* 300 */
+  UINT64_C(0xeeea5d5004981478), UINT64_C(0x1858ccfce06cac74),  /* 301 */
+  UINT64_C(0x95527a5202df0ccb), UINT64_C(0x0f37801e0c43ebc8),  /* 302 */
+  UINT64_C(0xbaa718e68396cffd), UINT64_C(0xd30560258f54e6ba),  /* 303 */
+  UINT64_C(0xe950df20247c83fd), UINT64_C(0x47c6b82ef32a2069),  /* 304 */
+  UINT64_C(0x91d28b7416cdd27e), UINT64_C(0x4cdc331d57fa5441),  /* 305 */
+  UINT64_C(0xb6472e511c81471d), UINT64_C(0xe0133fe4adf8e952),  /* 306 */
+  UINT64_C(0xe3d8f9e563a198e5), UINT64_C(0x58180fddd97723a6),  /* 307 */
+  UINT64_C(0x8e679c2f5e44ff8f), UINT64_C(0x570f09eaa7ea7648),  /* 308 */
+  UINT64_C(0xb201833b35d63f73), UINT64_C(0x2cd2cc6551e513da),  /* 309 */
+  UINT64_C(0xde81e40a034bcf4f), UINT64_C(0xf8077f7ea65e58d1),  /* 310 */
+  UINT64_C(0x8b112e86420f6191), UINT64_C(0xfb04afaf27faf782),  /* 311 */
+  UINT64_C(0xadd57a27d29339f6), UINT64_C(0x79c5db9af1f9b563),  /* 312 */
+  UINT64_C(0xd94ad8b1c7380874), UINT64_C(0x18375281ae7822bc),  /* 313 */
+  UINT64_C(0x87cec76f1c830548), UINT64_C(0x8f2293910d0b15b5),  /* 314 */
+  UINT64_C(0xa9c2794ae3a3c69a), UINT64_C(0xb2eb3875504ddb22),  /* 315 */
+  UINT64_C(0xd433179d9c8cb841), UINT64_C(0x5fa60692a46151eb),  /* 316 */
+  UINT64_C(0x849feec281d7f328), UINT64_C(0xdbc7c41ba6bcd333),  /* 317 */
+  UINT64_C(0xa5c7ea73224deff3), UINT64_C(0x12b9b522906c0800),  /* 318 */
+  UINT64_C(0xcf39e50feae16bef), UINT64_C(0xd768226b34870a00),  /* 319 */
+  UINT64_C(0x81842f29f2cce375), UINT64_C(0xe6a1158300d46640),  /* 320 */
+  UINT64_C(0xa1e53af46f801c53), UINT64_C(0x60495ae3c1097fd0),  /* 321 */
+  UINT64_C(0xca5e89b18b602368), UINT64_C(0x385bb19cb14bdfc4),  /* 322 */
+  UINT64_C(0xfcf62c1dee382c42), UINT64_C(0x46729e03dd9ed7b5),  /* 323 */
+  UINT64_C(0x9e19db92b4e31ba9), UINT64_C(0x6c07a2c26a8346d1)   /* 324 */
+};
+
+/*
+ * Exact double values of the powers of ten from 10^0 to 10^22.
+ */
+static const double aks_dbl_exact10[23] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+  1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+  1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/*
+ * Powers of five that fit in 32 bits, from 5^0 to 5^13.
+ */
+static const uint32_t aks_dbl_pow5_32[14] = {
+  1UL, 5UL, 25UL, 125UL, 625UL, 3125UL, 15625UL, 78125UL, 390625UL,
+  1953125UL, 9765625UL, 48828125UL, 244140625UL, 1220703125UL
+};
+
+/*
+ * Compute floor(e * log2(10)) for e in range [-1233, 1233].
+ */
+#define aks_dbl_flog2pow10(e) (((e) * 1741647) >> 19)
+
+/*
+ * Multiply two 64-bit integers to a 128-bit product.
+ * 
+ * Parameters:
+ * 
+ *   a - the first factor
+ * 
+ *   b - the second factor
+ * 
+ *   pHi - receives the high 64 bits of the product
+ * 
+ *   pLo - receives the low 64 bits of the product
+ */
+AKS_INTERNAL void aks_dbl_mul128(
+    uint64_t   a,
+    uint64_t   b,
+    uint64_t * pHi,
+    uint64_t * pLo) {
+#ifdef __SIZEOF_INT128__
+  __extension__ typedef unsigned __int128 aks_dbl_u128;
+  aks_dbl_u128 r = 0;
+  
+  r = ((aks_dbl_u128) a) * b;
+  *pHi = (uint64_t) (r >> 64);
+  *pLo = (uint64_t) r;
+  
+#else
+#ifdef AKS_DBL_MSVC64
+  *pLo = _umul128(a, b, pHi);
+  
+#else
+  uint64_t p00 = 0;
+  uint64_t p01 = 0;
+  uint64_t p10 = 0;
+  uint64_t p11 = 0;
+  uint64_t mid = 0;
+  
+  /* Schoolbook multiplication on 32-bit halves */
+  p00 = (a & 0xffffffffUL) * (b & 0xffffffffUL);
+  p01 = (a & 0xffffffffUL) * (b >> 32);
+  p10 = (a >> 32) * (b & 0xffffffffUL);
+  p11 = (a >> 32) * (b >> 32);
+  
+  mid = (p00 >> 32) + (p01 & 0xffffffffUL) + (p10 & 0xffffffffUL);
+  *pLo = (mid << 32) | (p00 & 0xffffffffUL);
+  *pHi = p11 + (p01 >> 32) + (p10 >> 32) + (mid >> 32);
+#endif
+#endif
+}
+
+/*
+ * Count the leading zero bits in a non-zero 64-bit integer.
+ * 
+ * Parameters:
+ * 
+ *   v - the value, which must not be zero
+ * 
+ * Return:
+ * 
+ *   the number of leading zero bits
+ */
+AKS_INTERNAL int aks_dbl_clz64(uint64_t v) {
+#ifdef __GNUC__
+  return __builtin_clzll(v);
+#else
+  int n = 0;
+  
+  /* Binary search for the highest set bit */
+  if (!(v >> 32)) { n += 32; v <<= 32; }
+  if (!(v >> 48)) { n += 16; v <<= 16; }
+  if (!(v >> 56)) { n +=  8; v <<=  8; }
+  if (!(v >> 60)) { n +=  4; v <<=  4; }
+  if (!(v >> 62)) { n +=  2; v <<=  2; }
+  if (!(v >> 63)) { n +=  1; }
+  
+  return n;
+#endif
+}
+
+/*
+ * Multiply a 64-bit integer by a 128-bit power-of-ten significand,
+ * keeping the high 64 bits of the 192-bit product and rounding to odd
+ * with the rest.
+ * 
+ * Parameters:
+ * 
+ *   gHi - the high word of the 128-bit significand
+ * 
+ *   gLo - the low word of the 128-bit significand
+ * 
+ *   cp - the 64-bit factor
+ * 
+ * Return:
+ * 
+ *   the product, rounded to odd
+ */
+AKS_INTERNAL uint64_t aks_dbl_rto(uint64_t gHi, uint64_t gLo, uint64_t cp) {
+  
+  uint64_t xh = 0;
+  uint64_t xl = 0;
+  uint64_t yh = 0;
+  uint64_t yl = 0;
+  
+  aks_dbl_mul128(gLo, cp, &xh, &xl);
+  aks_dbl_mul128(gHi, cp, &yh, &yl);
+  
+  /* Add the high word of the low product into the high product */
+  yl += xh;
+  if (yl < xh) {
+    yh++;
+  }
+  
+  return yh | (uint64_t) (yl > 1);
+}
+
+/*
+ * Format a double as the shortest decimal string that parses back to
+ * exactly the same value.
+ * 
+ * The digits are found with the Schubfach algorithm, which needs only
+ * 64-bit integer arithmetic and one table lookup.  When more than one
+ * shortest string round-trips, the one closest to the exact binary
+ * value is chosen.
+ * 
+ * The layout is the same as printf "%.17g" would choose, but with the
+ * shortest digits:  plain decimal notation when the decimal exponent is
+ * in range [-4, 16], otherwise scientific notation with at least two
+ * exponent digits.  There is no trailing decimal point and there are no
+ * trailing zeros after the decimal point.  Infinities are written as
+ * "inf" or "-inf", NaN as "nan", and negative zero as "-0".  No locale
+ * settings are consulted.
+ * 
+ * The buffer must have room for at least AKS_FMT_DBL_BUFSIZE bytes.
+ * The result is nul-terminated.
+ * 
+ * Parameters:
+ * 
+ *   pBuf - the buffer to write the string into
+ * 
+ *   d - the value to format
+ * 
+ * Return:
+ * 
+ *   the number of characters written, not including the nul
+ */
+AKS_API size_t aks_fmt_double(char *pBuf, double d) {
+  
+  char dig[AKS_FMT_INT_BUFSIZE];
+  uint64_t bits = 0;
+  uint64_t c = 0;
+  uint64_t gHi = 0;
+  uint64_t gLo = 0;
+  uint64_t vbl = 0;
+  uint64_t vb = 0;
+  uint64_t vbr = 0;
+  uint64_t lower = 0;
+  uint64_t upper = 0;
+  uint64_t s = 0;
+  uint64_t sp = 0;
+  uint64_t f = 0;
+  int be = 0;
+  int q = 0;
+  int k = 0;
+  int h = 0;
+  int closer = 0;
+  int odd = 0;
+  int found = 0;
+  int dexp = 0;
+  int nd = 0;
+  int x = 0;
+  int i = 0;
+  size_t len = 0;
+  
+  /* Get the sign, biased exponent, and stored significand */
+  memcpy(&bits, &d, sizeof(double));
+  be = (int) ((bits >> 52) & 0x7ff);
+  c = bits & ((((uint64_t) 1) << 52) - 1);
+  
+  /* Handle NaN, then write the sign */
+  if ((be == 0x7ff) && (c != 0)) {
+    strcpy(pBuf, "nan");
+    return 3;
+  }
+  if (bits >> 63) {
+    pBuf[len++] = '-';
+  }
+  
+  /* Handle infinity and zero */
+  if (be == 0x7ff) {
+    strcpy(pBuf + len, "inf");
+    return len + 3;
+  }
+  if ((be == 0) && (c == 0)) {
+    strcpy(pBuf + len, "0");
+    return len + 1;
+  }
+  
+  /* Get the value as c * 2^q; the lower neighbor is closer than the
+   * upper neighbor when c is a power of two above the subnormals */
+  closer = ((c == 0) && (be > 1));
+  if (be != 0) {
+    c |= ((uint64_t) 1) << 52;
+    q = be - 1075;
+  } else {
+    q = -1074;
+  }
+  odd = (int) (c & 1);
+  
+  /* Choose the decimal exponent k and look up 10^-k; the formatter
+   * wants the truncated significand plus one, which is the table entry
+   * itself for exponents in range [-27, -1] */
+  k = (q * 1262611 - (closer ? 524031 : 0)) >> 22;
+  h = q + aks_dbl_flog2pow10(-k) + 1;
+  gHi = aks_dbl_pow10[(-k - AKS_DBL_POW10_MIN) * 2];
+  gLo = aks_dbl_pow10[(-k - AKS_DBL_POW10_MIN) * 2 + 1];
+  if ((-k >= 0) || (-k < -27)) {
+    gLo++;
+    if (gLo == 0) {
+      gHi++;
+    }
+  }
+  
+  /* Scale the value and the bounds of its rounding interval, all
+   * multiplied by four */
+  vbl = aks_dbl_rto(gHi, gLo, (4 * c - 2 + (uint64_t) closer) << h);
+  vb  = aks_dbl_rto(gHi, gLo, (4 * c) << h);
+  vbr = aks_dbl_rto(gHi, gLo, (4 * c + 2) << h);
+  
+  /* The interval bounds are included only when c is even */
+  lower = vbl + (uint64_t) odd;
+  upper = vbr - (uint64_t) odd;
+  
+  /* Try one digit less than the scaled value first */
+  s = vb / 4;
+  if (s >= 10) {
+    sp = s / 10;
+    if ((lower <= 40 * sp) != (40 * sp + 40 <= upper)) {
+      f = sp + (uint64_t) (40 * sp + 40 <= upper);
+      dexp = k + 1;
+      found = 1;
+    }
+  }
+  
+  /* Otherwise choose between s and s + 1, rounding to nearest and then
+   * to even */
+  if (!found) {
+    dexp = k;
+    if ((lower <= 4 * s) != (4 * s + 4 <= upper)) {
+      f = s + (uint64_t) (4 * s + 4 <= upper);
+    } else if ((vb > 4 * s + 2) || ((vb == 4 * s + 2) && (s & 1))) {
+      f = s + 1;
+    } else {
+      f = s;
+    }
+  }
+  
+  /* Remove trailing zeros and get the digit string */
+  while (f % 10 == 0) {
+    f /= 10;
+    dexp++;
+  }
+  nd = (int) aks_fmt_u64(dig, f);
+  
+  /* Determine the exponent of the leading digit and lay out the
+   * number */
+  x = dexp + nd - 1;
+  if ((x >= -4) && (x < 17)) {
+    if (x < 0) {
+      /* Leading zeros after the decimal point */
+      pBuf[len++] = '0';
+      pBuf[len++] = '.';
+      for(i = -1; i > x; i--) {
+        pBuf[len++] = '0';
+      }
+      memcpy(pBuf + len, dig, (size_t) nd);
+      len += (size_t) nd;
+      
+    } else if (x >= nd - 1) {
+      /* Integer with possible trailing zeros */
+      memcpy(pBuf + len, dig, (size_t) nd);
+      len += (size_t) nd;
+      for(i = nd - 1; i < x; i++) {
+        pBuf[len++] = '0';
+      }
+      
+    } else {
+      /* Decimal point within the digits */
+      memcpy(pBuf + len, dig, (size_t) (x + 1));
+      len += (size_t) (x + 1);
+      pBuf[len++] = '.';
+      memcpy(pBuf + len, dig + x + 1, (size_t) (nd - x - 1));
+      len += (size_t) (nd - x - 1);
+    }
+    
+  } else {
+    /* Scientific notation */
+    pBuf[len++] = dig[0];
+    if (nd > 1) {
+      pBuf[len++] = '.';
+      memcpy(pBuf + len, dig + 1, (size_t) (nd - 1));
+      len += (size_t) (nd - 1);
+    }
+    pBuf[len++] = 'e';
+    if (x < 0) {
+      pBuf[len++] = '-';
+      x = -x;
+    } else {
+      pBuf[len++] = '+';
+    }
+    if (x < 10) {
+      pBuf[len++] = '0';
+    }
+    len += aks_fmt_u64(pBuf + len, (uint64_t) x);
+    return len;
+  }
+  
+  /* Terminate and return length */
+  pBuf[len] = (char) 0;
+  return len;
+}
+
+/*
+ * Compute the IEEE bits of a positive double from a decimal
+ * significand and exponent with the Eisel-Lemire algorithm.
+ * 
+ * The significand must have at most 19 digits.  This fails in rare
+ * cases where the 128-bit table precision cannot decide the rounding,
+ * and the caller must then fall back to exact arithmetic.
+ * 
+ * Parameters:
+ * 
+ *   w - the decimal significand
+ * 
+ *   q - the decimal exponent
+ * 
+ *   pBits - receives the IEEE bits of w * 10^q, rounded to nearest even
+ * 
+ * Return:
+ * 
+ *   non-zero if successful, zero if the fallback is needed
+ */
+AKS_INTERNAL int aks_dbl_lemire(uint64_t w, int q, uint64_t *pBits) {
+  
+  uint64_t hi = 0;
+  uint64_t lo = 0;
+  uint64_t hi2 = 0;
+  uint64_t lo2 = 0;
+  uint64_t m = 0;
+  int lz = 0;
+  int upper = 0;
+  int shift = 0;
+  int p2 = 0;
+  
+  /* Handle zero, and the exponents beyond the table */
+  if ((w == 0) || (q < AKS_DBL_POW10_MIN)) {
+    *pBits = 0;
+    return 1;
+  }
+  if (q > 308) {
+    *pBits = ((uint64_t) 0x7ff) << 52;
+    return 1;
+  }
+  
+  /* Normalize w and multiply by the power of ten; only use the low
+   * table word when the high product is too close to call */
+  lz = aks_dbl_clz64(w);
+  w <<= lz;
+  aks_dbl_mul128(w, aks_dbl_pow10[(q - AKS_DBL_POW10_MIN) * 2], &hi, &lo);
+  if ((hi & 0x1ff) == 0x1ff) {
+    aks_dbl_mul128(
+      w, aks_dbl_pow10[(q - AKS_DBL_POW10_MIN) * 2 + 1], &hi2, &lo2);
+    lo += hi2;
+    if (hi2 > lo) {
+      hi++;
+    }
+  }
+  
+  /* Outside the range where the table is exact, a product that might
+   * have carried cannot be decided */
+  if ((lo == UINT64_MAX) && ((q < -27) || (q > 55))) {
+    return 0;
+  }
+  
+  /* Keep 54 bits and compute the biased binary exponent */
+  upper = (int) (hi >> 63);
+  shift = upper + 9;
+  m = hi >> shift;
+  p2 = aks_dbl_flog2pow10(q) + 63 + upper - lz + 1023;
+  
+  /* Subnormal results; ties cannot occur this far from zero */
+  if (p2 <= 0) {
+    if (-p2 + 1 >= 64) {
+      *pBits = 0;
+      return 1;
+    }
+    m >>= -p2 + 1;
+    m += m & 1;
+    m >>= 1;
+    *pBits = m;
+    return 1;
+  }
+  
+  /* If the product is exactly halfway, round to even rather than up */
+  if ((lo <= 1) && (q >= -4) && (q <= 23) && ((m & 3) == 1)) {
+    if ((m << shift) == hi) {
+      m &= ~((uint64_t) 1);
+    }
+  }
+  
+  /* Round and renormalize */
+  m += m & 1;
+  m >>= 1;
+  if (m >= (((uint64_t) 2) << 52)) {
+    m = ((uint64_t) 1) << 52;
+    p2++;
+  }
+  m &= ~(((uint64_t) 1) << 52);
+  
+  /* Overflow to infinity */
+  if (p2 >= 0x7ff) {
+    *pBits = ((uint64_t) 0x7ff) << 52;
+    return 1;
+  }
+  
+  *pBits = m | (((uint64_t) p2) << 52);
+  return 1;
+}
+
+/*
+ * Big integer used for exact parsing.
+ * 
+ * This is large enough for 769 decimal digits scaled by any power of
+ * five needed to reach the subnormal range, plus 64 bits.
+ */
+#define AKS_DBL_BIG_WORDS 90
+
+typedef struct {
+  uint32_t w[AKS_DBL_BIG_WORDS];
+  int n;
+} aks_dbl_big;
+
+/*
+ * Multiply a big integer by a 32-bit value and add a 32-bit value.
+ */
+AKS_INTERNAL void aks_dbl_big_muladd(aks_dbl_big *pb, uint32_t m, uint32_t a) {
+  
+  uint64_t carry = a;
+  int i = 0;
+  
+  for(i = 0; i < pb->n; i++) {
+    carry += ((uint64_t) pb->w[i]) * m;
+    pb->w[i] = (uint32_t) carry;
+    carry >>= 32;
+  }
+  if (carry) {
+    pb->w[pb->n++] = (uint32_t) carry;
+  }
+}
+
+/*
+ * Multiply a big integer by 5^n.
+ */
+AKS_INTERNAL void aks_dbl_big_mulpow5(aks_dbl_big *pb, int n) {
+  for( ; n >= 13; n -= 13) {
+    aks_dbl_big_muladd(pb, aks_dbl_pow5_32[13], 0);
+  }
+  if (n > 0) {
+    aks_dbl_big_muladd(pb, aks_dbl_pow5_32[n], 0);
+  }
+}
+
+/*
+ * Get the number of significant bits in a big integer.
+ */
+AKS_INTERNAL int aks_dbl_big_bitlen(const aks_dbl_big *pb) {
+  
+  uint32_t top = 0;
+  int len = 0;
+  
+  if (pb->n < 1) {
+    return 0;
+  }
+  
+  len = (pb->n - 1) * 32;
+  for(top = pb->w[pb->n - 1]; top != 0; top >>= 1) {
+    len++;
+  }
+  return len;
+}
+
+/*
+ * Shift a big integer left by a number of bits.
+ */
+AKS_INTERNAL void aks_dbl_big_shl(aks_dbl_big *pb, int bits) {
+  
+  int words = bits / 32;
+  int r = bits % 32;
+  int i = 0;
+  
+  if ((pb->n < 1) || (bits < 1)) {
+    return;
+  }
+  
+  /* Shift bits within words, from the top down */
+  if (r) {
+    pb->w[pb->n] = 0;
+    for(i = pb->n; i > 0; i--) {
+      pb->w[i] = (pb->w[i] << r) | (pb->w[i - 1] >> (32 - r));
+    }
+    pb->w[0] <<= r;
+    if (pb->w[pb->n]) {
+      pb->n++;
+    }
+  }
+  
+  /* Shift whole words */
+  if (words) {
+    for(i = pb->n - 1; i >= 0; i--) {
+      pb->w[i + words] = pb->w[i];
+    }
+    for(i = 0; i < words; i++) {
+      pb->w[i] = 0;
+    }
+    pb->n += words;
+  }
+}
+
+/*
+ * Shift a big integer right by one bit.
+ */
+AKS_INTERNAL void aks_dbl_big_shr1(aks_dbl_big *pb) {
+  
+  int i = 0;
+  
+  for(i = 0; i < pb->n - 1; i++) {
+    pb->w[i] = (pb->w[i] >> 1) | (pb->w[i + 1] << 31);
+  }
+  if (pb->n > 0) {
+    pb->w[pb->n - 1] >>= 1;
+    if (pb->w[pb->n - 1] == 0) {
+      pb->n--;
+    }
+  }
+}
+
+/*
+ * Compare two big integers, returning less than, equal to, or greater
+ * than zero.
+ */
+AKS_INTERNAL int aks_dbl_big_cmp(const aks_dbl_big *pa, const aks_dbl_big *pb) {
+  
+  int i = 0;
+  
+  if (pa->n != pb->n) {
+    return (pa->n < pb->n) ? -1 : 1;
+  }
+  for(i = pa->n - 1; i >= 0; i--) {
+    if (pa->w[i] != pb->w[i]) {
+      return (pa->w[i] < pb->w[i]) ? -1 : 1;
+    }
+  }
+  return 0;
+}
+
+/*
+ * Subtract a big integer from another that is not smaller.
+ */
+AKS_INTERNAL void aks_dbl_big_sub(aks_dbl_big *pa, const aks_dbl_big *pb) {
+  
+  uint64_t borrow = 0;
+  uint64_t t = 0;
+  int i = 0;
+  
+  for(i = 0; i < pa->n; i++) {
+    t = ((uint64_t) pa->w[i]) - (i < pb->n ? pb->w[i] : 0) - borrow;
+    pa->w[i] = (uint32_t) t;
+    borrow = (t >> 32) & 1;
+  }
+  while ((pa->n > 0) && (pa->w[pa->n - 1] == 0)) {
+    pa->n--;
+  }
+}
+
+/*
+ * Round m * 2^e2 to the nearest double, ties to even.
+ * 
+ * If sticky is non-zero, the true value is slightly greater than
+ * m * 2^e2 (but less than (m + 1) * 2^e2), which is used to break
+ * ties.
+ * 
+ * Parameters:
+ * 
+ *   m - the binary significand, which must not be zero
+ * 
+ *   e2 - the binary exponent
+ * 
+ *   sticky - non-zero if there were discarded non-zero bits
+ * 
+ * Return:
+ * 
+ *   the IEEE bits of the positive result
+ */
+AKS_INTERNAL uint64_t aks_dbl_round(uint64_t m, int e2, int sticky) {
+  
+  uint64_t rem = 0;
+  uint64_t half = 0;
+  int sh = 0;
+  
+  /* Drop enough bits to leave 53, or fewer in the subnormal range */
+  sh = (64 - aks_dbl_clz64(m)) - 53;
+  if (e2 + sh < -1074) {
+    sh = -1074 - e2;
+  }
+  
+  if (sh <= 0) {
+    /* Exact */
+    m <<= -sh;
+    
+  } else if (sh > 64) {
+    /* Less than half of the smallest subnormal */
+    return 0;
+    
+  } else {
+    /* Round to nearest, ties to even */
+    if (sh == 64) {
+      rem = m;
+      m = 0;
+    } else {
+      rem = m & ((((uint64_t) 1) << sh) - 1);
+      m >>= sh;
+    }
+    half = ((uint64_t) 1) << (sh - 1);
+    if ((rem > half) || ((rem == half) && (sticky || (m & 1)))) {
+      m++;
+    }
+  }
+  e2 += sh;
+  
+  /* Renormalize after a carry */
+  if (m >> 53) {
+    m >>= 1;
+    e2++;
+  }
+  
+  /* Subnormals and the smallest normals have the same layout */
+  if (m < (((uint64_t) 1) << 52)) {
+    return m;
+  }
+  if (e2 + 1075 >= 0x7ff) {
+    return ((uint64_t) 0x7ff) << 52;
+  }
+  return (((uint64_t) (e2 + 1075)) << 52) |
+            (m & ((((uint64_t) 1) << 52) - 1));
+}
+
+/*
+ * Compute the IEEE bits of a positive double from decimal digits with
+ * exact big integer arithmetic.
+ * 
+ * The digits are the mantissa characters from the input, which may
+ * include a decimal point.  The value is the digits read as an integer,
+ * ignoring the decimal point, times 10^e.  Only the first 768
+ * significant digits are used exactly; any further non-zero digits are
+ * represented by a single trailing 1, which is enough to decide every
+ * rounding since halfway points between doubles never need more than
+ * 767 significant digits.
+ * 
+ * Parameters:
+ * 
+ *   pDig - the mantissa characters
+ * 
+ *   len - the number of mantissa characters
+ * 
+ *   e - the decimal exponent of the last character
+ * 
+ * Return:
+ * 
+ *   the IEEE bits of the result, rounded to nearest even
+ */
+AKS_INTERNAL uint64_t aks_dbl_slow(const char *pDig, size_t len, long e) {
+  
+  aks_dbl_big num;
+  aks_dbl_big den;
+  uint64_t m = 0;
+  uint32_t chunk = 0;
+  uint32_t mul = 1;
+  size_t i = 0;
+  int kept = 0;
+  int sticky = 0;
+  int n = 0;
+  int s = 0;
+  int b = 0;
+  int w = 0;
+  
+  num.n = 0;
+  den.n = 0;
+  
+  /* Accumulate significant digits nine at a time */
+  for(i = 0; i < len; i++) {
+    if (pDig[i] == '.') {
+      continue;
+    }
+    if ((kept == 0) && (pDig[i] == '0')) {
+      continue;
+    }
+    if (kept < 768) {
+      chunk = chunk * 10 + (uint32_t) (pDig[i] - '0');
+      mul *= 10;
+      kept++;
+      if (mul == 1000000000UL) {
+        aks_dbl_big_muladd(&num, mul, chunk);
+        chunk = 0;
+        mul = 1;
+      }
+    } else {
+      e++;
+      if (pDig[i] != '0') {
+        sticky = 1;
+      }
+    }
+  }
+  if (sticky) {
+    chunk = chunk * 10 + 1;
+    mul *= 10;
+    e--;
+  }
+  if (mul > 1) {
+    aks_dbl_big_muladd(&num, mul, chunk);
+  }
+  if (num.n < 1) {
+    return 0;
+  }
+  
+  if (e >= 0) {
+    /* Integer value; multiply in the power of ten and take the top 64
+     * bits */
+    aks_dbl_big_mulpow5(&num, (int) e);
+    b = aks_dbl_big_bitlen(&num);
+    s = (b > 64) ? (b - 64) : 0;
+    
+    sticky = 0;
+    for(w = 0; w < s / 32; w++) {
+      if (num.w[w]) {
+        sticky = 1;
+      }
+    }
+    if ((s % 32) && (num.w[s / 32] & ((((uint32_t) 1) << (s % 32)) - 1))) {
+      sticky = 1;
+    }
+    
+    for(n = b - 1; n >= s; n--) {
+      m = (m << 1) | ((num.w[n / 32] >> (n % 32)) & 1);
+    }
+    return aks_dbl_round(m, (int) e + s, sticky);
+  }
+  
+  /* Fractional value; divide by the power of five with 63 or 64 bits of
+   * quotient, and account for the power of two in the exponent */
+  n = (int) -e;
+  den.w[0] = 1;
+  den.n = 1;
+  aks_dbl_big_mulpow5(&den, n);
+  
+  s = 63 - aks_dbl_big_bitlen(&num) + aks_dbl_big_bitlen(&den);
+  if (s >= 0) {
+    aks_dbl_big_shl(&num, s);
+  } else {
+    aks_dbl_big_shl(&den, -s);
+  }
+  
+  /* Restoring long division, one quotient bit at a time */
+  aks_dbl_big_shl(&den, 63);
+  for(b = 63; b >= 0; b--) {
+    if (aks_dbl_big_cmp(&num, &den) >= 0) {
+      aks_dbl_big_sub(&num, &den);
+      m |= ((uint64_t) 1) << b;
+    }
+    aks_dbl_big_shr1(&den);
+  }
+  
+  return aks_dbl_round(m, -n - s, (num.n > 0));
+}
+
+/*
+ * Check whether the characters at the start of a string match a
+ * lowercase US-ASCII keyword, ignoring case.
+ */
+AKS_INTERNAL int aks_dbl_keyword(
+    const char * pStr,
+    size_t       len,
+    const char * pKey) {
+  
+  size_t i = 0;
+  
+  for(i = 0; pKey[i] != 0; i++) {
+    if ((i >= len) || ((pStr[i] | 0x20) != pKey[i])) {
+      return 0;
+    }
+  }
+  return (i == len);
+}
+
+/*
+ * Parse a decimal floating-point number into a double, correctly
+ * rounded to nearest with ties to even.
+ * 
+ * The input is an optional "+" or "-" sign, followed by digits with an
+ * optional decimal point (with at least one digit on either side of
+ * it), followed by an optional exponent consisting of "e" or "E", an
+ * optional sign, and one or more digits.  The words "inf", "infinity",
+ * and "nan" in any case are also accepted after the optional sign.  No
+ * whitespace is accepted.  The input does not need to be
+ * nul-terminated.  No locale settings are consulted; the decimal point
+ * is always a period.
+ * 
+ * Most inputs are converted with the exact-power fast path or with the
+ * Eisel-Lemire algorithm.  The rest fall back to exact big integer
+ * arithmetic, so every result is correctly rounded.
+ * 
+ * If the value is too large for a double, *pv is set to an infinity
+ * and ERANGE is returned.  If a non-zero value is too small, *pv is
+ * set to a zero and ERANGE is returned.  On syntax error, *pv is not
+ * modified.
+ * 
+ * Parameters:
+ * 
+ *   pStr - the characters to parse
+ * 
+ *   len - the number of characters
+ * 
+ *   pv - receives the parsed value
+ * 
+ * Return:
+ * 
+ *   zero if successful, EINVAL if the input is not a number, or ERANGE
+ *   if the value overflowed or underflowed
+ */
+AKS_API int aks_parse_double(const char *pStr, size_t len, double *pv) {
+  
+  uint64_t w = 0;
+  uint64_t bits = 0;
+  uint64_t bits2 = 0;
+  size_t i = 0;
+  size_t mstart = 0;
+  size_t mend = 0;
+  long fracd = 0;
+  long dropped = 0;
+  long ex = 0;
+  long q = 0;
+  int neg = 0;
+  int eneg = 0;
+  int nsig = 0;
+  int ndig = 0;
+  int trunc = 0;
+  int dot = 0;
+  int done = 0;
+  int d = 0;
+  
+  /* Handle the sign */
+  if (len > 0) {
+    if (pStr[0] == '-') {
+      neg = 1;
+      i++;
+    } else if (pStr[0] == '+') {
+      i++;
+    }
+  }
+  
+  /* Handle infinity and NaN */
+  if (aks_dbl_keyword(pStr + i, len - i, "inf") ||
+        aks_dbl_keyword(pStr + i, len - i, "infinity")) {
+    bits = ((uint64_t) 0x7ff) << 52;
+    done = 1;
+  } else if (aks_dbl_keyword(pStr + i, len - i, "nan")) {
+    bits = (((uint64_t) 0x7ff) << 52) | (((uint64_t) 1) << 51);
+    done = 1;
+  }
+  if (done) {
+    bits |= ((uint64_t) neg) << 63;
+    memcpy(pv, &bits, sizeof(double));
+    return 0;
+  }
+  
+  /* Scan the mantissa, keeping the first 19 significant digits in w */
+  mstart = i;
+  for( ; i < len; i++) {
+    if ((pStr[i] == '.') && (!dot)) {
+      dot = 1;
+      continue;
+    }
+    d = (int) ((unsigned char) pStr[i]) - '0';
+    if ((d < 0) || (d > 9)) {
+      break;
+    }
+    ndig++;
+    if (dot) {
+      fracd++;
+    }
+    if ((nsig > 0) || (d != 0)) {
+      if (nsig < 19) {
+        w = w * 10 + (uint64_t) d;
+      } else {
+        dropped++;
+        if (d != 0) {
+          trunc = 1;
+        }
+      }
+      nsig++;
+    }
+  }
+  mend = i;
+  if (ndig < 1) {
+    return EINVAL;
+  }
+  
+  /* Scan the exponent, clamping it well beyond the double range */
+  if ((i < len) && ((pStr[i] == 'e') || (pStr[i] == 'E'))) {
+    i++;
+    if ((i < len) && ((pStr[i] == '-') || (pStr[i] == '+'))) {
+      eneg = (pStr[i] == '-');
+      i++;
+    }
+    if (i >= len) {
+      return EINVAL;
+    }
+    for( ; i < len; i++) {
+      d = (int) ((unsigned char) pStr[i]) - '0';
+      if ((d < 0) || (d > 9)) {
+        return EINVAL;
+      }
+      if (ex < 100000L) {
+        ex = ex * 10 + d;
+      }
+    }
+    if (eneg) {
+      ex = -ex;
+    }
+  }
+  if (i != len) {
+    return EINVAL;
+  }
+  
+  /* The value is w * 10^q, possibly with truncated digits */
+  q = ex - fracd + dropped;
+  
+  if (w == 0) {
+    /* Zero */
+    bits = 0;
+    
+  } else if (q + (nsig < 19 ? nsig : 19) - 1 > 309) {
+    /* Leading digit beyond the largest double */
+    bits = ((uint64_t) 0x7ff) << 52;
+    
+  } else if (q + (nsig < 19 ? nsig : 19) - 1 < -325) {
+    /* Less than half of the smallest subnormal */
+    bits = 0;
+    
+  } else {
+#ifdef FLT_EVAL_METHOD
+#if (FLT_EVAL_METHOD == 0)
+    /* Both w and 10^|q| are exact doubles, so a single correctly
+     * rounded operation gives the result */
+    if ((!trunc) && (w <= (((uint64_t) 1) << 53)) &&
+          (q >= -22) && (q <= 22)) {
+      double r = 0.0;
+      
+      r = (double) w;
+      if (q < 0) {
+        r = r / aks_dbl_exact10[-q];
+      } else {
+        r = r * aks_dbl_exact10[q];
+      }
+      memcpy(&bits, &r, sizeof(double));
+      done = 1;
+    }
+#endif
+#endif
+    
+    /* Eisel-Lemire; with truncated digits, the result is only known if
+     * rounding w and w + 1 agree */
+    if (!done) {
+      if (aks_dbl_lemire(w, (int) q, &bits)) {
+        if (!trunc) {
+          done = 1;
+        } else if (aks_dbl_lemire(w + 1, (int) q, &bits2)) {
+          done = (bits == bits2);
+        }
+      }
+    }
+    
+    /* Exact fallback */
+    if (!done) {
+      bits = aks_dbl_slow(pStr + mstart, mend - mstart, ex - fracd);
+    }
+  }
+  
+  /* Apply the sign and store the result */
+  bits |= ((uint64_t) neg) << 63;
+  memcpy(pv, &bits, sizeof(double));
+  
+  if ((bits & ~(((uint64_t) 1) << 63)) == (((uint64_t) 0x7ff) << 52)) {
+    return ERANGE;
+  }
+  if ((w != 0) && ((bits & ~(((uint64_t) 1) << 63)) == 0)) {
+    return ERANGE;
+  }
+  return 0;
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API size_t aks_fmt_double(char *pBuf, double d);
+AKS_API int aks_parse_double(const char *pStr, size_t len, double *pv);
+
+#endif
+#endif
+
+/* * * * * * * * *
+ *               *
+ * Scratch files *
+ *               *
+ * * * * * * * * */
+
+/* Only proceed if scratch files requested and not already defined */
+#ifdef AKS_TMPFILE
+#ifndef AKS_TMPFILE_INCLUDED
+#define AKS_TMPFILE_INCLUDED
+
+#ifdef AKS_POSIX
+/* POSIX implementation of scratch files ============================ */
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* mkstemp() and fdopen() are only declared with the X/Open extensions
+ * or POSIX.1-2008; otherwise the standard tmpfile() is used */
+#if AKS_POSIX_DECL >= 200809L
+#define AKS_TMPFILE_MKSTEMP
+#elif AKS_POSIX_DECL_XOPEN >= 199506L
+#define AKS_TMPFILE_MKSTEMP
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Create an anonymous scratch file open for binary update.
+ * 
+ * On Linux, the file is created with O_TMPFILE so that it never has a
+ * name.  Where O_TMPFILE is not available or not supported by the file
+ * system, the file is created with mkstemp() and then immediately
+ * unlinked.  Either way, the file disappears when it is closed or the
+ * process ends, and there is no window in which another process can
+ * take the name.
+ * 
+ * The descriptor is marked close-on-exec.
+ * 
+ * Where the feature test macros in effect do not declare mkstemp()
+ * and fdopen(), the file comes from tmpfile() in the default temporary
+ * directory instead, and pDir is ignored.
+ * 
+ * Parameters:
+ * 
+ *   pDir - the directory to create the file in, or NULL for the
+ *   default temporary directory
+ * 
+ * Return:
+ * 
+ *   the new file handle in "w+b" mode, or NULL if error
+ */
+AKS_API FILE *aks_tmpfile_fast(const char *pDir) {
+  
+#ifdef AKS_TMPFILE_MKSTEMP
+  char *pPath = NULL;
+  size_t len = 0;
+  int fd = -1;
+  FILE *fh = NULL;
+  
+  /* Use TMPDIR or /tmp if no directory given */
+  if (pDir == NULL) {
+    pDir = getenv("TMPDIR");
+    if (pDir != NULL) {
+      if (pDir[0] == 0) {
+        pDir = NULL;
+      }
+    }
+    if (pDir == NULL) {
+      pDir = "/tmp";
+    }
+  }
+  
+  /* Try to create an unnamed file first */
+#ifdef O_TMPFILE
+#ifdef O_CLOEXEC
+  fd = open(pDir, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+#else
+  fd = open(pDir, O_TMPFILE | O_RDWR, 0600);
+#endif
+#endif
+  
+  /* Otherwise, create a unique file and unlink it right away */
+  if (fd == -1) {
+    len = strlen(pDir);
+    pPath = (char *) malloc(len + 11);
+    if (pPath != NULL) {
+      strcpy(pPath, pDir);
+      if ((len < 1) || (pPath[len - 1] != '/')) {
+        strcat(pPath, "/");
+      }
+      strcat(pPath, "aksXXXXXX");
+      
+      fd = mkstemp(pPath);
+      if (fd != -1) {
+        unlink(pPath);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+      }
+      
+      free(pPath);
+      pPath = NULL;
+    }
+  }
+  
+  /* Wrap the descriptor in a file handle */
+  if (fd != -1) {
+    fh = fdopen(fd, "w+b");
+    if (fh == NULL) {
+      close(fd);
+    }
+  }
+  
+  /* Return the handle or NULL */
+  return fh;
+  
+#else
+  (void) pDir;
+  return tmpfile();
+#endif
+}
+
+#endif
+
+#else
+/* Windows implementation of scratch files ========================== */
+
+#include <fcntl.h>
+#include <io.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+
+#ifdef AKS_BODIES
+
+/*
+ * Create an anonymous scratch file open for binary update.
+ * 
+ * On Windows, the file is created with a new random name using
+ * CREATE_NEW, so that there is no window in which another process can
+ * take the name.  The file is opened with FILE_FLAG_DELETE_ON_CLOSE so
+ * that the system removes it when the handle is closed, even if the
+ * process ends abnormally, and with FILE_ATTRIBUTE_TEMPORARY so that
+ * the system prefers to keep the data in cache.
+ * 
+ * Parameters:
+ * 
+ *   pDir - the directory to create the file in, or NULL for the
+ *   default temporary directory
+ * 
+ * Return:
+ * 
+ *   the new file handle in "w+b" mode, or NULL if error
+ */
+AKS_API FILE *aks_tmpfile_fast(const char *pDir) {
+  
+  aks_tchar *pt = NULL;
+  aks_tchar *pPath = NULL;
+  HANDLE h = INVALID_HANDLE_VALUE;
+  DWORD len = 0;
+  DWORD seed = 0;
+  DWORD i = 0;
+  int attempt = 0;
+  int j = 0;
+  int fd = -1;
+  FILE *fh = NULL;
+  
+  /* Get the directory in the API encoding */
+  if (pDir != NULL) {
+    pt = aks_toapi(pDir);
+  } else {
+    len = GetTempPath(0, NULL);
+    if (len > 0) {
+      pt = (aks_tchar *) calloc((size_t) len + 1, sizeof(aks_tchar));
+    }
+    if (pt != NULL) {
+      if (GetTempPath(len + 1, pt) < 1) {
+        free(pt);
+        pt = NULL;
+      }
+    }
+  }
+  
+  /* Allocate the path buffer, with room for a separator and the file
+   * name "aksXXXXXXXX.tmp" */
+  if (pt != NULL) {
+    len = (DWORD) lstrlen(pt);
+    pPath = (aks_tchar *) calloc((size_t) len + 17, sizeof(aks_tchar));
+    if (pPath != NULL) {
+      for(i = 0; i < len; i++) {
+        pPath[i] = pt[i];
+      }
+      if ((len < 1) || ((pt[len - 1] != '\\') && (pt[len - 1] != '/'))) {
+        pPath[len++] = '\\';
+      }
+    }
+    free(pt);
+    pt = NULL;
+  }
+  
+  /* Try random names until one can be created */
+  if (pPath != NULL) {
+    seed = GetTickCount() ^ (GetCurrentProcessId() << 16) ^
+            GetCurrentThreadId();
+    for(attempt = 0; attempt < 100; attempt++) {
+      seed = seed * 1103515245UL + 12345UL;
+      
+      pPath[len] = 'a';
+      pPath[len + 1] = 'k';
+      pPath[len + 2] = 's';
+      for(j = 0; j < 8; j++) {
+        pPath[len + 3 + j] = "0123456789abcdef"[(seed >> (j * 4)) & 0xf];
+      }
+      pPath[len + 11] = '.';
+      pPath[len + 12] = 't';
+      pPath[len + 13] = 'm';
+      pPath[len + 14] = 'p';
+      pPath[len + 15] = 0;
+      
+      h = CreateFile(
+            pPath,
+            GENERIC_READ | GENERIC_WRITE,
+            0,
+            NULL,
+            CREATE_NEW,
+            FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE,
+            NULL);
+      if (h != INVALID_HANDLE_VALUE) {
+        break;
+      }
+      if (GetLastError() != ERROR_FILE_EXISTS) {
+        break;
+      }
+    }
+    free(pPath);
+    pPath = NULL;
+  }
+  
+  /* Wrap the system handle in a CRT descriptor and then a file
+   * handle */
+  if (h != INVALID_HANDLE_VALUE) {
+    fd = _open_osfhandle((intptr_t) h, _O_RDWR | _O_BINARY);
+    if (fd == -1) {
+      CloseHandle(h);
+    }
+  }
+  if (fd != -1) {
+    fh = _fdopen(fd, "w+b");
+    if (fh == NULL) {
+      _close(fd);
+    }
+  }
+  
+  /* Return the handle or NULL */
+  return fh;
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+AKS_API FILE *aks_tmpfile_fast(const char *pDir);
+
+#endif
+#endif
+
+/* * * * * * * * * * * * *
+ *                       *
+ * Directory enumeration *
+ *                       *
+ * * * * * * * * * * * * */
+
+/* Only proceed if directory enumeration requested and not already
+ * defined */
+#ifdef AKS_DIR
+#ifndef AKS_DIR_INCLUDED
+#define AKS_DIR_INCLUDED
+
+/*
+ * Size in bytes of the per-directory buffer that entries are read into.
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_DIR_BUFSIZE
+#define AKS_DIR_BUFSIZE 262144
+#endif
+
+/*
+ * Entry types, also used by AKS_STAT.
+ */
+#ifndef AKS_DIR_UNKNOWN
+#define AKS_DIR_UNKNOWN 0
+#define AKS_DIR_FILE    1
+#define AKS_DIR_DIR     2
+#define AKS_DIR_LINK    3
+#define AKS_DIR_OTHER   4
+#endif
+
+#ifdef AKS_POSIX
+/* POSIX implementation of directory enumeration ==================== */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/* On Linux, read raw entries with getdents64 if the system call is
+ * declared */
+#ifdef __linux__
+#ifdef _GNU_SOURCE
+#include <sys/syscall.h>
+#ifdef SYS_getdents64
+#define AKS_DIR_GETDENTS
+#endif
+#endif
+#endif
+
+/*
+ * A directory entry.
+ * 
+ * The name is only valid until the next aks_dir_read() or
+ * aks_dir_close() call on the same directory.
+ */
+typedef struct {
+  
+  /* The UTF-8 name of the entry, without any path */
+  const char *pName;
+  
+  /* One of the AKS_DIR_ entry type constants */
+  int type;
+  
+  /* The size in bytes, or -1 if it was not available for free */
+  int64_t size;
+  
+} aks_dirent;
+
+/*
+ * An open directory.
+ */
+typedef struct {
+  
+  /* Entry buffer */
+  char *pBuf;
+  
+#ifdef AKS_DIR_GETDENTS
+  /* Directory descriptor, and the filled length and read position of
+   * the raw getdents64 records in the buffer */
+  int fd;
+  size_t fill;
+  size_t pos;
+  
+#else
+  /* Directory stream, and an entry that did not fit in the buffer
+   * last time */
+  DIR *pd;
+  struct dirent *pPending;
+#endif
+  
+} aks_dir;
+
+#ifdef AKS_DIR_GETDENTS
+/*
+ * Layout of the records returned by getdents64.
+ */
+struct aks_dir_linux_dirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[1];
+};
+#endif
+
+#ifdef AKS_BODIES
+
+#ifdef DT_UNKNOWN
+/*
+ * Convert a dirent type code into an AKS_DIR_ entry type.
+ * 
+ * Only defined where the system provides the type codes.
+ */
+AKS_INTERNAL int aks_dir_type(int dt) {
+  switch (dt) {
+    case DT_REG:
+      return AKS_DIR_FILE;
+    case DT_DIR:
+      return AKS_DIR_DIR;
+    case DT_LNK:
+      return AKS_DIR_LINK;
+    case DT_UNKNOWN:
+      return AKS_DIR_UNKNOWN;
+    default:
+      return AKS_DIR_OTHER;
+  }
+}
+#endif
+
+/*
+ * Open a directory for enumeration.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the directory
+ * 
+ * Return:
+ * 
+ *   the new directory, or NULL if error
+ */
+AKS_API aks_dir *aks_dir_open(const char *pPath) {
+  
+  aks_dir *pDir = NULL;
+  
+  /* Allocate the structure and the buffer */
+  pDir = (aks_dir *) calloc(1, sizeof(aks_dir));
+  if (pDir != NULL) {
+    pDir->pBuf = (char *) malloc(AKS_DIR_BUFSIZE);
+    if (pDir->pBuf == NULL) {
+      free(pDir);
+      pDir = NULL;
+    }
+  }
+  
+  /* Open the directory */
+  if (pDir != NULL) {
+#ifdef AKS_DIR_GETDENTS
+    pDir->fd = open(pPath, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (pDir->fd == -1) {
+      free(pDir->pBuf);
+      free(pDir);
+      pDir = NULL;
+    }
+#else
+    pDir->pd = opendir(pPath);
+    if (pDir->pd == NULL) {
+      free(pDir->pBuf);
+      free(pDir);
+      pDir = NULL;
+    }
+#endif
+  }
+  
+  /* Return the directory or NULL */
+  return pDir;
+}
+
+/*
+ * Read a batch of entries from a directory.
+ * 
+ * The "." and ".." entries are never returned.  Names remain valid
+ * until the next call on the same directory.  The type comes from the
+ * directory itself without a stat call, so it may be AKS_DIR_UNKNOWN on
+ * file systems that do not record it.  The size is always -1 on POSIX,
+ * because it is never available without a stat call.
+ * 
+ * On Linux, entries are read with the getdents64 system call into a
+ * buffer of AKS_DIR_BUFSIZE bytes, and names point straight into that
+ * buffer.  Elsewhere, readdir() is used and names are copied into the
+ * buffer.
+ * 
+ * Parameters:
+ * 
+ *   pDir - the directory
+ * 
+ *   pEnt - the array to fill with entries
+ * 
+ *   max - the maximum number of entries to return
+ * 
+ * Return:
+ * 
+ *   the number of entries returned, zero at the end of the directory,
+ *   or -1 if error
+ */
+AKS_API int aks_dir_read(aks_dir *pDir, aks_dirent *pEnt, int max) {
+  
+  int count = 0;
+#ifdef AKS_DIR_GETDENTS
+  struct aks_dir_linux_dirent64 *pd = NULL;
+  long r = 0;
+  
+  while (count < max) {
+    
+    /* Refill the buffer once it has been used up, but never in a call
+     * that has already returned names from it */
+    if (pDir->pos >= pDir->fill) {
+      if (count > 0) {
+        break;
+      }
+      r = syscall(SYS_getdents64, pDir->fd, pDir->pBuf, AKS_DIR_BUFSIZE);
+      if (r < 0) {
+        return -1;
+      }
+      if (r == 0) {
+        break;
+      }
+      pDir->fill = (size_t) r;
+      pDir->pos = 0;
+    }
+    
+    /* Take the next record */
+    pd = (struct aks_dir_linux_dirent64 *) (pDir->pBuf + pDir->pos);
+    pDir->pos += pd->d_reclen;
+    
+    if (pd->d_name[0] == '.') {
+      if ((pd->d_name[1] == 0) ||
+            ((pd->d_name[1] == '.') && (pd->d_name[2] == 0))) {
+        continue;
+      }
+    }
+    
+    pEnt[count].pName = pd->d_name;
+#ifdef DT_UNKNOWN
+    pEnt[count].type = aks_dir_type(pd->d_type);
+#else
+    pEnt[count].type = AKS_DIR_UNKNOWN;
+#endif
+    pEnt[count].size = -1;
+    count++;
+  }
+  
+#else
+  struct dirent *pd = NULL;
+  size_t used = 0;
+  size_t len = 0;
+  
+  while (count < max) {
+    
+    /* Get the pending entry or read a new one */
+    if (pDir->pPending != NULL) {
+      pd = pDir->pPending;
+      pDir->pPending = NULL;
+    } else {
+      pd = readdir(pDir->pd);
+      if (pd == NULL) {
+        break;
+      }
+    }
+    
+    if (pd->d_name[0] == '.') {
+      if ((pd->d_name[1] == 0) ||
+            ((pd->d_name[1] == '.') && (pd->d_name[2] == 0))) {
+        continue;
+      }
+    }
+    
+    /* Copy the name into the buffer, or keep the entry for next time
+     * if it does not fit */
+    len = strlen(pd->d_name) + 1;
+    if (used + len > AKS_DIR_BUFSIZE) {
+      pDir->pPending = pd;
+      break;
+    }
+    memcpy(pDir->pBuf + used, pd->d_name, len);
+    
+    pEnt[count].pName = pDir->pBuf + used;
+#ifdef DT_UNKNOWN
+    pEnt[count].type = aks_dir_type(pd->d_type);
+#else
+    pEnt[count].type = AKS_DIR_UNKNOWN;
+#endif
+    pEnt[count].size = -1;
+    used += len;
+    count++;
+  }
+#endif
+  
+  /* Return the number of entries */
+  return count;
+}
+
+/*
+ * Close a directory.
+ * 
+ * Parameters:
+ * 
+ *   pDir - the directory to close, or NULL
+ */
+AKS_API void aks_dir_close(aks_dir *pDir) {
+  if (pDir != NULL) {
+#ifdef AKS_DIR_GETDENTS
+    close(pDir->fd);
+#else
+    closedir(pDir->pd);
+#endif
+    free(pDir->pBuf);
+    free(pDir);
+  }
+}
+
+#endif
+
+#else
+/* Windows implementation of directory enumeration ================== */
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+/* Large fetch and basic information need Windows 7; define the flag
+ * for older SDKs, where it is ignored */
+#ifndef FIND_FIRST_EX_LARGE_FETCH
+#define FIND_FIRST_EX_LARGE_FETCH 2
+#endif
+
+/*
+ * A directory entry.
+ * 
+ * The name is only valid until the next aks_dir_read() or
+ * aks_dir_close() call on the same directory.
+ */
+typedef struct {
+  
+  /* The UTF-8 name of the entry, without any path */
+  const char *pName;
+  
+  /* One of the AKS_DIR_ entry type constants */
+  int type;
+  
+  /* The size in bytes, or -1 if it was not available for free */
+  int64_t size;
+  
+} aks_dirent;
+
+/*
+ * An open directory.
+ */
+typedef struct {
+  
+  /* Entry buffer for translated names */
+  char *pBuf;
+  
+  /* Find handle, the current find data, and whether the find data holds
+   * an entry that has not been returned yet */
+  HANDLE h;
+  WIN32_FIND_DATA fd;
+  int pending;
+  
+} aks_dir;
+
+#ifdef AKS_BODIES
+
+/*
+ * Open a directory for enumeration.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the directory
+ * 
+ * Return:
+ * 
+ *   the new directory, or NULL if error
+ */
+AKS_API aks_dir *aks_dir_open(const char *pPath) {
+  
+  aks_dir *pDir = NULL;
+  aks_tchar *pt = NULL;
+  aks_tchar *pPat = NULL;
+  size_t len = 0;
+  size_t i = 0;
+  
+  /* Build the search pattern by appending "\*" to the path */
+  pt = aks_toapi(pPath);
+  if (pt != NULL) {
+    len = (size_t) lstrlen(pt);
+    pPat = (aks_tchar *) calloc(len + 3, sizeof(aks_tchar));
+    if (pPat != NULL) {
+      for(i = 0; i < len; i++) {
+        pPat[i] = pt[i];
+      }
+      if ((len > 0) && (pt[len - 1] != '\\') && (pt[len - 1] != '/')) {
+        pPat[len++] = '\\';
+      }
+      pPat[len++] = '*';
+      pPat[len] = 0;
+    }
+    free(pt);
+    pt = NULL;
+  }
+  
+  /* Allocate the structure and the buffer */
+  if (pPat != NULL) {
+    pDir = (aks_dir *) calloc(1, sizeof(aks_dir));
+    if (pDir != NULL) {
+      pDir->pBuf = (char *) malloc(AKS_DIR_BUFSIZE);
+      if (pDir->pBuf == NULL) {
+        free(pDir);
+        pDir = NULL;
+      }
+    }
+  }
+  
+  /* Start the search, which returns the first entry */
+  if (pDir != NULL) {
+    pDir->h = FindFirstFileEx(
+                pPat,
+                FindExInfoBasic,
+                &(pDir->fd),
+                FindExSearchNameMatch,
+                NULL,
+                FIND_FIRST_EX_LARGE_FETCH);
+    if (pDir->h == INVALID_HANDLE_VALUE) {
+      free(pDir->pBuf);
+      free(pDir);
+      pDir = NULL;
+    } else {
+      pDir->pending = 1;
+    }
+  }
+  
+  if (pPat != NULL) {
+    free(pPat);
+    pPat = NULL;
+  }
+  
+  /* Return the directory or NULL */
+  return pDir;
+}
+
+/*
+ * Read a batch of entries from a directory.
+ * 
+ * The "." and ".." entries are never returned.  Names remain valid
+ * until the next call on the same directory.  The type and size come
+ * from the directory listing itself without any further query.
+ * Directories and reparse points have a size of -1.
+ * 
+ * On Windows, entries are read with FindFirstFileEx() using large
+ * fetches, and names are translated into a buffer of AKS_DIR_BUFSIZE
+ * bytes.
+ * 
+ * Parameters:
+ * 
+ *   pDir - the directory
+ * 
+ *   pEnt - the array to fill with entries
+ * 
+ *   max - the maximum number of entries to return
+ * 
+ * Return:
+ * 
+ *   the number of entries returned, zero at the end of the directory,
+ *   or -1 if error
+ */
+AKS_API int aks_dir_read(aks_dir *pDir, aks_dirent *pEnt, int max) {
+  
+  const aks_tchar *pn = NULL;
+  size_t used = 0;
+  int len = 0;
+  int count = 0;
+  
+  while (count < max) {
+    
+    /* Get the next entry if the find data has been used */
+    if (!(pDir->pending)) {
+      if (!FindNextFile(pDir->h, &(pDir->fd))) {
+        if (GetLastError() != ERROR_NO_MORE_FILES) {
+          return -1;
+        }
+        break;
+      }
+      pDir->pending = 1;
+    }
+    
+    pn = pDir->fd.cFileName;
+    if (pn[0] == '.') {
+      if ((pn[1] == 0) || ((pn[1] == '.') && (pn[2] == 0))) {
+        pDir->pending = 0;
+        continue;
+      }
+    }
+    
+    /* Translate the name into the buffer, leaving the entry pending for
+     * next time if it does not fit */
+#ifdef UNICODE
+    /* A zero buffer size would only query the length needed */
+    if (used >= AKS_DIR_BUFSIZE) {
+      break;
+    }
+    len = WideCharToMultiByte(
+            CP_UTF8,
+            WC_ERR_INVALID_CHARS,
+            pn,
+            -1,
+            pDir->pBuf + used,
+            (int) (AKS_DIR_BUFSIZE - used),
+            NULL,
+            NULL);
+    if (len < 1) {
+      if (GetLastError() != ERROR_INSUFFICIENT_BUFFER) {
+        return -1;
+      }
+      break;
+    }
+#else
+    len = lstrlen(pn) + 1;
+    if (used + (size_t) len > AKS_DIR_BUFSIZE) {
+      break;
+    }
+    memcpy(pDir->pBuf + used, pn, (size_t) len);
+#endif
+    
+    pEnt[count].pName = pDir->pBuf + used;
+    if (pDir->fd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+      pEnt[count].type = AKS_DIR_LINK;
+      pEnt[count].size = -1;
+    } else if (pDir->fd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+      pEnt[count].type = AKS_DIR_DIR;
+      pEnt[count].size = -1;
+    } else {
+      pEnt[count].type = AKS_DIR_FILE;
+      pEnt[count].size = (int64_t)
+        ((((uint64_t) pDir->fd.nFileSizeHigh) << 32) |
+          ((uint64_t) pDir->fd.nFileSizeLow));
+    }
+    used += (size_t) len;
+    pDir->pending = 0;
+    count++;
+  }
+  
+  /* Return the number of entries */
+  return count;
+}
+
+/*
+ * Close a directory.
+ * 
+ * Parameters:
+ * 
+ *   pDir - the directory to close, or NULL
+ */
+AKS_API void aks_dir_close(aks_dir *pDir) {
+  if (pDir != NULL) {
+    FindClose(pDir->h);
+    free(pDir->pBuf);
+    free(pDir);
+  }
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+AKS_API aks_dir *aks_dir_open(const char *pPath);
+AKS_API int aks_dir_read(aks_dir *pDir, aks_dirent *pEnt, int max);
+AKS_API void aks_dir_close(aks_dir *pDir);
+
+#endif
+#endif
+
+/* * * * * * * * * * *
+ *                   *
+ * Metadata queries  *
+ *                   *
+ * * * * * * * * * * */
+
+/* Only proceed if metadata queries requested and not already defined */
+#ifdef AKS_STAT
+#ifndef AKS_STAT_INCLUDED
+#define AKS_STAT_INCLUDED
+
+/*
+ * If AKS_STAT_THREADS is defined to a number greater than one before
+ * including the header, large batches are split across up to that many
+ * threads.  On POSIX this requires linking with the pthread library.
+ */
+#ifdef AKS_STAT_THREADS
+#if AKS_STAT_THREADS > 1
+#define AKS_STAT_THREADED
+#endif
+#endif
+
+#ifdef AKS_STAT_THREADED
+#define AKS_STAT_THREADS_MAX AKS_STAT_THREADS
+#else
+#define AKS_STAT_THREADS_MAX 1
+#endif
+
+/*
+ * The smallest number of paths that is worth giving to a thread of its
+ * own.
+ */
+#ifndef AKS_STAT_MIN_BATCH
+#define AKS_STAT_MIN_BATCH 64
+#endif
+
+/*
+ * Entry types, also used by AKS_DIR.
+ */
+#ifndef AKS_DIR_UNKNOWN
+#define AKS_DIR_UNKNOWN 0
+#define AKS_DIR_FILE    1
+#define AKS_DIR_DIR     2
+#define AKS_DIR_LINK    3
+#define AKS_DIR_OTHER   4
+#endif
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The metadata of one path.
+ */
+typedef struct {
+  
+  /* Zero if the query succeeded, else the errno value of the failure,
+   * in which case the other fields are zero */
+  int err;
+  
+  /* One of the AKS_DIR_ entry type constants */
+  int type;
+  
+  /* The size in bytes */
+  int64_t size;
+  
+  /* The last modification time, in seconds and nanoseconds since the
+   * Unix epoch; the nanoseconds are zero where the platform does not
+   * report them */
+  int64_t mtime_sec;
+  int32_t mtime_nsec;
+  
+} aks_stat64;
+
+#ifdef AKS_POSIX
+/* POSIX implementation of metadata queries ========================= */
+
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef AKS_STAT_THREADED
+#include <pthread.h>
+#endif
+
+/* The stat structure has nanosecond times in st_mtim from POSIX.1-2008
+ * on, except on macOS, which has them in st_mtimespec outside of the
+ * strict POSIX modes */
+#ifdef __APPLE__
+#ifdef AKS_POSIX_DECL_MISC
+#define AKS_STAT_MTIMESPEC
+#endif
+#else
+#if AKS_POSIX_DECL >= 200809L
+#define AKS_STAT_MTIM
+#endif
+#endif
+
+/* On Linux, query only the fields needed with statx if it is
+ * declared */
+#ifdef __linux__
+#ifdef _GNU_SOURCE
+#ifdef STATX_TYPE
+#include <fcntl.h>
+#define AKS_STAT_STATX
+#endif
+#endif
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Query the metadata of a single path.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the path
+ * 
+ *   pOut - the structure to fill
+ */
+AKS_INTERNAL void aks_stat_one(const char *pPath, aks_stat64 *pOut) {
+  
+#ifdef AKS_STAT_STATX
+  struct statx sx;
+#endif
+  struct stat st;
+  
+  memset(pOut, 0, sizeof(aks_stat64));
+  
+#ifdef AKS_STAT_STATX
+  /* Ask only for type, size and modification time, which lets network
+   * and FUSE file systems skip the rest; fall through to stat() if the
+   * kernel predates statx */
+  if (statx(AT_FDCWD, pPath, AT_STATX_SYNC_AS_STAT,
+        STATX_TYPE | STATX_SIZE | STATX_MTIME, &sx) == 0) {
+    if (S_ISREG(sx.stx_mode)) {
+      pOut->type = AKS_DIR_FILE;
+    } else if (S_ISDIR(sx.stx_mode)) {
+      pOut->type = AKS_DIR_DIR;
+    } else {
+      pOut->type = AKS_DIR_OTHER;
+    }
+    pOut->size = (int64_t) sx.stx_size;
+    pOut->mtime_sec = (int64_t) sx.stx_mtime.tv_sec;
+    pOut->mtime_nsec = (int32_t) sx.stx_mtime.tv_nsec;
+    return;
+  } else if (errno != ENOSYS) {
+    pOut->err = errno;
+    return;
+  }
+#endif
+  
+  if (stat(pPath, &st) != 0) {
+    pOut->err = errno;
+    return;
+  }
+  
+  if (S_ISREG(st.st_mode)) {
+    pOut->type = AKS_DIR_FILE;
+  } else if (S_ISDIR(st.st_mode)) {
+    pOut->type = AKS_DIR_DIR;
+  } else {
+    pOut->type = AKS_DIR_OTHER;
+  }
+  pOut->size = (int64_t) st.st_size;
+  pOut->mtime_sec = (int64_t) st.st_mtime;
+#ifdef AKS_STAT_MTIM
+  pOut->mtime_nsec = (int32_t) st.st_mtim.tv_nsec;
+#endif
+#ifdef AKS_STAT_MTIMESPEC
+  pOut->mtime_nsec = (int32_t) st.st_mtimespec.tv_nsec;
+#endif
+}
+
+/*
+ * A range of paths for one thread to query.
+ */
+typedef struct {
+  const char * const *ppPath;
+  aks_stat64 *pOut;
+  size_t first;
+  size_t last;
+} aks_stat_job;
+
+/*
+ * Query a range of paths.
+ * 
+ * Parameters:
+ * 
+ *   pArg - the aks_stat_job describing the range
+ * 
+ * Return:
+ * 
+ *   NULL
+ */
+AKS_INTERNAL void *aks_stat_run(void *pArg) {
+  
+  aks_stat_job *pj = (aks_stat_job *) pArg;
+  size_t i = 0;
+  
+  for(i = pj->first; i < pj->last; i++) {
+    aks_stat_one(pj->ppPath[i], &(pj->pOut[i]));
+  }
+  
+  return NULL;
+}
+
+/*
+ * Query the type, size and modification time of many paths at once.
+ * 
+ * Symbolic links are followed.  On Linux with _GNU_SOURCE, statx() is
+ * asked for only the fields that are returned.  If AKS_STAT_THREADS is
+ * defined, large batches are split across threads.
+ * 
+ * Parameters:
+ * 
+ *   ppPath - the UTF-8 paths
+ * 
+ *   n - the number of paths
+ * 
+ *   pOut - the array of n structures to fill
+ * 
+ * Return:
+ * 
+ *   the number of paths that were queried successfully, or -1 if error
+ */
+AKS_API long aks_stat64_many(
+    const char * const   * ppPath,
+          size_t           n,
+          aks_stat64     * pOut) {
+  
+  aks_stat_job job[AKS_STAT_THREADS_MAX];
+  long count = 0;
+  size_t i = 0;
+  size_t k = 0;
+  size_t chunk = 0;
+#ifdef AKS_STAT_THREADED
+  pthread_t th[AKS_STAT_THREADS_MAX];
+  int started[AKS_STAT_THREADS_MAX];
+#endif
+  
+  /* Work out how many ranges to split the paths into */
+  k = n / AKS_STAT_MIN_BATCH;
+  if (k > AKS_STAT_THREADS_MAX) {
+    k = AKS_STAT_THREADS_MAX;
+  }
+  if (k < 1) {
+    k = 1;
+  }
+  chunk = (n + k - 1) / k;
+  
+  for(i = 0; i < k; i++) {
+    job[i].ppPath = ppPath;
+    job[i].pOut = pOut;
+    job[i].first = i * chunk;
+    job[i].last = (i + 1) * chunk;
+    if (job[i].last > n) {
+      job[i].last = n;
+    }
+  }
+  
+  /* Run every range but the first on its own thread, and the first on
+   * this one; ranges whose thread could not be started run here too */
+#ifdef AKS_STAT_THREADED
+  for(i = 1; i < k; i++) {
+    started[i] = (pthread_create(&(th[i]), NULL,
+                    &aks_stat_run, &(job[i])) == 0);
+  }
+#endif
+  aks_stat_run(&(job[0]));
+#ifdef AKS_STAT_THREADED
+  for(i = 1; i < k; i++) {
+    if (started[i]) {
+      pthread_join(th[i], NULL);
+    } else {
+      aks_stat_run(&(job[i]));
+    }
+  }
+#endif
+  
+  /* Count the successes */
+  for(i = 0; i < n; i++) {
+    if (pOut[i].err == 0) {
+      count++;
+    }
+  }
+  
+  return count;
+}
+
+#endif
+
+#else
+/* Windows implementation of metadata queries ======================= */
+
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+#ifdef AKS_BODIES
+
+/*
+ * Convert the last error of a failed query to an errno value.
+ * 
+ * Return:
+ * 
+ *   the errno value
+ */
+AKS_INTERNAL int aks_stat_err(void) {
+  switch (GetLastError()) {
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:
+    case ERROR_INVALID_NAME:
+      return ENOENT;
+    case ERROR_ACCESS_DENIED:
+    case ERROR_SHARING_VIOLATION:
+      return EACCES;
+    default:
+      return EIO;
+  }
+}
+
+/*
+ * Query the metadata of a single path.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the translated path
+ * 
+ *   pOut - the structure to fill
+ */
+AKS_INTERNAL void aks_stat_one(const aks_tchar *pPath, aks_stat64 *pOut) {
+  
+  WIN32_FILE_ATTRIBUTE_DATA fa;
+  BY_HANDLE_FILE_INFORMATION fi;
+  HANDLE h = INVALID_HANDLE_VALUE;
+  int64_t t = 0;
+  
+  memset(pOut, 0, sizeof(aks_stat64));
+  
+  /* The attribute query reads the directory entry without opening the
+   * file */
+  if (!GetFileAttributesEx(pPath, GetFileExInfoStandard, &fa)) {
+    pOut->err = aks_stat_err();
+    return;
+  }
+  
+  /* The directory entry of a symbolic link or junction describes the
+   * link itself, so open the target to follow it */
+  if (fa.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT) {
+    h = CreateFile(
+          pPath,
+          0,
+          FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+          NULL,
+          OPEN_EXISTING,
+          FILE_FLAG_BACKUP_SEMANTICS,
+          NULL);
+    if (h == INVALID_HANDLE_VALUE) {
+      pOut->err = aks_stat_err();
+      return;
+    }
+    if (!GetFileInformationByHandle(h, &fi)) {
+      pOut->err = aks_stat_err();
+      CloseHandle(h);
+      return;
+    }
+    CloseHandle(h);
+    
+    fa.dwFileAttributes = fi.dwFileAttributes;
+    fa.ftLastWriteTime = fi.ftLastWriteTime;
+    fa.nFileSizeHigh = fi.nFileSizeHigh;
+    fa.nFileSizeLow = fi.nFileSizeLow;
+  }
+  
+  if (fa.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+    pOut->type = AKS_DIR_DIR;
+  } else {
+    pOut->type = AKS_DIR_FILE;
+    pOut->size = (int64_t)
+      ((((uint64_t) fa.nFileSizeHigh) << 32) |
+        ((uint64_t) fa.nFileSizeLow));
+  }
+  
+  /* Convert 100-nanosecond ticks since 1601 to the Unix epoch */
+  t = (int64_t)
+      ((((uint64_t) fa.ftLastWriteTime.dwHighDateTime) << 32) |
+        ((uint64_t) fa.ftLastWriteTime.dwLowDateTime));
+  t -= INT64_C(116444736000000000);
+  pOut->mtime_sec = t / 10000000;
+  t %= 10000000;
+  if (t < 0) {
+    t += 10000000;
+    (pOut->mtime_sec)--;
+  }
+  pOut->mtime_nsec = (int32_t) (t * 100);
+}
+
+/*
+ * A range of paths for one thread to query.
+ */
+typedef struct {
+  aks_tchar **ppPath;
+  aks_stat64 *pOut;
+  size_t first;
+  size_t last;
+} aks_stat_job;
+
+/*
+ * Query a range of paths.
+ * 
+ * Parameters:
+ * 
+ *   pArg - the aks_stat_job describing the range
+ * 
+ * Return:
+ * 
+ *   zero
+ */
+AKS_INTERNAL DWORD WINAPI aks_stat_run(LPVOID pArg) {
+  
+  aks_stat_job *pj = (aks_stat_job *) pArg;
+  size_t i = 0;
+  
+  for(i = pj->first; i < pj->last; i++) {
+    if (pj->ppPath[i] != NULL) {
+      aks_stat_one(pj->ppPath[i], &(pj->pOut[i]));
+    }
+  }
+  
+  return 0;
+}
+
+/*
+ * Query the type, size and modification time of many paths at once.
+ * 
+ * Symbolic links are followed.  All the paths are translated up front
+ * into a single allocation, and each is then queried with
+ * GetFileAttributesEx(), which does not open the file.  Only symbolic
+ * links and other reparse points are opened, with CreateFile(), so that
+ * their targets can be queried.  If AKS_STAT_THREADS is defined, large
+ * batches are split across threads.
+ * 
+ * Parameters:
+ * 
+ *   ppPath - the UTF-8 paths
+ * 
+ *   n - the number of paths
+ * 
+ *   pOut - the array of n structures to fill
+ * 
+ * Return:
+ * 
+ *   the number of paths that were queried successfully, or -1 if error
+ */
+AKS_API long aks_stat64_many(
+    const char * const   * ppPath,
+          size_t           n,
+          aks_stat64     * pOut) {
+  
+  aks_stat_job job[AKS_STAT_THREADS_MAX];
+  aks_tchar **ppt = NULL;
+  long count = 0;
+  size_t total = 0;
+  size_t i = 0;
+  size_t k = 0;
+  size_t chunk = 0;
+  int len = 0;
+#ifdef UNICODE
+  aks_tchar *pt = NULL;
+#endif
+#ifdef AKS_STAT_THREADED
+  HANDLE th[AKS_STAT_THREADS_MAX];
+#endif
+  
+  /* Measure all the translated paths */
+  for(i = 0; i < n; i++) {
+#ifdef UNICODE
+    len = MultiByteToWideChar(
+            CP_UTF8, MB_ERR_INVALID_CHARS, ppPath[i], -1, NULL, 0);
+    if (len > 0) {
+      total += (size_t) len;
+    }
+#else
+    (void) len;
+#endif
+  }
+  
+  /* Allocate the pointer array and all the strings in one block */
+  ppt = (aks_tchar **) malloc(
+          (n + 1) * sizeof(aks_tchar *) + total * sizeof(aks_tchar));
+  if (ppt == NULL) {
+    return -1;
+  }
+  
+  /* Translate each path into the block, or point straight at it where
+   * no translation is needed */
+#ifdef UNICODE
+  pt = (aks_tchar *) (ppt + n + 1);
+#endif
+  for(i = 0; i < n; i++) {
+#ifdef UNICODE
+    len = MultiByteToWideChar(
+            CP_UTF8, MB_ERR_INVALID_CHARS, ppPath[i], -1, pt, (int) total);
+    if (len > 0) {
+      ppt[i] = pt;
+      pt += len;
+      total -= (size_t) len;
+    } else {
+      ppt[i] = NULL;
+      memset(&(pOut[i]), 0, sizeof(aks_stat64));
+      pOut[i].err = EINVAL;
+    }
+#else
+    ppt[i] = (aks_tchar *) ppPath[i];
+#endif
+  }
+  
+  /* Work out how many ranges to split the paths into */
+  k = n / AKS_STAT_MIN_BATCH;
+  if (k > AKS_STAT_THREADS_MAX) {
+    k = AKS_STAT_THREADS_MAX;
+  }
+  if (k < 1) {
+    k = 1;
+  }
+  chunk = (n + k - 1) / k;
+  
+  for(i = 0; i < k; i++) {
+    job[i].ppPath = ppt;
+    job[i].pOut = pOut;
+    job[i].first = i * chunk;
+    job[i].last = (i + 1) * chunk;
+    if (job[i].last > n) {
+      job[i].last = n;
+    }
+  }
+  
+  /* Run every range but the first on its own thread, and the first on
+   * this one; ranges whose thread could not be started run here too */
+#ifdef AKS_STAT_THREADED
+  for(i = 1; i < k; i++) {
+    th[i] = CreateThread(NULL, 0, &aks_stat_run, &(job[i]), 0, NULL);
+  }
+#endif
+  aks_stat_run(&(job[0]));
+#ifdef AKS_STAT_THREADED
+  for(i = 1; i < k; i++) {
+    if (th[i] != NULL) {
+      WaitForSingleObject(th[i], INFINITE);
+      CloseHandle(th[i]);
+    } else {
+      aks_stat_run(&(job[i]));
+    }
+  }
+#endif
+  
+  free(ppt);
+  ppt = NULL;
+  
+  /* Count the successes */
+  for(i = 0; i < n; i++) {
+    if (pOut[i].err == 0) {
+      count++;
+    }
+  }
+  
+  return count;
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+AKS_API long aks_stat64_many(
+    const char * const   * ppPath,
+          size_t           n,
+          aks_stat64     * pOut);
+
+#endif
+#endif
+
+/* * * * * * * * * * *
+ *                   *
+ * Process spawning  *
+ *                   *
+ * * * * * * * * * * */
+
+/* Only proceed if process spawning requested and not already defined */
+#ifdef AKS_SPAWN
+#ifndef AKS_SPAWN_INCLUDED
+#define AKS_SPAWN_INCLUDED
+
+/*
+ * Options for a spawned process.
+ * 
+ * Each field is a file descriptor in this process that becomes the
+ * corresponding standard stream of the child, or -1 to pass on the
+ * current standard stream.
+ */
+typedef struct {
+  int fd_in;
+  int fd_out;
+  int fd_err;
+} aks_spawn_opts;
+
+#ifdef AKS_BODIES
+
+/*
+ * Initialize spawn options so that the child inherits all three
+ * standard streams.
+ * 
+ * Parameters:
+ * 
+ *   pOpts - the options to initialize
+ */
+AKS_API void aks_spawn_opts_init(aks_spawn_opts *pOpts) {
+  pOpts->fd_in = -1;
+  pOpts->fd_out = -1;
+  pOpts->fd_err = -1;
+}
+
+#endif
+
+/*
+ * Which output streams of the child aks_spawn_pipe() captures.
+ * AKS_SPAWN_MERGE sends standard error into the standard output pipe.
+ */
+#define AKS_SPAWN_STDOUT 1
+#define AKS_SPAWN_STDERR 2
+#define AKS_SPAWN_MERGE  4
+
+/*
+ * Requested size in bytes of the kernel buffer of each capture pipe.
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_PIPE_BUFSIZE
+#define AKS_PIPE_BUFSIZE 1048576
+#endif
+
+#ifdef AKS_POSIX
+/* POSIX implementation of process spawning ========================= */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <spawn.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+/* On Linux, create pipes that are closed on exec in one step, so that
+ * they cannot leak into children spawned by other threads */
+#ifdef __linux__
+#ifdef _GNU_SOURCE
+#define AKS_SPAWN_PIPE2
+#endif
+#endif
+
+extern char **environ;
+
+/*
+ * A spawned process.
+ */
+typedef struct {
+  pid_t pid;
+} aks_proc;
+
+#ifdef AKS_BODIES
+
+/*
+ * Duplicate a descriptor onto the lowest free descriptor above the
+ * standard streams, closed on exec.
+ * 
+ * Parameters:
+ * 
+ *   fd - the descriptor
+ * 
+ * Return:
+ * 
+ *   the new descriptor, or -1 if error
+ */
+AKS_INTERNAL int aks_spawn_dupabove(int fd) {
+  
+  int r = -1;
+  
+#ifdef F_DUPFD_CLOEXEC
+  r = fcntl(fd, F_DUPFD_CLOEXEC, 3);
+#else
+  r = fcntl(fd, F_DUPFD, 3);
+  if (r >= 0) {
+    fcntl(r, F_SETFD, FD_CLOEXEC);
+  }
+#endif
+  
+  return r;
+}
+
+/*
+ * Start a program without going through the shell.
+ * 
+ * The program is found on the PATH if argv[0] has no slash.  On POSIX
+ * the child is started with posix_spawnp(), which C libraries such as
+ * glibc and musl implement with vfork() semantics, so the cost does
+ * not grow with the size of this process.
+ * 
+ * The redirections may name the standard streams themselves in any
+ * arrangement, such as swapping standard output and standard error.
+ * 
+ * Parameters:
+ * 
+ *   argv - the NULL-terminated UTF-8 argument list, starting with the
+ *   program name
+ * 
+ *   envp - the NULL-terminated UTF-8 environment list, or NULL to pass
+ *   on the current environment
+ * 
+ *   pOpts - the stream redirections, or NULL to inherit all
+ * 
+ *   pProc - receives the new process
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_spawn(
+    const char * const       * argv,
+    const char * const       * envp,
+    const aks_spawn_opts     * pOpts,
+          aks_proc           * pProc) {
+  
+  posix_spawn_file_actions_t fa;
+  int fds[3];
+  int tmp[3];
+  pid_t pid = 0;
+  int err = 0;
+  int i = 0;
+  
+  if (pOpts != NULL) {
+    fds[0] = pOpts->fd_in;
+    fds[1] = pOpts->fd_out;
+    fds[2] = pOpts->fd_err;
+  } else {
+    fds[0] = -1;
+    fds[1] = -1;
+    fds[2] = -1;
+  }
+  
+  /* The child duplicates the descriptors in order, so a source that is
+   * itself a standard stream could be overwritten before it is used;
+   * copy such sources above the standard streams first */
+  for(i = 0; i < 3; i++) {
+    tmp[i] = -1;
+    if ((err == 0) && (fds[i] >= 0) && (fds[i] <= 2) && (fds[i] != i)) {
+      tmp[i] = aks_spawn_dupabove(fds[i]);
+      if (tmp[i] < 0) {
+        err = errno;
+      } else {
+        fds[i] = tmp[i];
+      }
+    }
+  }
+  
+  if (err == 0) {
+    err = posix_spawn_file_actions_init(&fa);
+    if (err == 0) {
+      
+      /* Duplicate each redirected descriptor onto its standard stream
+       * in the child */
+      for(i = 0; i < 3; i++) {
+        if ((err == 0) && (fds[i] >= 0) && (fds[i] != i)) {
+          err = posix_spawn_file_actions_adddup2(&fa, fds[i], i);
+        }
+      }
+      
+      if (err == 0) {
+        err = posix_spawnp(
+                &pid,
+                argv[0],
+                &fa,
+                NULL,
+                (char * const *) argv,
+                (envp != NULL) ? (char * const *) envp : environ);
+      }
+      posix_spawn_file_actions_destroy(&fa);
+    }
+  }
+  
+  for(i = 0; i < 3; i++) {
+    if (tmp[i] >= 0) {
+      close(tmp[i]);
+    }
+  }
+  
+  if (err != 0) {
+    errno = err;
+    return -1;
+  }
+  
+  pProc->pid = pid;
+  return 0;
+}
+
+/*
+ * Wait for a spawned process to finish.
+ * 
+ * Parameters:
+ * 
+ *   pProc - the process
+ * 
+ *   pStatus - receives the exit status, or 128 plus the signal number
+ *   if the process was killed by a signal; may be NULL
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_spawn_wait(aks_proc *pProc, int *pStatus) {
+  
+  pid_t r = 0;
+  int st = 0;
+  
+  do {
+    r = waitpid(pProc->pid, &st, 0);
+  } while ((r < 0) && (errno == EINTR));
+  
+  if (r < 0) {
+    return -1;
+  }
+  
+  if (pStatus != NULL) {
+    if (WIFSIGNALED(st)) {
+      *pStatus = 128 + WTERMSIG(st);
+    } else {
+      *pStatus = WEXITSTATUS(st);
+    }
+  }
+  
+  return 0;
+}
+
+/*
+ * Create a pipe whose descriptors are not inherited by child processes.
+ * 
+ * On Linux, the kernel buffer is enlarged towards AKS_PIPE_BUFSIZE.
+ * 
+ * Parameters:
+ * 
+ *   fd - receives the read and write descriptors
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_spawn_mkpipe(int fd[2]) {
+  
+#ifdef AKS_SPAWN_PIPE2
+  if (pipe2(fd, O_CLOEXEC) != 0) {
+    return -1;
+  }
+#else
+  if (pipe(fd) != 0) {
+    return -1;
+  }
+  fcntl(fd[0], F_SETFD, FD_CLOEXEC);
+  fcntl(fd[1], F_SETFD, FD_CLOEXEC);
+#endif
+  
+  /* A larger buffer lets the child run further ahead of the reader;
+   * the kernel may refuse or round the size, which is harmless */
+#ifdef F_SETPIPE_SZ
+  fcntl(fd[0], F_SETPIPE_SZ, AKS_PIPE_BUFSIZE);
+#endif
+  
+  return 0;
+}
+
+#endif
+
+/*
+ * Close a descriptor.
+ */
+#define aks_spawn_closefd(fd) close(fd)
+
+/*
+ * Open a binary-mode stream on a descriptor.
+ * 
+ * fdopen() is only declared when POSIX declarations are visible, so
+ * aks_spawn_pipe() is only defined then.
+ */
+#if AKS_POSIX_DECL >= 1
+#define AKS_SPAWN_STREAMS
+#define aks_spawn_fdopen(fd) fdopen((fd), "rb")
+#endif
+
+#else
+/* Windows implementation of process spawning ======================= */
+
+#include <fcntl.h>
+#include <io.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+/*
+ * A spawned process.
+ */
+typedef struct {
+  HANDLE h;
+} aks_proc;
+
+#ifdef AKS_BODIES
+
+/*
+ * Build a UTF-8 command line from an argument list, quoting each
+ * argument so that the C runtime of the child splits it back into the
+ * same list.
+ * 
+ * Parameters:
+ * 
+ *   argv - the NULL-terminated argument list
+ * 
+ * Return:
+ * 
+ *   the dynamically allocated command line, or NULL if error
+ */
+AKS_INTERNAL char *aks_spawn_cmdline(const char * const *argv) {
+  
+  char *pLine = NULL;
+  const char *pa = NULL;
+  size_t cap = 1;
+  size_t n = 0;
+  size_t bs = 0;
+  size_t i = 0;
+  size_t j = 0;
+  
+  /* Quoting at most doubles each argument, plus quotes and a space */
+  for(i = 0; argv[i] != NULL; i++) {
+    cap += 2 * strlen(argv[i]) + 3;
+  }
+  pLine = (char *) malloc(cap);
+  if (pLine == NULL) {
+    return NULL;
+  }
+  
+  for(i = 0; argv[i] != NULL; i++) {
+    pa = argv[i];
+    if (i > 0) {
+      pLine[n++] = ' ';
+    }
+    
+    /* Arguments without blanks or quotes go in unchanged */
+    if ((pa[0] != 0) && (strpbrk(pa, " \t\n\v\"") == NULL)) {
+      for(j = 0; pa[j] != 0; j++) {
+        pLine[n++] = pa[j];
+      }
+      continue;
+    }
+    
+    /* Otherwise quote the argument, doubling backslashes that precede a
+     * quote or the closing quote, and escaping embedded quotes */
+    pLine[n++] = '"';
+    bs = 0;
+    for(j = 0; ; j++) {
+      if (pa[j] == '\\') {
+        bs++;
+        continue;
+      }
+      if ((pa[j] == 0) || (pa[j] == '"')) {
+        bs = 2 * bs + ((pa[j] == '"') ? 1 : 0);
+      }
+      for( ; bs > 0; bs--) {
+        pLine[n++] = '\\';
+      }
+      if (pa[j] == 0) {
+        break;
+      }
+      pLine[n++] = pa[j];
+    }
+    pLine[n++] = '"';
+  }
+  
+  pLine[n] = 0;
+  return pLine;
+}
+
+/*
+ * Build an environment block from an environment list.
+ * 
+ * Parameters:
+ * 
+ *   envp - the NULL-terminated UTF-8 environment list
+ * 
+ * Return:
+ * 
+ *   the dynamically allocated block in the generic character type, or
+ *   NULL if error
+ */
+AKS_INTERNAL aks_tchar *aks_spawn_envblock(const char * const *envp) {
+  
+  char *pBlock = NULL;
+  size_t len = 0;
+  size_t n = 0;
+  size_t i = 0;
+#ifdef UNICODE
+  aks_tchar *pt = NULL;
+  int wlen = 0;
+#endif
+  
+  /* Join the strings, each with its terminating null, and close the
+   * block with another null; an empty block needs two */
+  for(i = 0; envp[i] != NULL; i++) {
+    len += strlen(envp[i]) + 1;
+  }
+  pBlock = (char *) malloc(len + 2);
+  if (pBlock == NULL) {
+    return NULL;
+  }
+  for(i = 0; envp[i] != NULL; i++) {
+    len = strlen(envp[i]) + 1;
+    memcpy(pBlock + n, envp[i], len);
+    n += len;
+  }
+  pBlock[n++] = 0;
+  if (n < 2) {
+    pBlock[n++] = 0;
+  }
+  
+#ifdef UNICODE
+  /* Translate the whole block at once, nulls included */
+  wlen = MultiByteToWideChar(
+          CP_UTF8, MB_ERR_INVALID_CHARS, pBlock, (int) n, NULL, 0);
+  if (wlen > 0) {
+    pt = (aks_tchar *) malloc(((size_t) wlen) * sizeof(aks_tchar));
+    if (pt != NULL) {
+      if (MultiByteToWideChar(
+            CP_UTF8, MB_ERR_INVALID_CHARS,
+            pBlock, (int) n, pt, wlen) != wlen) {
+        free(pt);
+        pt = NULL;
+      }
+    }
+  }
+  free(pBlock);
+  return pt;
+  
+#else
+  return pBlock;
+#endif
+}
+
+/*
+ * Get an inheritable handle for a standard stream of the child.
+ * 
+ * Parameters:
+ * 
+ *   fd - the descriptor to redirect the stream to, or -1 to use the
+ *   current standard stream
+ * 
+ *   which - the STD_ constant of the current standard stream
+ * 
+ *   ph - receives the handle, which is NULL if there is no current
+ *   standard stream
+ * 
+ * Return:
+ * 
+ *   non-zero if successful, zero if error
+ */
+AKS_INTERNAL int aks_spawn_handle(int fd, DWORD which, HANDLE *ph) {
+  
+  HANDLE h = NULL;
+  
+  *ph = NULL;
+  
+  if (fd >= 0) {
+    h = (HANDLE) _get_osfhandle(fd);
+    if (h == INVALID_HANDLE_VALUE) {
+      return 0;
+    }
+  } else {
+    h = GetStdHandle(which);
+    if ((h == NULL) || (h == INVALID_HANDLE_VALUE)) {
+      return 1;
+    }
+  }
+  
+  if (!DuplicateHandle(
+        GetCurrentProcess(),
+        h,
+        GetCurrentProcess(),
+        ph,
+        0,
+        TRUE,
+        DUPLICATE_SAME_ACCESS)) {
+    *ph = NULL;
+    return (fd < 0);
+  }
+  
+  return 1;
+}
+
+/*
+ * Start a program without going through the shell.
+ * 
+ * The program is found on the PATH if argv[0] has no path.  On Windows
+ * the arguments are quoted into a command line following the rules of
+ * the Microsoft C runtime and the child is started with
+ * CreateProcess().
+ * 
+ * Parameters:
+ * 
+ *   argv - the NULL-terminated UTF-8 argument list, starting with the
+ *   program name
+ * 
+ *   envp - the NULL-terminated UTF-8 environment list, or NULL to pass
+ *   on the current environment
+ * 
+ *   pOpts - the stream redirections, or NULL to inherit all
+ * 
+ *   pProc - receives the new process
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_spawn(
+    const char * const       * argv,
+    const char * const       * envp,
+    const aks_spawn_opts     * pOpts,
+          aks_proc           * pProc) {
+  
+  STARTUPINFO si;
+  PROCESS_INFORMATION pi;
+  HANDLE hs[3];
+  char *pLine = NULL;
+  aks_tchar *pCmd = NULL;
+  aks_tchar *pEnv = NULL;
+  DWORD flags = 0;
+  int ok = 1;
+  int i = 0;
+  
+  memset(&si, 0, sizeof(STARTUPINFO));
+  memset(&pi, 0, sizeof(PROCESS_INFORMATION));
+  
+  /* Build the command line and environment */
+  pLine = aks_spawn_cmdline(argv);
+  if (pLine != NULL) {
+    pCmd = aks_toapi(pLine);
+    free(pLine);
+    pLine = NULL;
+  }
+  if (pCmd == NULL) {
+    ok = 0;
+  }
+  if (ok && (envp != NULL)) {
+    pEnv = aks_spawn_envblock(envp);
+    if (pEnv == NULL) {
+      ok = 0;
+    }
+#ifdef UNICODE
+    flags |= CREATE_UNICODE_ENVIRONMENT;
+#endif
+  }
+  
+  /* Get inheritable handles for the standard streams */
+  hs[0] = NULL;
+  hs[1] = NULL;
+  hs[2] = NULL;
+  if (ok) {
+    ok = aks_spawn_handle(
+          (pOpts != NULL) ? pOpts->fd_in : -1, STD_INPUT_HANDLE, &(hs[0]));
+  }
+  if (ok) {
+    ok = aks_spawn_handle(
+          (pOpts != NULL) ? pOpts->fd_out : -1, STD_OUTPUT_HANDLE, &(hs[1]));
+  }
+  if (ok) {
+    ok = aks_spawn_handle(
+          (pOpts != NULL) ? pOpts->fd_err : -1, STD_ERROR_HANDLE, &(hs[2]));
+  }
+  
+  /* Start the process */
+  if (ok) {
+    si.cb = sizeof(STARTUPINFO);
+    si.dwFlags = STARTF_USESTDHANDLES;
+    si.hStdInput = hs[0];
+    si.hStdOutput = hs[1];
+    si.hStdError = hs[2];
+    if (CreateProcess(
+          NULL, pCmd, NULL, NULL, TRUE, flags, pEnv, NULL, &si, &pi)) {
+      CloseHandle(pi.hThread);
+      pProc->h = pi.hProcess;
+    } else {
+      ok = 0;
+    }
+  }
+  
+  /* Release everything the child has its own copy of */
+  for(i = 0; i < 3; i++) {
+    if (hs[i] != NULL) {
+      CloseHandle(hs[i]);
+    }
+  }
+  free(pCmd);
+  free(pEnv);
+  
+  return ok ? 0 : -1;
+}
+
+/*
+ * Wait for a spawned process to finish.
+ * 
+ * Parameters:
+ * 
+ *   pProc - the process
+ * 
+ *   pStatus - receives the exit code; may be NULL
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_spawn_wait(aks_proc *pProc, int *pStatus) {
+  
+  DWORD code = 0;
+  
+  if (WaitForSingleObject(pProc->h, INFINITE) != WAIT_OBJECT_0) {
+    return -1;
+  }
+  if (!GetExitCodeProcess(pProc->h, &code)) {
+    return -1;
+  }
+  CloseHandle(pProc->h);
+  pProc->h = NULL;
+  
+  if (pStatus != NULL) {
+    *pStatus = (int) code;
+  }
+  
+  return 0;
+}
+
+/*
+ * Create a binary-mode pipe whose descriptors are not inherited by
+ * child processes, with a kernel buffer of AKS_PIPE_BUFSIZE bytes.
+ * 
+ * Parameters:
+ * 
+ *   fd - receives the read and write descriptors
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_spawn_mkpipe(int fd[2]) {
+  
+  HANDLE hr = NULL;
+  HANDLE hw = NULL;
+  
+  if (!CreatePipe(&hr, &hw, NULL, AKS_PIPE_BUFSIZE)) {
+    return -1;
+  }
+  
+  fd[0] = _open_osfhandle((intptr_t) hr, _O_RDONLY | _O_BINARY);
+  if (fd[0] < 0) {
+    CloseHandle(hr);
+    CloseHandle(hw);
+    return -1;
+  }
+  
+  fd[1] = _open_osfhandle((intptr_t) hw, _O_WRONLY | _O_BINARY);
+  if (fd[1] < 0) {
+    _close(fd[0]);
+    CloseHandle(hw);
+    return -1;
+  }
+  
+  return 0;
+}
+
+#endif
+
+/*
+ * Close a descriptor.
+ */
+#define aks_spawn_closefd(fd) _close(fd)
+
+/*
+ * Open a binary-mode stream on a descriptor.
+ */
+#define AKS_SPAWN_STREAMS
+#define aks_spawn_fdopen(fd) _fdopen((fd), "rb")
+
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Start a program without going through the shell, capturing its
+ * standard output, standard error, or both through pipes.
+ * 
+ * The child inherits standard input.  If both streams are captured
+ * separately, the caller must drain both pipes concurrently, or the
+ * child may block on a full pipe; use AKS_SPAWN_MERGE to avoid that.
+ * 
+ * Parameters:
+ * 
+ *   argv - the NULL-terminated UTF-8 argument list, starting with the
+ *   program name
+ * 
+ *   envp - the NULL-terminated UTF-8 environment list, or NULL to pass
+ *   on the current environment
+ * 
+ *   which - AKS_SPAWN_STDOUT, AKS_SPAWN_STDERR, or both, optionally
+ *   with AKS_SPAWN_MERGE
+ * 
+ *   pProc - receives the new process
+ * 
+ *   pfdOut - receives the read descriptor of standard output, or -1 if
+ *   it is not captured; may be NULL if it is not captured
+ * 
+ *   pfdErr - receives the read descriptor of standard error, or -1 if
+ *   it is not captured separately; may be NULL if it is not captured
+ *   separately
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_spawn_pipefd(
+    const char * const   * argv,
+    const char * const   * envp,
+          int              which,
+          aks_proc       * pProc,
+          int            * pfdOut,
+          int            * pfdErr) {
+  
+  aks_spawn_opts opts;
+  int po[2];
+  int pe[2];
+  int ok = 1;
+  
+  po[0] = -1;
+  po[1] = -1;
+  pe[0] = -1;
+  pe[1] = -1;
+  aks_spawn_opts_init(&opts);
+  
+  if (which & AKS_SPAWN_MERGE) {
+    which |= AKS_SPAWN_STDOUT;
+    which &= ~AKS_SPAWN_STDERR;
+  }
+  
+  /* Create the pipes and point the child streams at their write ends */
+  if (which & AKS_SPAWN_STDOUT) {
+    if (aks_spawn_mkpipe(po) == 0) {
+      opts.fd_out = po[1];
+      if (which & AKS_SPAWN_MERGE) {
+        opts.fd_err = po[1];
+      }
+    } else {
+      ok = 0;
+    }
+  }
+  if (ok && (which & AKS_SPAWN_STDERR)) {
+    if (aks_spawn_mkpipe(pe) == 0) {
+      opts.fd_err = pe[1];
+    } else {
+      ok = 0;
+    }
+  }
+  
+  if (ok) {
+    if (aks_spawn(argv, envp, &opts, pProc) != 0) {
+      ok = 0;
+    }
+  }
+  
+  /* The child has its own copies of the write ends, so close ours so
+   * that the reader sees end of file when the child finishes */
+  if (po[1] >= 0) {
+    aks_spawn_closefd(po[1]);
+  }
+  if (pe[1] >= 0) {
+    aks_spawn_closefd(pe[1]);
+  }
+  if (!ok) {
+    if (po[0] >= 0) {
+      aks_spawn_closefd(po[0]);
+      po[0] = -1;
+    }
+    if (pe[0] >= 0) {
+      aks_spawn_closefd(pe[0]);
+      pe[0] = -1;
+    }
+  }
+  
+  if (pfdOut != NULL) {
+    *pfdOut = po[0];
+  }
+  if (pfdErr != NULL) {
+    *pfdErr = pe[0];
+  }
+  
+  return ok ? 0 : -1;
+}
+
+#ifdef AKS_SPAWN_STREAMS
+
+/*
+ * Start a program without going through the shell, capturing its
+ * standard output, standard error, or both as binary-mode streams.
+ * 
+ * This is aks_spawn_pipefd() with each captured descriptor wrapped in
+ * a stream opened for binary reading.  On POSIX it is only defined
+ * where fdopen() is declared, which strict modes such as -std=c99 only
+ * do with a POSIX feature test macro.
+ * 
+ * Parameters:
+ * 
+ *   argv - the NULL-terminated UTF-8 argument list, starting with the
+ *   program name
+ * 
+ *   envp - the NULL-terminated UTF-8 environment list, or NULL to pass
+ *   on the current environment
+ * 
+ *   which - AKS_SPAWN_STDOUT, AKS_SPAWN_STDERR, or both, optionally
+ *   with AKS_SPAWN_MERGE
+ * 
+ *   pProc - receives the new process
+ * 
+ *   ppOut - receives the standard output stream, or NULL if it is not
+ *   captured; may be NULL if it is not captured
+ * 
+ *   ppErr - receives the standard error stream, or NULL if it is not
+ *   captured separately; may be NULL if it is not captured separately
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_spawn_pipe(
+    const char * const   * argv,
+    const char * const   * envp,
+          int              which,
+          aks_proc       * pProc,
+          FILE          ** ppOut,
+          FILE          ** ppErr) {
+  
+  FILE *fo = NULL;
+  FILE *fe = NULL;
+  int fdo = -1;
+  int fde = -1;
+  int ok = 1;
+  
+  if (aks_spawn_pipefd(argv, envp, which, pProc, &fdo, &fde) != 0) {
+    return -1;
+  }
+  
+  /* Wrap the descriptors */
+  if (fdo >= 0) {
+    fo = aks_spawn_fdopen(fdo);
+    if (fo == NULL) {
+      aks_spawn_closefd(fdo);
+      ok = 0;
+    }
+  }
+  if (fde >= 0) {
+    fe = aks_spawn_fdopen(fde);
+    if (fe == NULL) {
+      aks_spawn_closefd(fde);
+      ok = 0;
+    }
+  }
+  
+  /* On failure, close the pipes so that the child cannot block writing
+   * to them, and reap it */
+  if (!ok) {
+    if (fo != NULL) {
+      fclose(fo);
+      fo = NULL;
+    }
+    if (fe != NULL) {
+      fclose(fe);
+      fe = NULL;
+    }
+    aks_spawn_wait(pProc, NULL);
+    return -1;
+  }
+  
+  if (ppOut != NULL) {
+    *ppOut = fo;
+  }
+  if (ppErr != NULL) {
+    *ppErr = fe;
+  }
+  
+  return 0;
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+AKS_API void aks_spawn_opts_init(aks_spawn_opts *pOpts);
+AKS_API int aks_spawn(
+    const char * const       * argv,
+    const char * const       * envp,
+    const aks_spawn_opts     * pOpts,
+          aks_proc           * pProc);
+AKS_API int aks_spawn_wait(aks_proc *pProc, int *pStatus);
+AKS_API int aks_spawn_pipefd(
+    const char * const   * argv,
+    const char * const   * envp,
+          int              which,
+          aks_proc       * pProc,
+          int            * pfdOut,
+          int            * pfdErr);
+#ifdef AKS_SPAWN_STREAMS
+AKS_API int aks_spawn_pipe(
+    const char * const   * argv,
+    const char * const   * envp,
+          int              which,
+          aks_proc       * pProc,
+          FILE          ** ppOut,
+          FILE          ** ppErr);
+#endif
+
+#endif
+#endif
+
+/* * * * * * * * * *
+ *                 *
+ * Durable writes  *
+ *                 *
+ * * * * * * * * * */
+
+/* Only proceed if durable writes requested and not already defined */
+#ifdef AKS_SYNC
+#ifndef AKS_SYNC_INCLUDED
+#define AKS_SYNC_INCLUDED
+
+#ifdef AKS_POSIX
+/* POSIX implementation of durable writes =========================== */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* The stream functions need fileno(), which is only declared when
+ * POSIX declarations are visible */
+#if AKS_POSIX_DECL >= 1
+#define AKS_SYNC_STREAMS
+#endif
+
+/* On Linux, flush whole file systems with syncfs() if it is declared,
+ * and flush only the data of files with fdatasync() if it is declared,
+ * which takes the POSIX.1b revision */
+#ifdef __linux__
+#if AKS_POSIX_DECL >= 199309L
+#define AKS_SYNC_FDATASYNC
+#endif
+#ifdef _GNU_SOURCE
+#define AKS_SYNC_SYNCFS
+#endif
+#endif
+
+#ifdef AKS_BODIES
+
+#ifdef AKS_SYNC_STREAMS
+
+/*
+ * Flush a stream and force its file to stable storage.
+ * 
+ * On macOS, F_FULLFSYNC is used so that the drive cache is flushed as
+ * well.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_fsync(FILE *fp) {
+  
+  if (fflush(fp) != 0) {
+    return -1;
+  }
+  
+#ifdef F_FULLFSYNC
+  if (fcntl(fileno(fp), F_FULLFSYNC) == 0) {
+    return 0;
+  }
+#endif
+  
+  return fsync(fileno(fp));
+}
+
+/*
+ * Flush a stream and force the data of its file to stable storage,
+ * skipping metadata such as the modification time where the platform
+ * allows.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_fdatasync(FILE *fp) {
+  
+  if (fflush(fp) != 0) {
+    return -1;
+  }
+  
+#ifdef AKS_SYNC_FDATASYNC
+  return fdatasync(fileno(fp));
+#else
+  return aks_fsync(fp);
+#endif
+}
+
+/*
+ * Flush many streams and force their files to stable storage.
+ * 
+ * On Linux with _GNU_SOURCE, each distinct file system is flushed once
+ * with syncfs() instead of issuing a barrier per file.  Elsewhere each
+ * file is synchronized in turn.
+ * 
+ * Parameters:
+ * 
+ *   ppFile - the streams
+ * 
+ *   n - the number of streams
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_sync_many(FILE **ppFile, size_t n) {
+  
+#ifdef AKS_SYNC_SYNCFS
+  struct stat st;
+  dev_t *pDev = NULL;
+  size_t ndev = 0;
+  size_t j = 0;
+#endif
+  size_t i = 0;
+  int result = 0;
+  
+  /* Push all buffered data into the kernel first */
+  for(i = 0; i < n; i++) {
+    if (fflush(ppFile[i]) != 0) {
+      result = -1;
+    }
+  }
+  if (result != 0) {
+    return -1;
+  }
+  
+#ifdef AKS_SYNC_SYNCFS
+  /* Flush each file system once, through the first file on it */
+  pDev = (dev_t *) malloc((n + 1) * sizeof(dev_t));
+  if (pDev != NULL) {
+    for(i = 0; i < n; i++) {
+      if (fstat(fileno(ppFile[i]), &st) != 0) {
+        result = -1;
+        break;
+      }
+      for(j = 0; j < ndev; j++) {
+        if (pDev[j] == st.st_dev) {
+          break;
+        }
+      }
+      if (j < ndev) {
+        continue;
+      }
+      pDev[ndev++] = st.st_dev;
+      if (syncfs(fileno(ppFile[i])) != 0) {
+        result = -1;
+        break;
+      }
+    }
+    free(pDev);
+    return result;
+  }
+#endif
+  
+  for(i = 0; i < n; i++) {
+    if (aks_fsync(ppFile[i]) != 0) {
+      result = -1;
+    }
+  }
+  
+  return result;
+}
+
+#endif
+
+/*
+ * Atomically replace a file with another and make the change durable.
+ * 
+ * The contents of the new file should already have been forced to
+ * stable storage, for example with aks_fsync().  On POSIX the new file
+ * is renamed over the destination and then the directory holding the
+ * destination is synchronized, so that the rename survives a crash.
+ * 
+ * Parameters:
+ * 
+ *   pTmp - the UTF-8 path of the new file
+ * 
+ *   pDst - the UTF-8 path of the file to replace
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_atomic_replace(const char *pTmp, const char *pDst) {
+  
+  const char *pSlash = NULL;
+  char *pDir = NULL;
+  size_t len = 0;
+  int flags = O_RDONLY;
+  int fd = -1;
+  int result = 0;
+  
+  if (rename(pTmp, pDst) != 0) {
+    return -1;
+  }
+  
+  /* Get the directory holding the destination */
+  pSlash = strrchr(pDst, '/');
+  if (pSlash == NULL) {
+    pDir = (char *) malloc(2);
+    if (pDir != NULL) {
+      strcpy(pDir, ".");
+    }
+  } else {
+    len = (size_t) (pSlash - pDst);
+    if (len < 1) {
+      len = 1;
+    }
+    pDir = (char *) malloc(len + 1);
+    if (pDir != NULL) {
+      memcpy(pDir, pDst, len);
+      pDir[len] = 0;
+    }
+  }
+  if (pDir == NULL) {
+    return -1;
+  }
+  
+  /* Synchronize the directory; some file systems cannot, and report
+   * EINVAL, in which case there is nothing more to do */
+#ifdef O_DIRECTORY
+  flags |= O_DIRECTORY;
+#endif
+  fd = open(pDir, flags);
+  if (fd >= 0) {
+    if ((fsync(fd) != 0) && (errno != EINVAL)) {
+      result = -1;
+    }
+    close(fd);
+  } else {
+    result = -1;
+  }
+  
+  free(pDir);
+  return result;
+}
+
+#endif
+
+#else
+/* Windows implementation of durable writes ========================= */
+
+#include <errno.h>
+#include <io.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <windows.h>
+
+#define AKS_SYNC_STREAMS
+
+#ifdef AKS_BODIES
+
+/*
+ * Flush a stream and force its file to stable storage.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_fsync(FILE *fp) {
+  
+  HANDLE h = NULL;
+  
+  if (fflush(fp) != 0) {
+    return -1;
+  }
+  
+  h = (HANDLE) _get_osfhandle(_fileno(fp));
+  if (h == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  if (!FlushFileBuffers(h)) {
+    return -1;
+  }
+  
+  return 0;
+}
+
+/*
+ * Flush a stream and force the data of its file to stable storage.
+ * 
+ * On Windows this is the same as aks_fsync().
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_fdatasync(FILE *fp) {
+  return aks_fsync(fp);
+}
+
+/*
+ * Flush many streams and force their files to stable storage.
+ * 
+ * On Windows each file is synchronized in turn.
+ * 
+ * Parameters:
+ * 
+ *   ppFile - the streams
+ * 
+ *   n - the number of streams
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_sync_many(FILE **ppFile, size_t n) {
+  
+  size_t i = 0;
+  int result = 0;
+  
+  for(i = 0; i < n; i++) {
+    if (aks_fsync(ppFile[i]) != 0) {
+      result = -1;
+    }
+  }
+  
+  return result;
+}
+
+/*
+ * Atomically replace a file with another and make the change durable.
+ * 
+ * The contents of the new file should already have been forced to
+ * stable storage, for example with aks_fsync().  On Windows the new file
+ * is moved over the destination with MoveFileEx(), which does not
+ * return until the move has been written through to disk.
+ * 
+ * Parameters:
+ * 
+ *   pTmp - the UTF-8 path of the new file
+ * 
+ *   pDst - the UTF-8 path of the file to replace
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_atomic_replace(const char *pTmp, const char *pDst) {
+  
+  aks_tchar *pt = NULL;
+  aks_tchar *pd = NULL;
+  int result = -1;
+  
+  pt = aks_toapi(pTmp);
+  pd = aks_toapi(pDst);
+  
+  if ((pt != NULL) && (pd != NULL)) {
+    if (MoveFileEx(
+          pt,
+          pd,
+          MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+      result = 0;
+    }
+  }
+  
+  if (pt != NULL) {
+    free(pt);
+    pt = NULL;
+  }
+  if (pd != NULL) {
+    free(pd);
+    pd = NULL;
+  }
+  
+  return result;
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+#ifdef AKS_SYNC_STREAMS
+AKS_API int aks_fsync(FILE *fp);
+AKS_API int aks_fdatasync(FILE *fp);
+AKS_API int aks_sync_many(FILE **ppFile, size_t n);
+#endif
+AKS_API int aks_atomic_replace(const char *pTmp, const char *pDst);
+
+#endif
+#endif
+
+/* * * * * * * * * * * * *
+ *                       *
+ * Access-pattern hints  *
+ *                       *
+ * * * * * * * * * * * * */
+
+/* Only proceed if access-pattern hints requested and not already
+ * defined */
+#ifdef AKS_ADVISE
+#ifndef AKS_ADVISE_INCLUDED
+#define AKS_ADVISE_INCLUDED
+
+/*
+ * Access-pattern hints, which may be combined.
+ */
+#define AKS_SEQUENTIAL 1
+#define AKS_RANDOM     2
+#define AKS_WILLNEED   4
+#define AKS_DONTNEED   8
+
+#ifdef AKS_POSIX
+/* POSIX implementation of access-pattern hints ===================== */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#ifdef AKS_BODIES
+
+/*
+ * Give the kernel hints about how a range of an open file will be read.
+ * 
+ * Hints are applied in the order sequential, random, will-need, and
+ * don't-need.  On platforms without posix_fadvise() this does nothing.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ *   off - the byte offset of the start of the range
+ * 
+ *   len - the length of the range in bytes, or zero for the rest of
+ *   the file
+ * 
+ *   advice - one or more of the AKS_ hint constants
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_fadvise(FILE *fp, int64_t off, int64_t len, int advice) {
+  
+#ifdef POSIX_FADV_SEQUENTIAL
+  static const int adv[4] = {
+    POSIX_FADV_SEQUENTIAL,
+    POSIX_FADV_RANDOM,
+    POSIX_FADV_WILLNEED,
+    POSIX_FADV_DONTNEED
+  };
+  int err = 0;
+  int i = 0;
+  
+  /* Ranges beyond what off_t can express are ignored */
+  if ((((int64_t) ((off_t) off)) != off) ||
+      (((int64_t) ((off_t) len)) != len)) {
+    return 0;
+  }
+  
+  for(i = 0; i < 4; i++) {
+    if (advice & (1 << i)) {
+      err = posix_fadvise(fileno(fp), (off_t) off, (off_t) len, adv[i]);
+      if (err != 0) {
+        errno = err;
+        return -1;
+      }
+    }
+  }
+  
+#else
+  (void) fp;
+  (void) off;
+  (void) len;
+  (void) advice;
+#endif
+  
+  return 0;
+}
+
+/*
+ * Give the kernel hints about how a range of mapped memory will be
+ * accessed.
+ * 
+ * The range is widened to whole pages.  Don't-need hints discard
+ * unsaved changes in private writable mappings, so only use them on
+ * read-only or shared mappings.  On platforms without madvise() this
+ * does nothing.
+ * 
+ * Parameters:
+ * 
+ *   pAddr - the start of the range
+ * 
+ *   len - the length of the range in bytes
+ * 
+ *   advice - one or more of the AKS_ hint constants
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_madvise(void *pAddr, size_t len, int advice) {
+  
+#ifdef MADV_SEQUENTIAL
+  static const int adv[4] = {
+    MADV_SEQUENTIAL,
+    MADV_RANDOM,
+    MADV_WILLNEED,
+    MADV_DONTNEED
+  };
+  uintptr_t start = 0;
+  uintptr_t psize = 0;
+  int i = 0;
+  
+  /* Round the start down to a page boundary */
+  psize = (uintptr_t) sysconf(_SC_PAGESIZE);
+  start = ((uintptr_t) pAddr) & ~(psize - 1);
+  len += (size_t) (((uintptr_t) pAddr) - start);
+  
+  for(i = 0; i < 4; i++) {
+    if (advice & (1 << i)) {
+      if (madvise((void *) start, len, adv[i]) != 0) {
+        return -1;
+      }
+    }
+  }
+  
+#else
+  (void) pAddr;
+  (void) len;
+  (void) advice;
+#endif
+  
+  return 0;
+}
+
+#endif
+
+#else
+/* Windows implementation of access-pattern hints =================== */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <windows.h>
+
+/*
+ * The memory range structure and function used to prefetch mapped
+ * memory, declared here because older SDKs lack them.
+ */
+typedef struct {
+  PVOID VirtualAddress;
+  SIZE_T NumberOfBytes;
+} aks_advise_range;
+
+typedef BOOL (WINAPI *aks_advise_prefetch_fn)(
+                        HANDLE, ULONG_PTR, aks_advise_range *, ULONG);
+
+#ifdef AKS_BODIES
+
+/*
+ * Give the system hints about how a range of an open file will be read.
+ * 
+ * Windows only accepts access-pattern hints when a file is opened, so
+ * this does nothing.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ *   off - the byte offset of the start of the range
+ * 
+ *   len - the length of the range in bytes, or zero for the rest of
+ *   the file
+ * 
+ *   advice - one or more of the AKS_ hint constants
+ * 
+ * Return:
+ * 
+ *   zero
+ */
+AKS_API int aks_fadvise(FILE *fp, int64_t off, int64_t len, int advice) {
+  (void) fp;
+  (void) off;
+  (void) len;
+  (void) advice;
+  return 0;
+}
+
+/*
+ * Give the system hints about how a range of mapped memory will be
+ * accessed.
+ * 
+ * Will-need hints prefetch the range with PrefetchVirtualMemory() on
+ * Windows 8 and later.  Don't-need hints remove the range from the
+ * working set, so that the pages are the first to be reused.
+ * Sequential and random hints are ignored.
+ * 
+ * Parameters:
+ * 
+ *   pAddr - the start of the range
+ * 
+ *   len - the length of the range in bytes
+ * 
+ *   advice - one or more of the AKS_ hint constants
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_madvise(void *pAddr, size_t len, int advice) {
+  
+  static aks_advise_prefetch_fn pfPrefetch = NULL;
+  static int looked = 0;
+  aks_advise_range r;
+  
+  if (advice & AKS_WILLNEED) {
+    
+    /* Look up the prefetch function once */
+    if (!looked) {
+      pfPrefetch = (aks_advise_prefetch_fn) GetProcAddress(
+                      GetModuleHandleA("kernel32.dll"),
+                      "PrefetchVirtualMemory");
+      looked = 1;
+    }
+    
+    if (pfPrefetch != NULL) {
+      r.VirtualAddress = pAddr;
+      r.NumberOfBytes = len;
+      if (!pfPrefetch(GetCurrentProcess(), 1, &r, 0)) {
+        return -1;
+      }
+    }
+  }
+  
+  /* Unlocking pages that are not locked trims them from the working
+   * set, which is expected to fail with ERROR_NOT_LOCKED */
+  if (advice & AKS_DONTNEED) {
+    if (!VirtualUnlock(pAddr, len)) {
+      if (GetLastError() != ERROR_NOT_LOCKED) {
+        return -1;
+      }
+    }
+  }
+  
+  return 0;
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+AKS_API int aks_fadvise(FILE *fp, int64_t off, int64_t len, int advice);
+AKS_API int aks_madvise(void *pAddr, size_t len, int advice);
+
+#endif
+#endif
+
+/* * * * * * * * * * * * *
+ *                       *
+ * Huge-page allocation  *
+ *                       *
+ * * * * * * * * * * * * */
+
+/* Only proceed if huge-page allocation requested and not already
+ * defined */
+#ifdef AKS_HUGE
+#ifndef AKS_HUGE_INCLUDED
+#define AKS_HUGE_INCLUDED
+
+/*
+ * The kinds of memory that aks_huge_alloc() may return.
+ */
+#define AKS_HUGE_NORMAL      0
+#define AKS_HUGE_TRANSPARENT 1
+#define AKS_HUGE_EXPLICIT    2
+
+#ifdef AKS_POSIX
+/* POSIX implementation of huge-page allocation ===================== */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+
+/*
+ * The huge page size that allocations are rounded up and aligned to.
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_HUGE_PAGESIZE
+#define AKS_HUGE_PAGESIZE 2097152
+#endif
+
+/* Some systems only have the older name for anonymous mappings, and
+ * strict standard modes may declare neither, in which case /dev/zero is
+ * mapped instead */
+#ifdef MAP_ANONYMOUS
+#define AKS_HUGE_ANON MAP_ANONYMOUS
+#else
+#ifdef MAP_ANON
+#define AKS_HUGE_ANON MAP_ANON
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Map private zero-filled memory.
+ * 
+ * Parameters:
+ * 
+ *   len - the length in bytes
+ * 
+ *   flags - extra mapping flags
+ * 
+ * Return:
+ * 
+ *   the mapping, or MAP_FAILED if error
+ */
+AKS_INTERNAL void *aks_huge_map(size_t len, int flags) {
+  
+#ifdef AKS_HUGE_ANON
+  return mmap(NULL, len, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | AKS_HUGE_ANON | flags, -1, 0);
+  
+#else
+  void *p = MAP_FAILED;
+  int fd = -1;
+  
+  fd = open("/dev/zero", O_RDWR);
+  if (fd >= 0) {
+    p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | flags, fd, 0);
+    close(fd);
+  }
+  return p;
+#endif
+}
+
+/*
+ * Allocate a large zero-filled buffer, backed by huge pages if
+ * possible.
+ * 
+ * On Linux, explicit huge pages from the hugetlbfs pool are tried
+ * first, then a huge-page-aligned mapping marked for transparent huge
+ * pages, then ordinary pages.
+ * 
+ * Parameters:
+ * 
+ *   size - the size in bytes, which is rounded up to a multiple of
+ *   AKS_HUGE_PAGESIZE
+ * 
+ *   pBacking - receives one of the AKS_HUGE_ backing constants; may be
+ *   NULL
+ * 
+ * Return:
+ * 
+ *   the buffer, or NULL if error
+ */
+AKS_API void *aks_huge_alloc(size_t size, int *pBacking) {
+  
+  void *p = NULL;
+  size_t len = 0;
+  uintptr_t a = 0;
+  uintptr_t b = 0;
+  
+  if ((size < 1) || (size > ((size_t) -1) - 2 * AKS_HUGE_PAGESIZE)) {
+    return NULL;
+  }
+  len = (size + AKS_HUGE_PAGESIZE - 1) &
+          ~((size_t) (AKS_HUGE_PAGESIZE - 1));
+  
+  /* Try explicit huge pages */
+#ifdef MAP_HUGETLB
+  p = aks_huge_map(len, MAP_HUGETLB);
+  if (p != MAP_FAILED) {
+    if (pBacking != NULL) {
+      *pBacking = AKS_HUGE_EXPLICIT;
+    }
+    return p;
+  }
+#endif
+  
+  /* Map an extra huge page so that the buffer can start on a huge page
+   * boundary, and give back the unused head and tail */
+  p = aks_huge_map(len + AKS_HUGE_PAGESIZE, 0);
+  if (p == MAP_FAILED) {
+    return NULL;
+  }
+  a = (uintptr_t) p;
+  b = (a + AKS_HUGE_PAGESIZE - 1) & ~((uintptr_t) (AKS_HUGE_PAGESIZE - 1));
+  if (b > a) {
+    munmap(p, (size_t) (b - a));
+  }
+  if (b - a < AKS_HUGE_PAGESIZE) {
+    munmap((void *) (b + len), (size_t) (AKS_HUGE_PAGESIZE - (b - a)));
+  }
+  p = (void *) b;
+  
+  /* Ask for transparent huge pages */
+  if (pBacking != NULL) {
+    *pBacking = AKS_HUGE_NORMAL;
+  }
+#ifdef MADV_HUGEPAGE
+  if (madvise(p, len, MADV_HUGEPAGE) == 0) {
+    if (pBacking != NULL) {
+      *pBacking = AKS_HUGE_TRANSPARENT;
+    }
+  }
+#endif
+  
+  return p;
+}
+
+/*
+ * Free a buffer allocated with aks_huge_alloc().
+ * 
+ * Parameters:
+ * 
+ *   p - the buffer, or NULL
+ * 
+ *   size - the size that was passed to aks_huge_alloc()
+ */
+AKS_API void aks_huge_free(void *p, size_t size) {
+  if (p != NULL) {
+    munmap(p, (size + AKS_HUGE_PAGESIZE - 1) &
+                ~((size_t) (AKS_HUGE_PAGESIZE - 1)));
+  }
+}
+
+#endif
+
+#else
+/* Windows implementation of huge-page allocation =================== */
+
+#include <stddef.h>
+#include <windows.h>
+
+/* Enabling the lock memory privilege needs the advapi32 library */
+#ifdef _MSC_VER
+#pragma comment(lib, "advapi32.lib")
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Enable the lock memory privilege for the process, which large pages
+ * require.  The account must have been granted the privilege.
+ * 
+ * Return:
+ * 
+ *   non-zero if the privilege is enabled, zero if not
+ */
+AKS_INTERNAL int aks_huge_privilege(void) {
+  
+  HANDLE hToken = NULL;
+  TOKEN_PRIVILEGES tp;
+  int result = 0;
+  
+  if (!OpenProcessToken(
+        GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES, &hToken)) {
+    return 0;
+  }
+  
+  tp.PrivilegeCount = 1;
+  tp.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+  if (LookupPrivilegeValue(
+        NULL, SE_LOCK_MEMORY_NAME, &(tp.Privileges[0].Luid))) {
+    
+    /* The call succeeds even if the privilege was not granted, so
+     * check the last error as well */
+    if (AdjustTokenPrivileges(hToken, FALSE, &tp, 0, NULL, NULL)) {
+      if (GetLastError() == ERROR_SUCCESS) {
+        result = 1;
+      }
+    }
+  }
+  
+  CloseHandle(hToken);
+  return result;
+}
+
+/*
+ * Allocate a large zero-filled buffer, backed by large pages if
+ * possible.
+ * 
+ * On Windows, large pages need the "Lock pages in memory" privilege,
+ * which is enabled on the first call.  Without it, ordinary pages are
+ * used.
+ * 
+ * Parameters:
+ * 
+ *   size - the size in bytes
+ * 
+ *   pBacking - receives one of the AKS_HUGE_ backing constants; may be
+ *   NULL
+ * 
+ * Return:
+ * 
+ *   the buffer, or NULL if error
+ */
+AKS_API void *aks_huge_alloc(size_t size, int *pBacking) {
+  
+  static int privilege = -1;
+  void *p = NULL;
+  size_t lps = 0;
+  size_t len = 0;
+  
+  if (size < 1) {
+    return NULL;
+  }
+  
+  if (privilege < 0) {
+    privilege = aks_huge_privilege();
+  }
+  
+  /* Try large pages, with the size rounded up to the large page size */
+  lps = (size_t) GetLargePageMinimum();
+  if (privilege && (lps > 0) && (size <= ((size_t) -1) - lps)) {
+    len = (size + lps - 1) & ~(lps - 1);
+    p = VirtualAlloc(
+          NULL,
+          len,
+          MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES,
+          PAGE_READWRITE);
+    if (p != NULL) {
+      if (pBacking != NULL) {
+        *pBacking = AKS_HUGE_EXPLICIT;
+      }
+      return p;
+    }
+  }
+  
+  /* Fall back to ordinary pages */
+  p = VirtualAlloc(NULL, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+  if ((p != NULL) && (pBacking != NULL)) {
+    *pBacking = AKS_HUGE_NORMAL;
+  }
+  
+  return p;
+}
+
+/*
+ * Free a buffer allocated with aks_huge_alloc().
+ * 
+ * Parameters:
+ * 
+ *   p - the buffer, or NULL
+ * 
+ *   size - the size that was passed to aks_huge_alloc()
+ */
+AKS_API void aks_huge_free(void *p, size_t size) {
+  (void) size;
+  if (p != NULL) {
+    VirtualFree(p, 0, MEM_RELEASE);
+  }
+}
+
+#endif
+
+#endif
+
+/* Public function declarations */
+AKS_API void *aks_huge_alloc(size_t size, int *pBacking);
+AKS_API void aks_huge_free(void *p, size_t size);
+
+#endif
+#endif
+
+/* * * * * * * * * *
+ *                 *
+ * Lock-free rings *
+ *                 *
+ * * * * * * * * * */
+
+/* If AKS_TRACE selected, define AKS_RING if not already defined */
+#ifdef AKS_TRACE
+#ifndef AKS_RING
+#define AKS_RING
+#endif
+#endif
+
+/* Only proceed if lock-free rings requested and not already defined */
+#ifdef AKS_RING
+#ifndef AKS_RING_INCLUDED
+#define AKS_RING_INCLUDED
+
+#include <stddef.h>
+#include <stdlib.h>
+
+/*
+ * The cache line size that the shared indices are padded to.  May be
+ * overridden by defining it before including the header.
+ */
+#ifndef AKS_RING_CACHELINE
+#define AKS_RING_CACHELINE 64
+#endif
+
+/* Select the atomic primitives; GCC 4.7 and later and Clang define the
+ * memory order macros for their atomic built-ins */
+#ifdef __ATOMIC_ACQUIRE
+#define AKS_RING_GNU
+#else
+#ifdef _MSC_VER
+#define AKS_RING_MSVC
+#include <intrin.h>
+#ifdef _M_IX86
+#define AKS_RING_MSVC_TSO
+#endif
+#ifdef _M_X64
+#define AKS_RING_MSVC_TSO
+#endif
+#else
+#error aksmacro: AKS_RING needs GCC, Clang, or Microsoft atomics.
+#endif
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Load an index with acquire ordering.
+ */
+AKS_INTERNAL size_t aks_ring_load(volatile size_t *p) {
+#ifdef AKS_RING_GNU
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+#else
+#ifdef AKS_RING_MSVC_TSO
+  size_t v = *p;
+  _ReadWriteBarrier();
+  return v;
+#else
+#ifdef _WIN64
+  return (size_t) _InterlockedOr64((volatile __int64 *) p, 0);
+#else
+  return (size_t) _InterlockedOr((volatile long *) p, 0);
+#endif
+#endif
+#endif
+}
+
+/*
+ * Store an index with release ordering.
+ */
+AKS_INTERNAL void aks_ring_store(volatile size_t *p, size_t v) {
+#ifdef AKS_RING_GNU
+  __atomic_store_n(p, v, __ATOMIC_RELEASE);
+#else
+#ifdef AKS_RING_MSVC_TSO
+  _ReadWriteBarrier();
+  *p = v;
+#else
+#ifdef _WIN64
+  _InterlockedExchange64((volatile __int64 *) p, (__int64) v);
+#else
+  _InterlockedExchange((volatile long *) p, (long) v);
+#endif
+#endif
+#endif
+}
+
+/*
+ * Replace an index if it still has the expected value.
+ * 
+ * Return:
+ * 
+ *   non-zero if the index was replaced, zero if not
+ */
+AKS_INTERNAL int aks_ring_cas(volatile size_t *p, size_t expect, size_t v) {
+#ifdef AKS_RING_GNU
+  return __atomic_compare_exchange_n(
+            p, &expect, v, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#else
+#ifdef _WIN64
+  return (_InterlockedCompareExchange64(
+            (volatile __int64 *) p, (__int64) v, (__int64) expect) ==
+              (__int64) expect);
+#else
+  return (_InterlockedCompareExchange(
+            (volatile long *) p, (long) v, (long) expect) ==
+              (long) expect);
+#endif
+#endif
+}
+
+/*
+ * Round a capacity up to a power of two, or return zero if it is too
+ * large.
+ */
+AKS_INTERNAL size_t aks_ring_capacity(size_t n) {
+  
+  size_t c = 2;
+  
+  while (c < n) {
+    c <<= 1;
+    if (c == 0) {
+      return 0;
+    }
+  }
+  
+  return c;
+}
+
+#endif
+
+/*
+ * A single-producer, single-consumer ring of pointers.
+ * 
+ * Each index sits on its own cache line together with the other side's
+ * index as last seen, so that the two threads only touch each other's
+ * line when the ring looks full or empty.
+ */
+typedef struct {
+  
+  char pad0[AKS_RING_CACHELINE];
+  
+  /* Producer line: the next slot to write, and the consumer index as
+   * the producer last read it */
+  volatile size_t head;
+  size_t tail_seen;
+  
+  char pad1[AKS_RING_CACHELINE];
+  
+  /* Consumer line: the next slot to read, and the producer index as
+   * the consumer last read it */
+  volatile size_t tail;
+  size_t head_seen;
+  
+  char pad2[AKS_RING_CACHELINE];
+  
+  /* Read-only after creation */
+  size_t mask;
+  void **ppSlot;
+  
+} aks_spsc;
+
+#ifdef AKS_BODIES
+
+/*
+ * Create a single-producer, single-consumer ring.
+ * 
+ * Parameters:
+ * 
+ *   capacity - the minimum number of pointers the ring can hold, which
+ *   is rounded up to a power of two
+ * 
+ * Return:
+ * 
+ *   the new ring, or NULL if error
+ */
+AKS_API aks_spsc *aks_spsc_new(size_t capacity) {
+  
+  aks_spsc *pq = NULL;
+  
+  capacity = aks_ring_capacity(capacity);
+  if ((capacity == 0) || (capacity > ((size_t) -1) / sizeof(void *))) {
+    return NULL;
+  }
+  
+  pq = (aks_spsc *) calloc(1, sizeof(aks_spsc));
+  if (pq != NULL) {
+    pq->ppSlot = (void **) malloc(capacity * sizeof(void *));
+    if (pq->ppSlot == NULL) {
+      free(pq);
+      return NULL;
+    }
+    pq->mask = capacity - 1;
+  }
+  
+  return pq;
+}
+
+/*
+ * Free a single-producer, single-consumer ring.
+ * 
+ * Parameters:
+ * 
+ *   pq - the ring, or NULL
+ */
+AKS_API void aks_spsc_free(aks_spsc *pq) {
+  if (pq != NULL) {
+    free(pq->ppSlot);
+    free(pq);
+  }
+}
+
+/*
+ * Push pointers onto a single-producer, single-consumer ring.  Only
+ * one thread may push.
+ * 
+ * Parameters:
+ * 
+ *   pq - the ring
+ * 
+ *   ppItem - the pointers to push
+ * 
+ *   n - the number of pointers
+ * 
+ * Return:
+ * 
+ *   the number of pointers pushed, which is less than n if the ring
+ *   became full
+ */
+AKS_API size_t aks_spsc_push(aks_spsc *pq, void * const *ppItem, size_t n) {
+  
+  size_t head = pq->head;
+  size_t room = 0;
+  size_t i = 0;
+  
+  /* Only look at the consumer index if the cached copy shows too
+   * little room */
+  room = pq->mask + 1 - (head - pq->tail_seen);
+  if (room < n) {
+    pq->tail_seen = aks_ring_load(&(pq->tail));
+    room = pq->mask + 1 - (head - pq->tail_seen);
+    if (room < n) {
+      n = room;
+    }
+  }
+  
+  for(i = 0; i < n; i++) {
+    pq->ppSlot[(head + i) & pq->mask] = ppItem[i];
+  }
+  
+  /* Publish the slots */
+  if (n > 0) {
+    aks_ring_store(&(pq->head), head + n);
+  }
+  
+  return n;
+}
+
+/*
+ * Pop pointers from a single-producer, single-consumer ring.  Only one
+ * thread may pop.
+ * 
+ * Parameters:
+ * 
+ *   pq - the ring
+ * 
+ *   ppItem - receives the pointers
+ * 
+ *   max - the maximum number of pointers to pop
+ * 
+ * Return:
+ * 
+ *   the number of pointers popped, which is zero if the ring was empty
+ */
+AKS_API size_t aks_spsc_pop(aks_spsc *pq, void **ppItem, size_t max) {
+  
+  size_t tail = pq->tail;
+  size_t avail = 0;
+  size_t i = 0;
+  
+  /* Only look at the producer index if the cached copy shows too few
+   * pointers */
+  avail = pq->head_seen - tail;
+  if (avail < max) {
+    pq->head_seen = aks_ring_load(&(pq->head));
+    avail = pq->head_seen - tail;
+    if (avail < max) {
+      max = avail;
+    }
+  }
+  
+  for(i = 0; i < max; i++) {
+    ppItem[i] = pq->ppSlot[(tail + i) & pq->mask];
+  }
+  
+  /* Release the slots */
+  if (max > 0) {
+    aks_ring_store(&(pq->tail), tail + max);
+  }
+  
+  return max;
+}
+
+#endif
+
+/*
+ * A slot of a multi-producer, multi-consumer queue.
+ */
+typedef struct {
+  
+  /* Equal to the ticket of the producer that may fill the slot, or one
+   * more than the ticket of the consumer that may empty it */
+  volatile size_t seq;
+  
+  void *pItem;
+  
+} aks_mpmc_cell;
+
+/*
+ * A bounded multi-producer, multi-consumer queue of pointers.
+ * 
+ * Each slot has a sequence number that says whether it is waiting for
+ * a producer or a consumer, as in Dmitry Vyukov's bounded queue.
+ * Producers and consumers claim tickets from separate counters, each on
+ * its own cache line.
+ */
+typedef struct {
+  
+  char pad0[AKS_RING_CACHELINE];
+  
+  /* Next producer ticket */
+  volatile size_t enq;
+  
+  char pad1[AKS_RING_CACHELINE];
+  
+  /* Next consumer ticket */
+  volatile size_t deq;
+  
+  char pad2[AKS_RING_CACHELINE];
+  
+  /* Read-only after creation */
+  size_t mask;
+  aks_mpmc_cell *pCell;
+  
+} aks_mpmc;
+
+#ifdef AKS_BODIES
+
+/*
+ * Create a multi-producer, multi-consumer queue.
+ * 
+ * Parameters:
+ * 
+ *   capacity - the minimum number of pointers the queue can hold, which
+ *   is rounded up to a power of two
+ * 
+ * Return:
+ * 
+ *   the new queue, or NULL if error
+ */
+AKS_API aks_mpmc *aks_mpmc_new(size_t capacity) {
+  
+  aks_mpmc *pq = NULL;
+  size_t i = 0;
+  
+  capacity = aks_ring_capacity(capacity);
+  if ((capacity == 0) ||
+      (capacity > ((size_t) -1) / sizeof(aks_mpmc_cell))) {
+    return NULL;
+  }
+  
+  pq = (aks_mpmc *) calloc(1, sizeof(aks_mpmc));
+  if (pq != NULL) {
+    pq->pCell = (aks_mpmc_cell *) malloc(capacity * sizeof(aks_mpmc_cell));
+    if (pq->pCell == NULL) {
+      free(pq);
+      return NULL;
+    }
+    for(i = 0; i < capacity; i++) {
+      pq->pCell[i].seq = i;
+      pq->pCell[i].pItem = NULL;
+    }
+    pq->mask = capacity - 1;
+  }
+  
+  return pq;
+}
+
+/*
+ * Free a multi-producer, multi-consumer queue.
+ * 
+ * Parameters:
+ * 
+ *   pq - the queue, or NULL
+ */
+AKS_API void aks_mpmc_free(aks_mpmc *pq) {
+  if (pq != NULL) {
+    free(pq->pCell);
+    free(pq);
+  }
+}
+
+/*
+ * Push pointers onto a multi-producer, multi-consumer queue.
+ * 
+ * A batch claims a run of consecutive free slots with a single atomic
+ * operation.  The pointers of one batch stay together in the queue.
+ * 
+ * Parameters:
+ * 
+ *   pq - the queue
+ * 
+ *   ppItem - the pointers to push
+ * 
+ *   n - the number of pointers
+ * 
+ * Return:
+ * 
+ *   the number of pointers pushed, which is less than n if the queue
+ *   became full
+ */
+AKS_API size_t aks_mpmc_push(aks_mpmc *pq, void * const *ppItem, size_t n) {
+  
+  aks_mpmc_cell *pc = NULL;
+  size_t pos = 0;
+  size_t k = 0;
+  size_t i = 0;
+  ptrdiff_t dif = 0;
+  
+  if (n < 1) {
+    return 0;
+  }
+  
+  pos = aks_ring_load(&(pq->enq));
+  for(;;) {
+    
+    /* Count the free slots from this ticket on, up to n */
+    for(k = 0; k < n; k++) {
+      pc = &(pq->pCell[(pos + k) & pq->mask]);
+      dif = (ptrdiff_t) (aks_ring_load(&(pc->seq)) - (pos + k));
+      if (dif != 0) {
+        break;
+      }
+    }
+    
+    if (k > 0) {
+      /* Claim the tickets, or start again if another producer won */
+      if (aks_ring_cas(&(pq->enq), pos, pos + k)) {
+        break;
+      }
+    } else if (dif < 0) {
+      /* The slot still holds an item from a lap ago, so it is full */
+      return 0;
+    }
+    pos = aks_ring_load(&(pq->enq));
+  }
+  
+  /* Fill the claimed slots and hand each one to consumers */
+  for(i = 0; i < k; i++) {
+    pc = &(pq->pCell[(pos + i) & pq->mask]);
+    pc->pItem = ppItem[i];
+    aks_ring_store(&(pc->seq), pos + i + 1);
+  }
+  
+  return k;
+}
+
+/*
+ * Pop pointers from a multi-producer, multi-consumer queue.
+ * 
+ * A batch claims a run of consecutive filled slots with a single atomic
+ * operation.
+ * 
+ * Parameters:
+ * 
+ *   pq - the queue
+ * 
+ *   ppItem - receives the pointers
+ * 
+ *   max - the maximum number of pointers to pop
+ * 
+ * Return:
+ * 
+ *   the number of pointers popped, which is zero if the queue was empty
+ */
+AKS_API size_t aks_mpmc_pop(aks_mpmc *pq, void **ppItem, size_t max) {
+  
+  aks_mpmc_cell *pc = NULL;
+  size_t pos = 0;
+  size_t k = 0;
+  size_t i = 0;
+  ptrdiff_t dif = 0;
+  
+  if (max < 1) {
+    return 0;
+  }
+  
+  pos = aks_ring_load(&(pq->deq));
+  for(;;) {
+    
+    /* Count the filled slots from this ticket on, up to max */
+    for(k = 0; k < max; k++) {
+      pc = &(pq->pCell[(pos + k) & pq->mask]);
+      dif = (ptrdiff_t) (aks_ring_load(&(pc->seq)) - (pos + k + 1));
+      if (dif != 0) {
+        break;
+      }
+    }
+    
+    if (k > 0) {
+      /* Claim the tickets, or start again if another consumer won */
+      if (aks_ring_cas(&(pq->deq), pos, pos + k)) {
+        break;
+      }
+    } else if (dif < 0) {
+      /* The slot has not been filled yet, so the queue is empty */
+      return 0;
+    }
+    pos = aks_ring_load(&(pq->deq));
+  }
+  
+  /* Empty the claimed slots and hand each one back to producers for
+   * the next lap */
+  for(i = 0; i < k; i++) {
+    pc = &(pq->pCell[(pos + i) & pq->mask]);
+    ppItem[i] = pc->pItem;
+    aks_ring_store(&(pc->seq), pos + i + pq->mask + 1);
+  }
+  
+  return k;
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API aks_spsc *aks_spsc_new(size_t capacity);
+AKS_API void aks_spsc_free(aks_spsc *pq);
+AKS_API size_t aks_spsc_push(aks_spsc *pq, void * const *ppItem, size_t n);
+AKS_API size_t aks_spsc_pop(aks_spsc *pq, void **ppItem, size_t max);
+AKS_API aks_mpmc *aks_mpmc_new(size_t capacity);
+AKS_API void aks_mpmc_free(aks_mpmc *pq);
+AKS_API size_t aks_mpmc_push(aks_mpmc *pq, void * const *ppItem, size_t n);
+AKS_API size_t aks_mpmc_pop(aks_mpmc *pq, void **ppItem, size_t max);
+
+#endif
+#endif
+
+/* * * * * * * * * * * * *
+ *                       *
+ * Checksums and hashing *
+ *                       *
+ * * * * * * * * * * * * */
+
+/* Only proceed if checksums and hashing requested and not already
+ * defined */
+#ifdef AKS_HASH
+#ifndef AKS_HASH_INCLUDED
+#define AKS_HASH_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+/* Unless AKS_NO_SIMD is defined, select the CRC instructions; on x86
+ * they are used after a run-time check unless the compiler is already
+ * targeting SSE 4.2 */
+#ifndef AKS_NO_SIMD
+
+#ifdef __SSE4_2__
+#define AKS_HASH_SSE42
+#else
+#ifdef __GNUC__
+#ifdef __x86_64__
+#define AKS_HASH_SSE42
+#define AKS_HASH_SSE42_CHECK
+#endif
+#ifdef __i386__
+#define AKS_HASH_SSE42
+#define AKS_HASH_SSE42_CHECK
+#endif
+#endif
+#ifdef _MSC_VER
+#ifdef _M_X64
+#define AKS_HASH_SSE42
+#define AKS_HASH_SSE42_CHECK
+#endif
+#ifdef _M_IX86
+#define AKS_HASH_SSE42
+#define AKS_HASH_SSE42_CHECK
+#endif
+#endif
+#endif
+
+#ifdef __ARM_FEATURE_CRC32
+#define AKS_HASH_ARMCRC
+#include <arm_acle.h>
+#else
+#ifdef _M_ARM64
+#define AKS_HASH_ARMCRC
+#include <intrin.h>
+#endif
+#endif
+
+#endif
+
+#ifdef AKS_HASH_SSE42
+#include <nmmintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef __x86_64__
+#define AKS_HASH_SSE42_64
+#endif
+#ifdef _M_X64
+#define AKS_HASH_SSE42_64
+#endif
+#endif
+
+/* GCC and Clang must be told to generate SSE 4.2 code for the function
+ * that is only called after the run-time check */
+#ifdef AKS_HASH_SSE42_CHECK
+#ifdef __GNUC__
+#define AKS_HASH_SSE42_FN __attribute__((target("sse4.2")))
+#endif
+#endif
+#ifndef AKS_HASH_SSE42_FN
+#define AKS_HASH_SSE42_FN
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Slicing-by-8 tables for the Castagnoli polynomial 0x82f63b78 in
+ * reflected form.  Table k gives the CRC of a byte followed by k zero
+ * bytes.
+ */
+static const uint32_t aks_crc32c_tab[8][256] = {
+  {
+    0x00000000, 0xf26b8303, 0xe13b70f7, 0x1350f3f4, 0xc79a971f, 0x35f1141c,
+    0x26a1e7e8, 0xd4ca64eb, 0x8ad958cf, 0x78b2dbcc, 0x6be22838, 0x9989ab3b,
+    0x4d43cfd0, 0xbf284cd3, 0xac78bf27, 0x5e133c24, 0x105ec76f, 0xe235446c,
+    0xf165b798, 0x030e349b, 0xd7c45070, 0x25afd373, 0x36ff2087, 0xc494a384,
+    0x9a879fa0, 0x68ec1ca3, 0x7bbcef57, 0x89d76c54, 0x5d1d08bf, 0xaf768bbc,
+    0xbc267848, 0x4e4dfb4b, 0x20bd8ede, 0xd2d60ddd, 0xc186fe29, 0x33ed7d2a,
+    0xe72719c1, 0x154c9ac2, 0x061c6936, 0xf477ea35, 0xaa64d611, 0x580f5512,
+    0x4b5fa6e6, 0xb93425e5, 0x6dfe410e, 0x9f95c20d, 0x8cc531f9, 0x7eaeb2fa,
+    0x30e349b1, 0xc288cab2, 0xd1d83946, 0x23b3ba45, 0xf779deae, 0x05125dad,
+    0x1642ae59, 0xe4292d5a, 0xba3a117e, 0x4851927d, 0x5b016189, 0xa96ae28a,
+    0x7da08661, 0x8fcb0562, 0x9c9bf696, 0x6ef07595, 0x417b1dbc, 0xb3109ebf,
+    0xa0406d4b, 0x522bee48, 0x86e18aa3, 0x748a09a0, 0x67dafa54, 0x95b17957,
+    0xcba24573, 0x39c9c670, 0x2a993584, 0xd8f2b687, 0x0c38d26c, 0xfe53516f,
+    0xed03a29b, 0x1f682198, 0x5125dad3, 0xa34e59d0, 0xb01eaa24, 0x42752927,
+    0x96bf4dcc, 0x64d4cecf, 0x77843d3b, 0x85efbe38, 0xdbfc821c, 0x2997011f,
+    0x3ac7f2eb, 0xc8ac71e8, 0x1c661503, 0xee0d9600, 0xfd5d65f4, 0x0f36e6f7,
+    0x61c69362, 0x93ad1061, 0x80fde395, 0x72966096, 0xa65c047d, 0x5437877e,
+    0x4767748a, 0xb50cf789, 0xeb1fcbad, 0x197448ae, 0x0a24bb5a, 0xf84f3859,
+    0x2c855cb2, 0xdeeedfb1, 0xcdbe2c45, 0x3fd5af46, 0x7198540d, 0x83f3d70e,
+    0x90a324fa, 0x62c8a7f9, 0xb602c312, 0x44694011, 0x5739b3e5, 0xa55230e6,
+    0xfb410cc2, 0x092a8fc1, 0x1a7a7c35, 0xe811ff36, 0x3cdb9bdd, 0xceb018de,
+    0xdde0eb2a, 0x2f8b6829, 0x82f63b78, 0x709db87b, 0x63cd4b8f, 0x91a6c88c,
+    0x456cac67, 0xb7072f64, 0xa457dc90, 0x563c5f93, 0x082f63b7, 0xfa44e0b4,
+    0xe9141340, 0x1b7f9043, 0xcfb5f4a8, 0x3dde77ab, 0x2e8e845f, 0xdce5075c,
+    0x92a8fc17, 0x60c37f14, 0x73938ce0, 0x81f80fe3, 0x55326b08, 0xa759e80b,
+    0xb4091bff, 0x466298fc, 0x1871a4d8, 0xea1a27db, 0xf94ad42f, 0x0b21572c,
+    0xdfeb33c7, 0x2d80b0c4, 0x3ed04330, 0xccbbc033, 0xa24bb5a6, 0x502036a5,
+    0x4370c551, 0xb11b4652, 0x65d122b9, 0x97baa1ba, 0x84ea524e, 0x7681d14d,
+    0x2892ed69, 0xdaf96e6a, 0xc9a99d9e, 0x3bc21e9d, 0xef087a76, 0x1d63f975,
+    0x0e330a81, 0xfc588982, 0xb21572c9, 0x407ef1ca, 0x532e023e, 0xa145813d,
+    0x758fe5d6, 0x87e466d5, 0x94b49521, 0x66df1622, 0x38cc2a06, 0xcaa7a905,
+    0xd9f75af1, 0x2b9cd9f2, 0xff56bd19, 0x0d3d3e1a, 0x1e6dcdee, 0xec064eed,
+    0xc38d26c4, 0x31e6a5c7, 0x22b65633, 0xd0ddd530, 0x0417b1db, 0xf67c32d8,
+    0xe52cc12c, 0x1747422f, 0x49547e0b, 0xbb3ffd08, 0xa86f0efc, 0x5a048dff,
+    0x8ecee914, 0x7ca56a17, 0x6ff599e3, 0x9d9e1ae0, 0xd3d3e1ab, 0x21b862a8,
+    0x32e8915c, 0xc083125f, 0x144976b4, 0xe622f5b7, 0xf5720643, 0x07198540,
+    0x590ab964, 0xab613a67, 0xb831c993, 0x4a5a4a90, 0x9e902e7b, 0x6cfbad78,
+    0x7fab5e8c, 0x8dc0dd8f, 0xe330a81a, 0x115b2b19, 0x020bd8ed, 0xf0605bee,
+    0x24aa3f05, 0xd6c1bc06, 0xc5914ff2, 0x37faccf1, 0x69e9f0d5, 0x9b8273d6,
+    0x88d28022, 0x7ab90321, 0xae7367ca, 0x5c18e4c9, 0x4f48173d, 0xbd23943e,
+    0xf36e6f75, 0x0105ec76, 0x12551f82, 0xe03e9c81, 0x34f4f86a, 0xc69f7b69,
+    0xd5cf889d, 0x27a40b9e, 0x79b737ba, 0x8bdcb4b9, 0x988c474d, 0x6ae7c44e,
+    0xbe2da0a5, 0x4c4623a6, 0x5f16d052, 0xad7d5351
+  },
+  {
+    0x00000000, 0x13a29877, 0x274530ee, 0x34e7a899, 0x4e8a61dc, 0x5d28f9ab,
+    0x69cf5132, 0x7a6dc945, 0x9d14c3b8, 0x8eb65bcf, 0xba51f356, 0xa9f36b21,
+    0xd39ea264, 0xc03c3a13, 0xf4db928a, 0xe7790afd, 0x3fc5f181, 0x2c6769f6,
+    0x1880c16f, 0x0b225918, 0x714f905d, 0x62ed082a, 0x560aa0b3, 0x45a838c4,
+    0xa2d13239, 0xb173aa4e, 0x859402d7, 0x96369aa0, 0xec5b53e5, 0xfff9cb92,
+    0xcb1e630b, 0xd8bcfb7c, 0x7f8be302, 0x6c297b75, 0x58ced3ec, 0x4b6c4b9b,
+    0x310182de, 0x22a31aa9, 0x1644b230, 0x05e62a47, 0xe29f20ba, 0xf13db8cd,
+    0xc5da1054, 0xd6788823, 0xac154166, 0xbfb7d911, 0x8b507188, 0x98f2e9ff,
+    0x404e1283, 0x53ec8af4, 0x670b226d, 0x74a9ba1a, 0x0ec4735f, 0x1d66eb28,
+    0x298143b1, 0x3a23dbc6, 0xdd5ad13b, 0xcef8494c, 0xfa1fe1d5, 0xe9bd79a2,
+    0x93d0b0e7, 0x80722890, 0xb4958009, 0xa737187e, 0xff17c604, 0xecb55e73,
+    0xd852f6ea, 0xcbf06e9d, 0xb19da7d8, 0xa23f3faf, 0x96d89736, 0x857a0f41,
+    0x620305bc, 0x71a19dcb, 0x45463552, 0x56e4ad25, 0x2c896460, 0x3f2bfc17,
+    0x0bcc548e, 0x186eccf9, 0xc0d23785, 0xd370aff2, 0xe797076b, 0xf4359f1c,
+    0x8e585659, 0x9dface2e, 0xa91d66b7, 0xbabffec0, 0x5dc6f43d, 0x4e646c4a,
+    0x7a83c4d3, 0x69215ca4, 0x134c95e1, 0x00ee0d96, 0x3409a50f, 0x27ab3d78,
+    0x809c2506, 0x933ebd71, 0xa7d915e8, 0xb47b8d9f, 0xce1644da, 0xddb4dcad,
+    0xe9537434, 0xfaf1ec43, 0x1d88e6be, 0x0e2a7ec9, 0x3acdd650, 0x296f4e27,
+    0x53028762, 0x40a01f15, 0x7447b78c, 0x67e52ffb, 0xbf59d487, 0xacfb4cf0,
+    0x981ce469, 0x8bbe7c1e, 0xf1d3b55b, 0xe2712d2c, 0xd69685b5, 0xc5341dc2,
+    0x224d173f, 0x31ef8f48, 0x050827d1, 0x16aabfa6, 0x6cc776e3, 0x7f65ee94,
+    0x4b82460d, 0x5820de7a, 0xfbc3faf9, 0xe861628e, 0xdc86ca17, 0xcf245260,
+    0xb5499b25, 0xa6eb0352, 0x920cabcb, 0x81ae33bc, 0x66d73941, 0x7575a136,
+    0x419209af, 0x523091d8, 0x285d589d, 0x3bffc0ea, 0x0f186873, 0x1cbaf004,
+    0xc4060b78, 0xd7a4930f, 0xe3433b96, 0xf0e1a3e1, 0x8a8c6aa4, 0x992ef2d3,
+    0xadc95a4a, 0xbe6bc23d, 0x5912c8c0, 0x4ab050b7, 0x7e57f82e, 0x6df56059,
+    0x1798a91c, 0x043a316b, 0x30dd99f2, 0x237f0185, 0x844819fb, 0x97ea818c,
+    0xa30d2915, 0xb0afb162, 0xcac27827, 0xd960e050, 0xed8748c9, 0xfe25d0be,
+    0x195cda43, 0x0afe4234, 0x3e19eaad, 0x2dbb72da, 0x57d6bb9f, 0x447423e8,
+    0x70938b71, 0x63311306, 0xbb8de87a, 0xa82f700d, 0x9cc8d894, 0x8f6a40e3,
+    0xf50789a6, 0xe6a511d1, 0xd242b948, 0xc1e0213f, 0x26992bc2, 0x353bb3b5,
+    0x01dc1b2c, 0x127e835b, 0x68134a1e, 0x7bb1d269, 0x4f567af0, 0x5cf4e287,
+    0x04d43cfd, 0x1776a48a, 0x23910c13, 0x30339464, 0x4a5e5d21, 0x59fcc556,
+    0x6d1b6dcf, 0x7eb9f5b8, 0x99c0ff45, 0x8a626732, 0xbe85cfab, 0xad2757dc,
+    0xd74a9e99, 0xc4e806ee, 0xf00fae77, 0xe3ad3600, 0x3b11cd7c, 0x28b3550b,
+    0x1c54fd92, 0x0ff665e5, 0x759baca0, 0x663934d7, 0x52de9c4e, 0x417c0439,
+    0xa6050ec4, 0xb5a796b3, 0x81403e2a, 0x92e2a65d, 0xe88f6f18, 0xfb2df76f,
+    0xcfca5ff6, 0xdc68c781, 0x7b5fdfff, 0x68fd4788, 0x5c1aef11, 0x4fb87766,
+    0x35d5be23, 0x26772654, 0x12908ecd, 0x013216ba, 0xe64b1c47, 0xf5e98430,
+    0xc10e2ca9, 0xd2acb4de, 0xa8c17d9b, 0xbb63e5ec, 0x8f844d75, 0x9c26d502,
+    0x449a2e7e, 0x5738b609, 0x63df1e90, 0x707d86e7, 0x0a104fa2, 0x19b2d7d5,
+    0x2d557f4c, 0x3ef7e73b, 0xd98eedc6, 0xca2c75b1, 0xfecbdd28, 0xed69455f,
+    0x97048c1a, 0x84a6146d, 0xb041bcf4, 0xa3e32483
+  },
+  {
+    0x00000000, 0xa541927e, 0x4f6f520d, 0xea2ec073, 0x9edea41a, 0x3b9f3664,
+    0xd1b1f617, 0x74f06469, 0x38513ec5, 0x9d10acbb, 0x773e6cc8, 0xd27ffeb6,
+    0xa68f9adf, 0x03ce08a1, 0xe9e0c8d2, 0x4ca15aac, 0x70a27d8a, 0xd5e3eff4,
+    0x3fcd2f87, 0x9a8cbdf9, 0xee7cd990, 0x4b3d4bee, 0xa1138b9d, 0x045219e3,
+    0x48f3434f, 0xedb2d131, 0x079c1142, 0xa2dd833c, 0xd62de755, 0x736c752b,
+    0x9942b558, 0x3c032726, 0xe144fb14, 0x4405696a, 0xae2ba919, 0x0b6a3b67,
+    0x7f9a5f0e, 0xdadbcd70, 0x30f50d03, 0x95b49f7d, 0xd915c5d1, 0x7c5457af,
+    0x967a97dc, 0x333b05a2, 0x47cb61cb, 0xe28af3b5, 0x08a433c6, 0xade5a1b8,
+    0x91e6869e, 0x34a714e0, 0xde89d493, 0x7bc846ed, 0x0f382284, 0xaa79b0fa,
+    0x40577089, 0xe516e2f7, 0xa9b7b85b, 0x0cf62a25, 0xe6d8ea56, 0x43997828,
+    0x37691c41, 0x92288e3f, 0x78064e4c, 0xdd47dc32, 0xc76580d9, 0x622412a7,
+    0x880ad2d4, 0x2d4b40aa, 0x59bb24c3, 0xfcfab6bd, 0x16d476ce, 0xb395e4b0,
+    0xff34be1c, 0x5a752c62, 0xb05bec11, 0x151a7e6f, 0x61ea1a06, 0xc4ab8878,
+    0x2e85480b, 0x8bc4da75, 0xb7c7fd53, 0x12866f2d, 0xf8a8af5e, 0x5de93d20,
+    0x29195949, 0x8c58cb37, 0x66760b44, 0xc337993a, 0x8f96c396, 0x2ad751e8,
+    0xc0f9919b, 0x65b803e5, 0x1148678c, 0xb409f5f2, 0x5e273581, 0xfb66a7ff,
+    0x26217bcd, 0x8360e9b3, 0x694e29c0, 0xcc0fbbbe, 0xb8ffdfd7, 0x1dbe4da9,
+    0xf7908dda, 0x52d11fa4, 0x1e704508, 0xbb31d776, 0x511f1705, 0xf45e857b,
+    0x80aee112, 0x25ef736c, 0xcfc1b31f, 0x6a802161, 0x56830647, 0xf3c29439,
+    0x19ec544a, 0xbcadc634, 0xc85da25d, 0x6d1c3023, 0x8732f050, 0x2273622e,
+    0x6ed23882, 0xcb93aafc, 0x21bd6a8f, 0x84fcf8f1, 0xf00c9c98, 0x554d0ee6,
+    0xbf63ce95, 0x1a225ceb, 0x8b277743, 0x2e66e53d, 0xc448254e, 0x6109b730,
+    0x15f9d359, 0xb0b84127, 0x5a968154, 0xffd7132a, 0xb3764986, 0x1637dbf8,
+    0xfc191b8b, 0x595889f5, 0x2da8ed9c, 0x88e97fe2, 0x62c7bf91, 0xc7862def,
+    0xfb850ac9, 0x5ec498b7, 0xb4ea58c4, 0x11abcaba, 0x655baed3, 0xc01a3cad,
+    0x2a34fcde, 0x8f756ea0, 0xc3d4340c, 0x6695a672, 0x8cbb6601, 0x29faf47f,
+    0x5d0a9016, 0xf84b0268, 0x1265c21b, 0xb7245065, 0x6a638c57, 0xcf221e29,
+    0x250cde5a, 0x804d4c24, 0xf4bd284d, 0x51fcba33, 0xbbd27a40, 0x1e93e83e,
+    0x5232b292, 0xf77320ec, 0x1d5de09f, 0xb81c72e1, 0xccec1688, 0x69ad84f6,
+    0x83834485, 0x26c2d6fb, 0x1ac1f1dd, 0xbf8063a3, 0x55aea3d0, 0xf0ef31ae,
+    0x841f55c7, 0x215ec7b9, 0xcb7007ca, 0x6e3195b4, 0x2290cf18, 0x87d15d66,
+    0x6dff9d15, 0xc8be0f6b, 0xbc4e6b02, 0x190ff97c, 0xf321390f, 0x5660ab71,
+    0x4c42f79a, 0xe90365e4, 0x032da597, 0xa66c37e9, 0xd29c5380, 0x77ddc1fe,
+    0x9df3018d, 0x38b293f3, 0x7413c95f, 0xd1525b21, 0x3b7c9b52, 0x9e3d092c,
+    0xeacd6d45, 0x4f8cff3b, 0xa5a23f48, 0x00e3ad36, 0x3ce08a10, 0x99a1186e,
+    0x738fd81d, 0xd6ce4a63, 0xa23e2e0a, 0x077fbc74, 0xed517c07, 0x4810ee79,
+    0x04b1b4d5, 0xa1f026ab, 0x4bdee6d8, 0xee9f74a6, 0x9a6f10cf, 0x3f2e82b1,
+    0xd50042c2, 0x7041d0bc, 0xad060c8e, 0x08479ef0, 0xe2695e83, 0x4728ccfd,
+    0x33d8a894, 0x96993aea, 0x7cb7fa99, 0xd9f668e7, 0x9557324b, 0x3016a035,
+    0xda386046, 0x7f79f238, 0x0b899651, 0xaec8042f, 0x44e6c45c, 0xe1a75622,
+    0xdda47104, 0x78e5e37a, 0x92cb2309, 0x378ab177, 0x437ad51e, 0xe63b4760,
+    0x0c158713, 0xa954156d, 0xe5f54fc1, 0x40b4ddbf, 0xaa9a1dcc, 0x0fdb8fb2,
+    0x7b2bebdb, 0xde6a79a5, 0x3444b9d6, 0x91052ba8
+  },
+  {
+    0x00000000, 0xdd45aab8, 0xbf672381, 0x62228939, 0x7b2231f3, 0xa6679b4b,
+    0xc4451272, 0x1900b8ca, 0xf64463e6, 0x2b01c95e, 0x49234067, 0x9466eadf,
+    0x8d665215, 0x5023f8ad, 0x32017194, 0xef44db2c, 0xe964b13d, 0x34211b85,
+    0x560392bc, 0x8b463804, 0x924680ce, 0x4f032a76, 0x2d21a34f, 0xf06409f7,
+    0x1f20d2db, 0xc2657863, 0xa047f15a, 0x7d025be2, 0x6402e328, 0xb9474990,
+    0xdb65c0a9, 0x06206a11, 0xd725148b, 0x0a60be33, 0x6842370a, 0xb5079db2,
+    0xac072578, 0x71428fc0, 0x136006f9, 0xce25ac41, 0x2161776d, 0xfc24ddd5,
+    0x9e0654ec, 0x4343fe54, 0x5a43469e, 0x8706ec26, 0xe524651f, 0x3861cfa7,
+    0x3e41a5b6, 0xe3040f0e, 0x81268637, 0x5c632c8f, 0x45639445, 0x98263efd,
+    0xfa04b7c4, 0x27411d7c, 0xc805c650, 0x15406ce8, 0x7762e5d1, 0xaa274f69,
+    0xb327f7a3, 0x6e625d1b, 0x0c40d422, 0xd1057e9a, 0xaba65fe7, 0x76e3f55f,
+    0x14c17c66, 0xc984d6de, 0xd0846e14, 0x0dc1c4ac, 0x6fe34d95, 0xb2a6e72d,
+    0x5de23c01, 0x80a796b9, 0xe2851f80, 0x3fc0b538, 0x26c00df2, 0xfb85a74a,
+    0x99a72e73, 0x44e284cb, 0x42c2eeda, 0x9f874462, 0xfda5cd5b, 0x20e067e3,
+    0x39e0df29, 0xe4a57591, 0x8687fca8, 0x5bc25610, 0xb4868d3c, 0x69c32784,
+    0x0be1aebd, 0xd6a40405, 0xcfa4bccf, 0x12e11677, 0x70c39f4e, 0xad8635f6,
+    0x7c834b6c, 0xa1c6e1d4, 0xc3e468ed, 0x1ea1c255, 0x07a17a9f, 0xdae4d027,
+    0xb8c6591e, 0x6583f3a6, 0x8ac7288a, 0x57828232, 0x35a00b0b, 0xe8e5a1b3,
+    0xf1e51979, 0x2ca0b3c1, 0x4e823af8, 0x93c79040, 0x95e7fa51, 0x48a250e9,
+    0x2a80d9d0, 0xf7c57368, 0xeec5cba2, 0x3380611a, 0x51a2e823, 0x8ce7429b,
+    0x63a399b7, 0xbee6330f, 0xdcc4ba36, 0x0181108e, 0x1881a844, 0xc5c402fc,
+    0xa7e68bc5, 0x7aa3217d, 0x52a0c93f, 0x8fe56387, 0xedc7eabe, 0x30824006,
+    0x2982f8cc, 0xf4c75274, 0x96e5db4d, 0x4ba071f5, 0xa4e4aad9, 0x79a10061,
+    0x1b838958, 0xc6c623e0, 0xdfc69b2a, 0x02833192, 0x60a1b8ab, 0xbde41213,
+    0xbbc47802, 0x6681d2ba, 0x04a35b83, 0xd9e6f13b, 0xc0e649f1, 0x1da3e349,
+    0x7f816a70, 0xa2c4c0c8, 0x4d801be4, 0x90c5b15c, 0xf2e73865, 0x2fa292dd,
+    0x36a22a17, 0xebe780af, 0x89c50996, 0x5480a32e, 0x8585ddb4, 0x58c0770c,
+    0x3ae2fe35, 0xe7a7548d, 0xfea7ec47, 0x23e246ff, 0x41c0cfc6, 0x9c85657e,
+    0x73c1be52, 0xae8414ea, 0xcca69dd3, 0x11e3376b, 0x08e38fa1, 0xd5a62519,
+    0xb784ac20, 0x6ac10698, 0x6ce16c89, 0xb1a4c631, 0xd3864f08, 0x0ec3e5b0,
+    0x17c35d7a, 0xca86f7c2, 0xa8a47efb, 0x75e1d443, 0x9aa50f6f, 0x47e0a5d7,
+    0x25c22cee, 0xf8878656, 0xe1873e9c, 0x3cc29424, 0x5ee01d1d, 0x83a5b7a5,
+    0xf90696d8, 0x24433c60, 0x4661b559, 0x9b241fe1, 0x8224a72b, 0x5f610d93,
+    0x3d4384aa, 0xe0062e12, 0x0f42f53e, 0xd2075f86, 0xb025d6bf, 0x6d607c07,
+    0x7460c4cd, 0xa9256e75, 0xcb07e74c, 0x16424df4, 0x106227e5, 0xcd278d5d,
+    0xaf050464, 0x7240aedc, 0x6b401616, 0xb605bcae, 0xd4273597, 0x09629f2f,
+    0xe6264403, 0x3b63eebb, 0x59416782, 0x8404cd3a, 0x9d0475f0, 0x4041df48,
+    0x22635671, 0xff26fcc9, 0x2e238253, 0xf36628eb, 0x9144a1d2, 0x4c010b6a,
+    0x5501b3a0, 0x88441918, 0xea669021, 0x37233a99, 0xd867e1b5, 0x05224b0d,
+    0x6700c234, 0xba45688c, 0xa345d046, 0x7e007afe, 0x1c22f3c7, 0xc167597f,
+    0xc747336e, 0x1a0299d6, 0x782010ef, 0xa565ba57, 0xbc65029d, 0x6120a825,
+    0x0302211c, 0xde478ba4, 0x31035088, 0xec46fa30, 0x8e647309, 0x5321d9b1,
+    0x4a21617b, 0x9764cbc3, 0xf54642fa, 0x2803e842
+  },
+  {
+    0x00000000, 0x38116fac, 0x7022df58, 0x4833b0f4, 0xe045beb0, 0xd854d11c,
+    0x906761e8, 0xa8760e44, 0xc5670b91, 0xfd76643d, 0xb545d4c9, 0x8d54bb65,
+    0x2522b521, 0x1d33da8d, 0x55006a79, 0x6d1105d5, 0x8f2261d3, 0xb7330e7f,
+    0xff00be8b, 0xc711d127, 0x6f67df63, 0x5776b0cf, 0x1f45003b, 0x27546f97,
+    0x4a456a42, 0x725405ee, 0x3a67b51a, 0x0276dab6, 0xaa00d4f2, 0x9211bb5e,
+    0xda220baa, 0xe2336406, 0x1ba8b557, 0x23b9dafb, 0x6b8a6a0f, 0x539b05a3,
+    0xfbed0be7, 0xc3fc644b, 0x8bcfd4bf, 0xb3debb13, 0xdecfbec6, 0xe6ded16a,
+    0xaeed619e, 0x96fc0e32, 0x3e8a0076, 0x069b6fda, 0x4ea8df2e, 0x76b9b082,
+    0x948ad484, 0xac9bbb28, 0xe4a80bdc, 0xdcb96470, 0x74cf6a34, 0x4cde0598,
+    0x04edb56c, 0x3cfcdac0, 0x51eddf15, 0x69fcb0b9, 0x21cf004d, 0x19de6fe1,
+    0xb1a861a5, 0x89b90e09, 0xc18abefd, 0xf99bd151, 0x37516aae, 0x0f400502,
+    0x4773b5f6, 0x7f62da5a, 0xd714d41e, 0xef05bbb2, 0xa7360b46, 0x9f2764ea,
+    0xf236613f, 0xca270e93, 0x8214be67, 0xba05d1cb, 0x1273df8f, 0x2a62b023,
+    0x625100d7, 0x5a406f7b, 0xb8730b7d, 0x806264d1, 0xc851d425, 0xf040bb89,
+    0x5836b5cd, 0x6027da61, 0x28146a95, 0x10050539, 0x7d1400ec, 0x45056f40,
+    0x0d36dfb4, 0x3527b018, 0x9d51be5c, 0xa540d1f0, 0xed736104, 0xd5620ea8,
+    0x2cf9dff9, 0x14e8b055, 0x5cdb00a1, 0x64ca6f0d, 0xccbc6149, 0xf4ad0ee5,
+    0xbc9ebe11, 0x848fd1bd, 0xe99ed468, 0xd18fbbc4, 0x99bc0b30, 0xa1ad649c,
+    0x09db6ad8, 0x31ca0574, 0x79f9b580, 0x41e8da2c, 0xa3dbbe2a, 0x9bcad186,
+    0xd3f96172, 0xebe80ede, 0x439e009a, 0x7b8f6f36, 0x33bcdfc2, 0x0badb06e,
+    0x66bcb5bb, 0x5eadda17, 0x169e6ae3, 0x2e8f054f, 0x86f90b0b, 0xbee864a7,
+    0xf6dbd453, 0xcecabbff, 0x6ea2d55c, 0x56b3baf0, 0x1e800a04, 0x269165a8,
+    0x8ee76bec, 0xb6f60440, 0xfec5b4b4, 0xc6d4db18, 0xabc5decd, 0x93d4b161,
+    0xdbe70195, 0xe3f66e39, 0x4b80607d, 0x73910fd1, 0x3ba2bf25, 0x03b3d089,
+    0xe180b48f, 0xd991db23, 0x91a26bd7, 0xa9b3047b, 0x01c50a3f, 0x39d46593,
+    0x71e7d567, 0x49f6bacb, 0x24e7bf1e, 0x1cf6d0b2, 0x54c56046, 0x6cd40fea,
+    0xc4a201ae, 0xfcb36e02, 0xb480def6, 0x8c91b15a, 0x750a600b, 0x4d1b0fa7,
+    0x0528bf53, 0x3d39d0ff, 0x954fdebb, 0xad5eb117, 0xe56d01e3, 0xdd7c6e4f,
+    0xb06d6b9a, 0x887c0436, 0xc04fb4c2, 0xf85edb6e, 0x5028d52a, 0x6839ba86,
+    0x200a0a72, 0x181b65de, 0xfa2801d8, 0xc2396e74, 0x8a0ade80, 0xb21bb12c,
+    0x1a6dbf68, 0x227cd0c4, 0x6a4f6030, 0x525e0f9c, 0x3f4f0a49, 0x075e65e5,
+    0x4f6dd511, 0x777cbabd, 0xdf0ab4f9, 0xe71bdb55, 0xaf286ba1, 0x9739040d,
+    0x59f3bff2, 0x61e2d05e, 0x29d160aa, 0x11c00f06, 0xb9b60142, 0x81a76eee,
+    0xc994de1a, 0xf185b1b6, 0x9c94b463, 0xa485dbcf, 0xecb66b3b, 0xd4a70497,
+    0x7cd10ad3, 0x44c0657f, 0x0cf3d58b, 0x34e2ba27, 0xd6d1de21, 0xeec0b18d,
+    0xa6f30179, 0x9ee26ed5, 0x36946091, 0x0e850f3d, 0x46b6bfc9, 0x7ea7d065,
+    0x13b6d5b0, 0x2ba7ba1c, 0x63940ae8, 0x5b856544, 0xf3f36b00, 0xcbe204ac,
+    0x83d1b458, 0xbbc0dbf4, 0x425b0aa5, 0x7a4a6509, 0x3279d5fd, 0x0a68ba51,
+    0xa21eb415, 0x9a0fdbb9, 0xd23c6b4d, 0xea2d04e1, 0x873c0134, 0xbf2d6e98,
+    0xf71ede6c, 0xcf0fb1c0, 0x6779bf84, 0x5f68d028, 0x175b60dc, 0x2f4a0f70,
+    0xcd796b76, 0xf56804da, 0xbd5bb42e, 0x854adb82, 0x2d3cd5c6, 0x152dba6a,
+    0x5d1e0a9e, 0x650f6532, 0x081e60e7, 0x300f0f4b, 0x783cbfbf, 0x402dd013,
+    0xe85bde57, 0xd04ab1fb, 0x9879010f, 0xa0686ea3
+  },
+  {
+    0x00000000, 0xef306b19, 0xdb8ca0c3, 0x34bccbda, 0xb2f53777, 0x5dc55c6e,
+    0x697997b4, 0x8649fcad, 0x6006181f, 0x8f367306, 0xbb8ab8dc, 0x54bad3c5,
+    0xd2f32f68, 0x3dc34471, 0x097f8fab, 0xe64fe4b2, 0xc00c303e, 0x2f3c5b27,
+    0x1b8090fd, 0xf4b0fbe4, 0x72f90749, 0x9dc96c50, 0xa975a78a, 0x4645cc93,
+    0xa00a2821, 0x4f3a4338, 0x7b8688e2, 0x94b6e3fb, 0x12ff1f56, 0xfdcf744f,
+    0xc973bf95, 0x2643d48c, 0x85f4168d, 0x6ac47d94, 0x5e78b64e, 0xb148dd57,
+    0x370121fa, 0xd8314ae3, 0xec8d8139, 0x03bdea20, 0xe5f20e92, 0x0ac2658b,
+    0x3e7eae51, 0xd14ec548, 0x570739e5, 0xb83752fc, 0x8c8b9926, 0x63bbf23f,
+    0x45f826b3, 0xaac84daa, 0x9e748670, 0x7144ed69, 0xf70d11c4, 0x183d7add,
+    0x2c81b107, 0xc3b1da1e, 0x25fe3eac, 0xcace55b5, 0xfe729e6f, 0x1142f576,
+    0x970b09db, 0x783b62c2, 0x4c87a918, 0xa3b7c201, 0x0e045beb, 0xe13430f2,
+    0xd588fb28, 0x3ab89031, 0xbcf16c9c, 0x53c10785, 0x677dcc5f, 0x884da746,
+    0x6e0243f4, 0x813228ed, 0xb58ee337, 0x5abe882e, 0xdcf77483, 0x33c71f9a,
+    0x077bd440, 0xe84bbf59, 0xce086bd5, 0x213800cc, 0x1584cb16, 0xfab4a00f,
+    0x7cfd5ca2, 0x93cd37bb, 0xa771fc61, 0x48419778, 0xae0e73ca, 0x413e18d3,
+    0x7582d309, 0x9ab2b810, 0x1cfb44bd, 0xf3cb2fa4, 0xc777e47e, 0x28478f67,
+    0x8bf04d66, 0x64c0267f, 0x507ceda5, 0xbf4c86bc, 0x39057a11, 0xd6351108,
+    0xe289dad2, 0x0db9b1cb, 0xebf65579, 0x04c63e60, 0x307af5ba, 0xdf4a9ea3,
+    0x5903620e, 0xb6330917, 0x828fc2cd, 0x6dbfa9d4, 0x4bfc7d58, 0xa4cc1641,
+    0x9070dd9b, 0x7f40b682, 0xf9094a2f, 0x16392136, 0x2285eaec, 0xcdb581f5,
+    0x2bfa6547, 0xc4ca0e5e, 0xf076c584, 0x1f46ae9d, 0x990f5230, 0x763f3929,
+    0x4283f2f3, 0xadb399ea, 0x1c08b7d6, 0xf338dccf, 0xc7841715, 0x28b47c0c,
+    0xaefd80a1, 0x41cdebb8, 0x75712062, 0x9a414b7b, 0x7c0eafc9, 0x933ec4d0,
+    0xa7820f0a, 0x48b26413, 0xcefb98be, 0x21cbf3a7, 0x1577387d, 0xfa475364,
+    0xdc0487e8, 0x3334ecf1, 0x0788272b, 0xe8b84c32, 0x6ef1b09f, 0x81c1db86,
+    0xb57d105c, 0x5a4d7b45, 0xbc029ff7, 0x5332f4ee, 0x678e3f34, 0x88be542d,
+    0x0ef7a880, 0xe1c7c399, 0xd57b0843, 0x3a4b635a, 0x99fca15b, 0x76ccca42,
+    0x42700198, 0xad406a81, 0x2b09962c, 0xc439fd35, 0xf08536ef, 0x1fb55df6,
+    0xf9fab944, 0x16cad25d, 0x22761987, 0xcd46729e, 0x4b0f8e33, 0xa43fe52a,
+    0x90832ef0, 0x7fb345e9, 0x59f09165, 0xb6c0fa7c, 0x827c31a6, 0x6d4c5abf,
+    0xeb05a612, 0x0435cd0b, 0x308906d1, 0xdfb96dc8, 0x39f6897a, 0xd6c6e263,
+    0xe27a29b9, 0x0d4a42a0, 0x8b03be0d, 0x6433d514, 0x508f1ece, 0xbfbf75d7,
+    0x120cec3d, 0xfd3c8724, 0xc9804cfe, 0x26b027e7, 0xa0f9db4a, 0x4fc9b053,
+    0x7b757b89, 0x94451090, 0x720af422, 0x9d3a9f3b, 0xa98654e1, 0x46b63ff8,
+    0xc0ffc355, 0x2fcfa84c, 0x1b736396, 0xf443088f, 0xd200dc03, 0x3d30b71a,
+    0x098c7cc0, 0xe6bc17d9, 0x60f5eb74, 0x8fc5806d, 0xbb794bb7, 0x544920ae,
+    0xb206c41c, 0x5d36af05, 0x698a64df, 0x86ba0fc6, 0x00f3f36b, 0xefc39872,
+    0xdb7f53a8, 0x344f38b1, 0x97f8fab0, 0x78c891a9, 0x4c745a73, 0xa344316a,
+    0x250dcdc7, 0xca3da6de, 0xfe816d04, 0x11b1061d, 0xf7fee2af, 0x18ce89b6,
+    0x2c72426c, 0xc3422975, 0x450bd5d8, 0xaa3bbec1, 0x9e87751b, 0x71b71e02,
+    0x57f4ca8e, 0xb8c4a197, 0x8c786a4d, 0x63480154, 0xe501fdf9, 0x0a3196e0,
+    0x3e8d5d3a, 0xd1bd3623, 0x37f2d291, 0xd8c2b988, 0xec7e7252, 0x034e194b,
+    0x8507e5e6, 0x6a378eff, 0x5e8b4525, 0xb1bb2e3c
+  },
+  {
+    0x00000000, 0x68032cc8, 0xd0065990, 0xb8057558, 0xa5e0c5d1, 0xcde3e919,
+    0x75e69c41, 0x1de5b089, 0x4e2dfd53, 0x262ed19b, 0x9e2ba4c3, 0xf628880b,
+    0xebcd3882, 0x83ce144a, 0x3bcb6112, 0x53c84dda, 0x9c5bfaa6, 0xf458d66e,
+    0x4c5da336, 0x245e8ffe, 0x39bb3f77, 0x51b813bf, 0xe9bd66e7, 0x81be4a2f,
+    0xd27607f5, 0xba752b3d, 0x02705e65, 0x6a7372ad, 0x7796c224, 0x1f95eeec,
+    0xa7909bb4, 0xcf93b77c, 0x3d5b83bd, 0x5558af75, 0xed5dda2d, 0x855ef6e5,
+    0x98bb466c, 0xf0b86aa4, 0x48bd1ffc, 0x20be3334, 0x73767eee, 0x1b755226,
+    0xa370277e, 0xcb730bb6, 0xd696bb3f, 0xbe9597f7, 0x0690e2af, 0x6e93ce67,
+    0xa100791b, 0xc90355d3, 0x7106208b, 0x19050c43, 0x04e0bcca, 0x6ce39002,
+    0xd4e6e55a, 0xbce5c992, 0xef2d8448, 0x872ea880, 0x3f2bddd8, 0x5728f110,
+    0x4acd4199, 0x22ce6d51, 0x9acb1809, 0xf2c834c1, 0x7ab7077a, 0x12b42bb2,
+    0xaab15eea, 0xc2b27222, 0xdf57c2ab, 0xb754ee63, 0x0f519b3b, 0x6752b7f3,
+    0x349afa29, 0x5c99d6e1, 0xe49ca3b9, 0x8c9f8f71, 0x917a3ff8, 0xf9791330,
+    0x417c6668, 0x297f4aa0, 0xe6ecfddc, 0x8eefd114, 0x36eaa44c, 0x5ee98884,
+    0x430c380d, 0x2b0f14c5, 0x930a619d, 0xfb094d55, 0xa8c1008f, 0xc0c22c47,
+    0x78c7591f, 0x10c475d7, 0x0d21c55e, 0x6522e996, 0xdd279cce, 0xb524b006,
+    0x47ec84c7, 0x2fefa80f, 0x97eadd57, 0xffe9f19f, 0xe20c4116, 0x8a0f6dde,
+    0x320a1886, 0x5a09344e, 0x09c17994, 0x61c2555c, 0xd9c72004, 0xb1c40ccc,
+    0xac21bc45, 0xc422908d, 0x7c27e5d5, 0x1424c91d, 0xdbb77e61, 0xb3b452a9,
+    0x0bb127f1, 0x63b20b39, 0x7e57bbb0, 0x16549778, 0xae51e220, 0xc652cee8,
+    0x959a8332, 0xfd99affa, 0x459cdaa2, 0x2d9ff66a, 0x307a46e3, 0x58796a2b,
+    0xe07c1f73, 0x887f33bb, 0xf56e0ef4, 0x9d6d223c, 0x25685764, 0x4d6b7bac,
+    0x508ecb25, 0x388de7ed, 0x808892b5, 0xe88bbe7d, 0xbb43f3a7, 0xd340df6f,
+    0x6b45aa37, 0x034686ff, 0x1ea33676, 0x76a01abe, 0xcea56fe6, 0xa6a6432e,
+    0x6935f452, 0x0136d89a, 0xb933adc2, 0xd130810a, 0xccd53183, 0xa4d61d4b,
+    0x1cd36813, 0x74d044db, 0x27180901, 0x4f1b25c9, 0xf71e5091, 0x9f1d7c59,
+    0x82f8ccd0, 0xeafbe018, 0x52fe9540, 0x3afdb988, 0xc8358d49, 0xa036a181,
+    0x1833d4d9, 0x7030f811, 0x6dd54898, 0x05d66450, 0xbdd31108, 0xd5d03dc0,
+    0x8618701a, 0xee1b5cd2, 0x561e298a, 0x3e1d0542, 0x23f8b5cb, 0x4bfb9903,
+    0xf3feec5b, 0x9bfdc093, 0x546e77ef, 0x3c6d5b27, 0x84682e7f, 0xec6b02b7,
+    0xf18eb23e, 0x998d9ef6, 0x2188ebae, 0x498bc766, 0x1a438abc, 0x7240a674,
+    0xca45d32c, 0xa246ffe4, 0xbfa34f6d, 0xd7a063a5, 0x6fa516fd, 0x07a63a35,
+    0x8fd9098e, 0xe7da2546, 0x5fdf501e, 0x37dc7cd6, 0x2a39cc5f, 0x423ae097,
+    0xfa3f95cf, 0x923cb907, 0xc1f4f4dd, 0xa9f7d815, 0x11f2ad4d, 0x79f18185,
+    0x6414310c, 0x0c171dc4, 0xb412689c, 0xdc114454, 0x1382f328, 0x7b81dfe0,
+    0xc384aab8, 0xab878670, 0xb66236f9, 0xde611a31, 0x66646f69, 0x0e6743a1,
+    0x5daf0e7b, 0x35ac22b3, 0x8da957eb, 0xe5aa7b23, 0xf84fcbaa, 0x904ce762,
+    0x2849923a, 0x404abef2, 0xb2828a33, 0xda81a6fb, 0x6284d3a3, 0x0a87ff6b,
+    0x17624fe2, 0x7f61632a, 0xc7641672, 0xaf673aba, 0xfcaf7760, 0x94ac5ba8,
+    0x2ca92ef0, 0x44aa0238, 0x594fb2b1, 0x314c9e79, 0x8949eb21, 0xe14ac7e9,
+    0x2ed97095, 0x46da5c5d, 0xfedf2905, 0x96dc05cd, 0x8b39b544, 0xe33a998c,
+    0x5b3fecd4, 0x333cc01c, 0x60f48dc6, 0x08f7a10e, 0xb0f2d456, 0xd8f1f89e,
+    0xc5144817, 0xad1764df, 0x15121187, 0x7d113d4f
+  },
+  {
+    0x00000000, 0x493c7d27, 0x9278fa4e, 0xdb448769, 0x211d826d, 0x6821ff4a,
+    0xb3657823, 0xfa590504, 0x423b04da, 0x0b0779fd, 0xd043fe94, 0x997f83b3,
+    0x632686b7, 0x2a1afb90, 0xf15e7cf9, 0xb86201de, 0x847609b4, 0xcd4a7493,
+    0x160ef3fa, 0x5f328edd, 0xa56b8bd9, 0xec57f6fe, 0x37137197, 0x7e2f0cb0,
+    0xc64d0d6e, 0x8f717049, 0x5435f720, 0x1d098a07, 0xe7508f03, 0xae6cf224,
+    0x7528754d, 0x3c14086a, 0x0d006599, 0x443c18be, 0x9f789fd7, 0xd644e2f0,
+    0x2c1de7f4, 0x65219ad3, 0xbe651dba, 0xf759609d, 0x4f3b6143, 0x06071c64,
+    0xdd439b0d, 0x947fe62a, 0x6e26e32e, 0x271a9e09, 0xfc5e1960, 0xb5626447,
+    0x89766c2d, 0xc04a110a, 0x1b0e9663, 0x5232eb44, 0xa86bee40, 0xe1579367,
+    0x3a13140e, 0x732f6929, 0xcb4d68f7, 0x827115d0, 0x593592b9, 0x1009ef9e,
+    0xea50ea9a, 0xa36c97bd, 0x782810d4, 0x31146df3, 0x1a00cb32, 0x533cb615,
+    0x8878317c, 0xc1444c5b, 0x3b1d495f, 0x72213478, 0xa965b311, 0xe059ce36,
+    0x583bcfe8, 0x1107b2cf, 0xca4335a6, 0x837f4881, 0x79264d85, 0x301a30a2,
+    0xeb5eb7cb, 0xa262caec, 0x9e76c286, 0xd74abfa1, 0x0c0e38c8, 0x453245ef,
+    0xbf6b40eb, 0xf6573dcc, 0x2d13baa5, 0x642fc782, 0xdc4dc65c, 0x9571bb7b,
+    0x4e353c12, 0x07094135, 0xfd504431, 0xb46c3916, 0x6f28be7f, 0x2614c358,
+    0x1700aeab, 0x5e3cd38c, 0x857854e5, 0xcc4429c2, 0x361d2cc6, 0x7f2151e1,
+    0xa465d688, 0xed59abaf, 0x553baa71, 0x1c07d756, 0xc743503f, 0x8e7f2d18,
+    0x7426281c, 0x3d1a553b, 0xe65ed252, 0xaf62af75, 0x9376a71f, 0xda4ada38,
+    0x010e5d51, 0x48322076, 0xb26b2572, 0xfb575855, 0x2013df3c, 0x692fa21b,
+    0xd14da3c5, 0x9871dee2, 0x4335598b, 0x0a0924ac, 0xf05021a8, 0xb96c5c8f,
+    0x6228dbe6, 0x2b14a6c1, 0x34019664, 0x7d3deb43, 0xa6796c2a, 0xef45110d,
+    0x151c1409, 0x5c20692e, 0x8764ee47, 0xce589360, 0x763a92be, 0x3f06ef99,
+    0xe44268f0, 0xad7e15d7, 0x572710d3, 0x1e1b6df4, 0xc55fea9d, 0x8c6397ba,
+    0xb0779fd0, 0xf94be2f7, 0x220f659e, 0x6b3318b9, 0x916a1dbd, 0xd856609a,
+    0x0312e7f3, 0x4a2e9ad4, 0xf24c9b0a, 0xbb70e62d, 0x60346144, 0x29081c63,
+    0xd3511967, 0x9a6d6440, 0x4129e329, 0x08159e0e, 0x3901f3fd, 0x703d8eda,
+    0xab7909b3, 0xe2457494, 0x181c7190, 0x51200cb7, 0x8a648bde, 0xc358f6f9,
+    0x7b3af727, 0x32068a00, 0xe9420d69, 0xa07e704e, 0x5a27754a, 0x131b086d,
+    0xc85f8f04, 0x8163f223, 0xbd77fa49, 0xf44b876e, 0x2f0f0007, 0x66337d20,
+    0x9c6a7824, 0xd5560503, 0x0e12826a, 0x472eff4d, 0xff4cfe93, 0xb67083b4,
+    0x6d3404dd, 0x240879fa, 0xde517cfe, 0x976d01d9, 0x4c2986b0, 0x0515fb97,
+    0x2e015d56, 0x673d2071, 0xbc79a718, 0xf545da3f, 0x0f1cdf3b, 0x4620a21c,
+    0x9d642575, 0xd4585852, 0x6c3a598c, 0x250624ab, 0xfe42a3c2, 0xb77edee5,
+    0x4d27dbe1, 0x041ba6c6, 0xdf5f21af, 0x96635c88, 0xaa7754e2, 0xe34b29c5,
+    0x380faeac, 0x7133d38b, 0x8b6ad68f, 0xc256aba8, 0x19122cc1, 0x502e51e6,
+    0xe84c5038, 0xa1702d1f, 0x7a34aa76, 0x3308d751, 0xc951d255, 0x806daf72,
+    0x5b29281b, 0x1215553c, 0x230138cf, 0x6a3d45e8, 0xb179c281, 0xf845bfa6,
+    0x021cbaa2, 0x4b20c785, 0x906440ec, 0xd9583dcb, 0x613a3c15, 0x28064132,
+    0xf342c65b, 0xba7ebb7c, 0x4027be78, 0x091bc35f, 0xd25f4436, 0x9b633911,
+    0xa777317b, 0xee4b4c5c, 0x350fcb35, 0x7c33b612, 0x866ab316, 0xcf56ce31,
+    0x14124958, 0x5d2e347f, 0xe54c35a1, 0xac704886, 0x7734cfef, 0x3e08b2c8,
+    0xc451b7cc, 0x8d6dcaeb, 0x56294d82, 0x1f1530a5
+  }
+};
+
+#ifdef AKS_HASH_SSE42
+#define AKS_HASH_HW
+#endif
+#ifdef AKS_HASH_ARMCRC
+#define AKS_HASH_HW
+#endif
+
+#ifdef AKS_HASH_HW
+/*
+ * The CRC instructions are run as three interleaved streams over
+ * blocks of this many bytes each, so that their latency overlaps.
+ */
+#define AKS_HASH_LANE 2048
+
+/*
+ * Tables that advance a raw CRC register over AKS_HASH_LANE zero bytes,
+ * one table for each byte of the register, used to join the streams.
+ */
+static const uint32_t aks_crc32c_shift[4][256] = {
+  {
+    0x00000000, 0xf7506984, 0xeb4ca5f9, 0x1c1ccc7d, 0xd3753d03, 0x24255487,
+    0x383998fa, 0xcf69f17e, 0xa3060cf7, 0x54566573, 0x484aa90e, 0xbf1ac08a,
+    0x707331f4, 0x87235870, 0x9b3f940d, 0x6c6ffd89, 0x43e06f1f, 0xb4b0069b,
+    0xa8accae6, 0x5ffca362, 0x9095521c, 0x67c53b98, 0x7bd9f7e5, 0x8c899e61,
+    0xe0e663e8, 0x17b60a6c, 0x0baac611, 0xfcfaaf95, 0x33935eeb, 0xc4c3376f,
+    0xd8dffb12, 0x2f8f9296, 0x87c0de3e, 0x7090b7ba, 0x6c8c7bc7, 0x9bdc1243,
+    0x54b5e33d, 0xa3e58ab9, 0xbff946c4, 0x48a92f40, 0x24c6d2c9, 0xd396bb4d,
+    0xcf8a7730, 0x38da1eb4, 0xf7b3efca, 0x00e3864e, 0x1cff4a33, 0xebaf23b7,
+    0xc420b121, 0x3370d8a5, 0x2f6c14d8, 0xd83c7d5c, 0x17558c22, 0xe005e5a6,
+    0xfc1929db, 0x0b49405f, 0x6726bdd6, 0x9076d452, 0x8c6a182f, 0x7b3a71ab,
+    0xb45380d5, 0x4303e951, 0x5f1f252c, 0xa84f4ca8, 0x0a6dca8d, 0xfd3da309,
+    0xe1216f74, 0x167106f0, 0xd918f78e, 0x2e489e0a, 0x32545277, 0xc5043bf3,
+    0xa96bc67a, 0x5e3baffe, 0x42276383, 0xb5770a07, 0x7a1efb79, 0x8d4e92fd,
+    0x91525e80, 0x66023704, 0x498da592, 0xbeddcc16, 0xa2c1006b, 0x559169ef,
+    0x9af89891, 0x6da8f115, 0x71b43d68, 0x86e454ec, 0xea8ba965, 0x1ddbc0e1,
+    0x01c70c9c, 0xf6976518, 0x39fe9466, 0xceaefde2, 0xd2b2319f, 0x25e2581b,
+    0x8dad14b3, 0x7afd7d37, 0x66e1b14a, 0x91b1d8ce, 0x5ed829b0, 0xa9884034,
+    0xb5948c49, 0x42c4e5cd, 0x2eab1844, 0xd9fb71c0, 0xc5e7bdbd, 0x32b7d439,
+    0xfdde2547, 0x0a8e4cc3, 0x169280be, 0xe1c2e93a, 0xce4d7bac, 0x391d1228,
+    0x2501de55, 0xd251b7d1, 0x1d3846af, 0xea682f2b, 0xf674e356, 0x01248ad2,
+    0x6d4b775b, 0x9a1b1edf, 0x8607d2a2, 0x7157bb26, 0xbe3e4a58, 0x496e23dc,
+    0x5572efa1, 0xa2228625, 0x14db951a, 0xe38bfc9e, 0xff9730e3, 0x08c75967,
+    0xc7aea819, 0x30fec19d, 0x2ce20de0, 0xdbb26464, 0xb7dd99ed, 0x408df069,
+    0x5c913c14, 0xabc15590, 0x64a8a4ee, 0x93f8cd6a, 0x8fe40117, 0x78b46893,
+    0x573bfa05, 0xa06b9381, 0xbc775ffc, 0x4b273678, 0x844ec706, 0x731eae82,
+    0x6f0262ff, 0x98520b7b, 0xf43df6f2, 0x036d9f76, 0x1f71530b, 0xe8213a8f,
+    0x2748cbf1, 0xd018a275, 0xcc046e08, 0x3b54078c, 0x931b4b24, 0x644b22a0,
+    0x7857eedd, 0x8f078759, 0x406e7627, 0xb73e1fa3, 0xab22d3de, 0x5c72ba5a,
+    0x301d47d3, 0xc74d2e57, 0xdb51e22a, 0x2c018bae, 0xe3687ad0, 0x14381354,
+    0x0824df29, 0xff74b6ad, 0xd0fb243b, 0x27ab4dbf, 0x3bb781c2, 0xcce7e846,
+    0x038e1938, 0xf4de70bc, 0xe8c2bcc1, 0x1f92d545, 0x73fd28cc, 0x84ad4148,
+    0x98b18d35, 0x6fe1e4b1, 0xa08815cf, 0x57d87c4b, 0x4bc4b036, 0xbc94d9b2,
+    0x1eb65f97, 0xe9e63613, 0xf5fafa6e, 0x02aa93ea, 0xcdc36294, 0x3a930b10,
+    0x268fc76d, 0xd1dfaee9, 0xbdb05360, 0x4ae03ae4, 0x56fcf699, 0xa1ac9f1d,
+    0x6ec56e63, 0x999507e7, 0x8589cb9a, 0x72d9a21e, 0x5d563088, 0xaa06590c,
+    0xb61a9571, 0x414afcf5, 0x8e230d8b, 0x7973640f, 0x656fa872, 0x923fc1f6,
+    0xfe503c7f, 0x090055fb, 0x151c9986, 0xe24cf002, 0x2d25017c, 0xda7568f8,
+    0xc669a485, 0x3139cd01, 0x997681a9, 0x6e26e82d, 0x723a2450, 0x856a4dd4,
+    0x4a03bcaa, 0xbd53d52e, 0xa14f1953, 0x561f70d7, 0x3a708d5e, 0xcd20e4da,
+    0xd13c28a7, 0x266c4123, 0xe905b05d, 0x1e55d9d9, 0x024915a4, 0xf5197c20,
+    0xda96eeb6, 0x2dc68732, 0x31da4b4f, 0xc68a22cb, 0x09e3d3b5, 0xfeb3ba31,
+    0xe2af764c, 0x15ff1fc8, 0x7990e241, 0x8ec08bc5, 0x92dc47b8, 0x658c2e3c,
+    0xaae5df42, 0x5db5b6c6, 0x41a97abb, 0xb6f9133f
+  },
+  {
+    0x00000000, 0x29b72a34, 0x536e5468, 0x7ad97e5c, 0xa6dca8d0, 0x8f6b82e4,
+    0xf5b2fcb8, 0xdc05d68c, 0x48552751, 0x61e20d65, 0x1b3b7339, 0x328c590d,
+    0xee898f81, 0xc73ea5b5, 0xbde7dbe9, 0x9450f1dd, 0x90aa4ea2, 0xb91d6496,
+    0xc3c41aca, 0xea7330fe, 0x3676e672, 0x1fc1cc46, 0x6518b21a, 0x4caf982e,
+    0xd8ff69f3, 0xf14843c7, 0x8b913d9b, 0xa22617af, 0x7e23c123, 0x5794eb17,
+    0x2d4d954b, 0x04fabf7f, 0x24b8ebb5, 0x0d0fc181, 0x77d6bfdd, 0x5e6195e9,
+    0x82644365, 0xabd36951, 0xd10a170d, 0xf8bd3d39, 0x6cedcce4, 0x455ae6d0,
+    0x3f83988c, 0x1634b2b8, 0xca316434, 0xe3864e00, 0x995f305c, 0xb0e81a68,
+    0xb412a517, 0x9da58f23, 0xe77cf17f, 0xcecbdb4b, 0x12ce0dc7, 0x3b7927f3,
+    0x41a059af, 0x6817739b, 0xfc478246, 0xd5f0a872, 0xaf29d62e, 0x869efc1a,
+    0x5a9b2a96, 0x732c00a2, 0x09f57efe, 0x204254ca, 0x4971d76a, 0x60c6fd5e,
+    0x1a1f8302, 0x33a8a936, 0xefad7fba, 0xc61a558e, 0xbcc32bd2, 0x957401e6,
+    0x0124f03b, 0x2893da0f, 0x524aa453, 0x7bfd8e67, 0xa7f858eb, 0x8e4f72df,
+    0xf4960c83, 0xdd2126b7, 0xd9db99c8, 0xf06cb3fc, 0x8ab5cda0, 0xa302e794,
+    0x7f073118, 0x56b01b2c, 0x2c696570, 0x05de4f44, 0x918ebe99, 0xb83994ad,
+    0xc2e0eaf1, 0xeb57c0c5, 0x37521649, 0x1ee53c7d, 0x643c4221, 0x4d8b6815,
+    0x6dc93cdf, 0x447e16eb, 0x3ea768b7, 0x17104283, 0xcb15940f, 0xe2a2be3b,
+    0x987bc067, 0xb1ccea53, 0x259c1b8e, 0x0c2b31ba, 0x76f24fe6, 0x5f4565d2,
+    0x8340b35e, 0xaaf7996a, 0xd02ee736, 0xf999cd02, 0xfd63727d, 0xd4d45849,
+    0xae0d2615, 0x87ba0c21, 0x5bbfdaad, 0x7208f099, 0x08d18ec5, 0x2166a4f1,
+    0xb536552c, 0x9c817f18, 0xe6580144, 0xcfef2b70, 0x13eafdfc, 0x3a5dd7c8,
+    0x4084a994, 0x693383a0, 0x92e3aed4, 0xbb5484e0, 0xc18dfabc, 0xe83ad088,
+    0x343f0604, 0x1d882c30, 0x6751526c, 0x4ee67858, 0xdab68985, 0xf301a3b1,
+    0x89d8dded, 0xa06ff7d9, 0x7c6a2155, 0x55dd0b61, 0x2f04753d, 0x06b35f09,
+    0x0249e076, 0x2bfeca42, 0x5127b41e, 0x78909e2a, 0xa49548a6, 0x8d226292,
+    0xf7fb1cce, 0xde4c36fa, 0x4a1cc727, 0x63abed13, 0x1972934f, 0x30c5b97b,
+    0xecc06ff7, 0xc57745c3, 0xbfae3b9f, 0x961911ab, 0xb65b4561, 0x9fec6f55,
+    0xe5351109, 0xcc823b3d, 0x1087edb1, 0x3930c785, 0x43e9b9d9, 0x6a5e93ed,
+    0xfe0e6230, 0xd7b94804, 0xad603658, 0x84d71c6c, 0x58d2cae0, 0x7165e0d4,
+    0x0bbc9e88, 0x220bb4bc, 0x26f10bc3, 0x0f4621f7, 0x759f5fab, 0x5c28759f,
+    0x802da313, 0xa99a8927, 0xd343f77b, 0xfaf4dd4f, 0x6ea42c92, 0x471306a6,
+    0x3dca78fa, 0x147d52ce, 0xc8788442, 0xe1cfae76, 0x9b16d02a, 0xb2a1fa1e,
+    0xdb9279be, 0xf225538a, 0x88fc2dd6, 0xa14b07e2, 0x7d4ed16e, 0x54f9fb5a,
+    0x2e208506, 0x0797af32, 0x93c75eef, 0xba7074db, 0xc0a90a87, 0xe91e20b3,
+    0x351bf63f, 0x1cacdc0b, 0x6675a257, 0x4fc28863, 0x4b38371c, 0x628f1d28,
+    0x18566374, 0x31e14940, 0xede49fcc, 0xc453b5f8, 0xbe8acba4, 0x973de190,
+    0x036d104d, 0x2ada3a79, 0x50034425, 0x79b46e11, 0xa5b1b89d, 0x8c0692a9,
+    0xf6dfecf5, 0xdf68c6c1, 0xff2a920b, 0xd69db83f, 0xac44c663, 0x85f3ec57,
+    0x59f63adb, 0x704110ef, 0x0a986eb3, 0x232f4487, 0xb77fb55a, 0x9ec89f6e,
+    0xe411e132, 0xcda6cb06, 0x11a31d8a, 0x381437be, 0x42cd49e2, 0x6b7a63d6,
+    0x6f80dca9, 0x4637f69d, 0x3cee88c1, 0x1559a2f5, 0xc95c7479, 0xe0eb5e4d,
+    0x9a322011, 0xb3850a25, 0x27d5fbf8, 0x0e62d1cc, 0x74bbaf90, 0x5d0c85a4,
+    0x81095328, 0xa8be791c, 0xd2670740, 0xfbd02d74
+  },
+  {
+    0x00000000, 0x202b2b59, 0x405656b2, 0x607d7deb, 0x80acad64, 0xa087863d,
+    0xc0fafbd6, 0xe0d1d08f, 0x04b52c39, 0x249e0760, 0x44e37a8b, 0x64c851d2,
+    0x8419815d, 0xa432aa04, 0xc44fd7ef, 0xe464fcb6, 0x096a5872, 0x2941732b,
+    0x493c0ec0, 0x69172599, 0x89c6f516, 0xa9edde4f, 0xc990a3a4, 0xe9bb88fd,
+    0x0ddf744b, 0x2df45f12, 0x4d8922f9, 0x6da209a0, 0x8d73d92f, 0xad58f276,
+    0xcd258f9d, 0xed0ea4c4, 0x12d4b0e4, 0x32ff9bbd, 0x5282e656, 0x72a9cd0f,
+    0x92781d80, 0xb25336d9, 0xd22e4b32, 0xf205606b, 0x16619cdd, 0x364ab784,
+    0x5637ca6f, 0x761ce136, 0x96cd31b9, 0xb6e61ae0, 0xd69b670b, 0xf6b04c52,
+    0x1bbee896, 0x3b95c3cf, 0x5be8be24, 0x7bc3957d, 0x9b1245f2, 0xbb396eab,
+    0xdb441340, 0xfb6f3819, 0x1f0bc4af, 0x3f20eff6, 0x5f5d921d, 0x7f76b944,
+    0x9fa769cb, 0xbf8c4292, 0xdff13f79, 0xffda1420, 0x25a961c8, 0x05824a91,
+    0x65ff377a, 0x45d41c23, 0xa505ccac, 0x852ee7f5, 0xe5539a1e, 0xc578b147,
+    0x211c4df1, 0x013766a8, 0x614a1b43, 0x4161301a, 0xa1b0e095, 0x819bcbcc,
+    0xe1e6b627, 0xc1cd9d7e, 0x2cc339ba, 0x0ce812e3, 0x6c956f08, 0x4cbe4451,
+    0xac6f94de, 0x8c44bf87, 0xec39c26c, 0xcc12e935, 0x28761583, 0x085d3eda,
+    0x68204331, 0x480b6868, 0xa8dab8e7, 0x88f193be, 0xe88cee55, 0xc8a7c50c,
+    0x377dd12c, 0x1756fa75, 0x772b879e, 0x5700acc7, 0xb7d17c48, 0x97fa5711,
+    0xf7872afa, 0xd7ac01a3, 0x33c8fd15, 0x13e3d64c, 0x739eaba7, 0x53b580fe,
+    0xb3645071, 0x934f7b28, 0xf33206c3, 0xd3192d9a, 0x3e17895e, 0x1e3ca207,
+    0x7e41dfec, 0x5e6af4b5, 0xbebb243a, 0x9e900f63, 0xfeed7288, 0xdec659d1,
+    0x3aa2a567, 0x1a898e3e, 0x7af4f3d5, 0x5adfd88c, 0xba0e0803, 0x9a25235a,
+    0xfa585eb1, 0xda7375e8, 0x4b52c390, 0x6b79e8c9, 0x0b049522, 0x2b2fbe7b,
+    0xcbfe6ef4, 0xebd545ad, 0x8ba83846, 0xab83131f, 0x4fe7efa9, 0x6fccc4f0,
+    0x0fb1b91b, 0x2f9a9242, 0xcf4b42cd, 0xef606994, 0x8f1d147f, 0xaf363f26,
+    0x42389be2, 0x6213b0bb, 0x026ecd50, 0x2245e609, 0xc2943686, 0xe2bf1ddf,
+    0x82c26034, 0xa2e94b6d, 0x468db7db, 0x66a69c82, 0x06dbe169, 0x26f0ca30,
+    0xc6211abf, 0xe60a31e6, 0x86774c0d, 0xa65c6754, 0x59867374, 0x79ad582d,
+    0x19d025c6, 0x39fb0e9f, 0xd92ade10, 0xf901f549, 0x997c88a2, 0xb957a3fb,
+    0x5d335f4d, 0x7d187414, 0x1d6509ff, 0x3d4e22a6, 0xdd9ff229, 0xfdb4d970,
+    0x9dc9a49b, 0xbde28fc2, 0x50ec2b06, 0x70c7005f, 0x10ba7db4, 0x309156ed,
+    0xd0408662, 0xf06bad3b, 0x9016d0d0, 0xb03dfb89, 0x5459073f, 0x74722c66,
+    0x140f518d, 0x34247ad4, 0xd4f5aa5b, 0xf4de8102, 0x94a3fce9, 0xb488d7b0,
+    0x6efba258, 0x4ed08901, 0x2eadf4ea, 0x0e86dfb3, 0xee570f3c, 0xce7c2465,
+    0xae01598e, 0x8e2a72d7, 0x6a4e8e61, 0x4a65a538, 0x2a18d8d3, 0x0a33f38a,
+    0xeae22305, 0xcac9085c, 0xaab475b7, 0x8a9f5eee, 0x6791fa2a, 0x47bad173,
+    0x27c7ac98, 0x07ec87c1, 0xe73d574e, 0xc7167c17, 0xa76b01fc, 0x87402aa5,
+    0x6324d613, 0x430ffd4a, 0x237280a1, 0x0359abf8, 0xe3887b77, 0xc3a3502e,
+    0xa3de2dc5, 0x83f5069c, 0x7c2f12bc, 0x5c0439e5, 0x3c79440e, 0x1c526f57,
+    0xfc83bfd8, 0xdca89481, 0xbcd5e96a, 0x9cfec233, 0x789a3e85, 0x58b115dc,
+    0x38cc6837, 0x18e7436e, 0xf83693e1, 0xd81db8b8, 0xb860c553, 0x984bee0a,
+    0x75454ace, 0x556e6197, 0x35131c7c, 0x15383725, 0xf5e9e7aa, 0xd5c2ccf3,
+    0xb5bfb118, 0x95949a41, 0x71f066f7, 0x51db4dae, 0x31a63045, 0x118d1b1c,
+    0xf15ccb93, 0xd177e0ca, 0xb10a9d21, 0x9121b678
+  },
+  {
+    0x00000000, 0x96a58720, 0x28a778b1, 0xbe02ff91, 0x514ef162, 0xc7eb7642,
+    0x79e989d3, 0xef4c0ef3, 0xa29de2c4, 0x343865e4, 0x8a3a9a75, 0x1c9f1d55,
+    0xf3d313a6, 0x65769486, 0xdb746b17, 0x4dd1ec37, 0x40d7b379, 0xd6723459,
+    0x6870cbc8, 0xfed54ce8, 0x1199421b, 0x873cc53b, 0x393e3aaa, 0xaf9bbd8a,
+    0xe24a51bd, 0x74efd69d, 0xcaed290c, 0x5c48ae2c, 0xb304a0df, 0x25a127ff,
+    0x9ba3d86e, 0x0d065f4e, 0x81af66f2, 0x170ae1d2, 0xa9081e43, 0x3fad9963,
+    0xd0e19790, 0x464410b0, 0xf846ef21, 0x6ee36801, 0x23328436, 0xb5970316,
+    0x0b95fc87, 0x9d307ba7, 0x727c7554, 0xe4d9f274, 0x5adb0de5, 0xcc7e8ac5,
+    0xc178d58b, 0x57dd52ab, 0xe9dfad3a, 0x7f7a2a1a, 0x903624e9, 0x0693a3c9,
+    0xb8915c58, 0x2e34db78, 0x63e5374f, 0xf540b06f, 0x4b424ffe, 0xdde7c8de,
+    0x32abc62d, 0xa40e410d, 0x1a0cbe9c, 0x8ca939bc, 0x06b2bb15, 0x90173c35,
+    0x2e15c3a4, 0xb8b04484, 0x57fc4a77, 0xc159cd57, 0x7f5b32c6, 0xe9feb5e6,
+    0xa42f59d1, 0x328adef1, 0x8c882160, 0x1a2da640, 0xf561a8b3, 0x63c42f93,
+    0xddc6d002, 0x4b635722, 0x4665086c, 0xd0c08f4c, 0x6ec270dd, 0xf867f7fd,
+    0x172bf90e, 0x818e7e2e, 0x3f8c81bf, 0xa929069f, 0xe4f8eaa8, 0x725d6d88,
+    0xcc5f9219, 0x5afa1539, 0xb5b61bca, 0x23139cea, 0x9d11637b, 0x0bb4e45b,
+    0x871ddde7, 0x11b85ac7, 0xafbaa556, 0x391f2276, 0xd6532c85, 0x40f6aba5,
+    0xfef45434, 0x6851d314, 0x25803f23, 0xb325b803, 0x0d274792, 0x9b82c0b2,
+    0x74cece41, 0xe26b4961, 0x5c69b6f0, 0xcacc31d0, 0xc7ca6e9e, 0x516fe9be,
+    0xef6d162f, 0x79c8910f, 0x96849ffc, 0x002118dc, 0xbe23e74d, 0x2886606d,
+    0x65578c5a, 0xf3f20b7a, 0x4df0f4eb, 0xdb5573cb, 0x34197d38, 0xa2bcfa18,
+    0x1cbe0589, 0x8a1b82a9, 0x0d65762a, 0x9bc0f10a, 0x25c20e9b, 0xb36789bb,
+    0x5c2b8748, 0xca8e0068, 0x748cfff9, 0xe22978d9, 0xaff894ee, 0x395d13ce,
+    0x875fec5f, 0x11fa6b7f, 0xfeb6658c, 0x6813e2ac, 0xd6111d3d, 0x40b49a1d,
+    0x4db2c553, 0xdb174273, 0x6515bde2, 0xf3b03ac2, 0x1cfc3431, 0x8a59b311,
+    0x345b4c80, 0xa2fecba0, 0xef2f2797, 0x798aa0b7, 0xc7885f26, 0x512dd806,
+    0xbe61d6f5, 0x28c451d5, 0x96c6ae44, 0x00632964, 0x8cca10d8, 0x1a6f97f8,
+    0xa46d6869, 0x32c8ef49, 0xdd84e1ba, 0x4b21669a, 0xf523990b, 0x63861e2b,
+    0x2e57f21c, 0xb8f2753c, 0x06f08aad, 0x90550d8d, 0x7f19037e, 0xe9bc845e,
+    0x57be7bcf, 0xc11bfcef, 0xcc1da3a1, 0x5ab82481, 0xe4badb10, 0x721f5c30,
+    0x9d5352c3, 0x0bf6d5e3, 0xb5f42a72, 0x2351ad52, 0x6e804165, 0xf825c645,
+    0x462739d4, 0xd082bef4, 0x3fceb007, 0xa96b3727, 0x1769c8b6, 0x81cc4f96,
+    0x0bd7cd3f, 0x9d724a1f, 0x2370b58e, 0xb5d532ae, 0x5a993c5d, 0xcc3cbb7d,
+    0x723e44ec, 0xe49bc3cc, 0xa94a2ffb, 0x3fefa8db, 0x81ed574a, 0x1748d06a,
+    0xf804de99, 0x6ea159b9, 0xd0a3a628, 0x46062108, 0x4b007e46, 0xdda5f966,
+    0x63a706f7, 0xf50281d7, 0x1a4e8f24, 0x8ceb0804, 0x32e9f795, 0xa44c70b5,
+    0xe99d9c82, 0x7f381ba2, 0xc13ae433, 0x579f6313, 0xb8d36de0, 0x2e76eac0,
+    0x90741551, 0x06d19271, 0x8a78abcd, 0x1cdd2ced, 0xa2dfd37c, 0x347a545c,
+    0xdb365aaf, 0x4d93dd8f, 0xf391221e, 0x6534a53e, 0x28e54909, 0xbe40ce29,
+    0x004231b8, 0x96e7b698, 0x79abb86b, 0xef0e3f4b, 0x510cc0da, 0xc7a947fa,
+    0xcaaf18b4, 0x5c0a9f94, 0xe2086005, 0x74ade725, 0x9be1e9d6, 0x0d446ef6,
+    0xb3469167, 0x25e31647, 0x6832fa70, 0xfe977d50, 0x409582c1, 0xd63005e1,
+    0x397c0b12, 0xafd98c32, 0x11db73a3, 0x877ef483
+  }
+};
+
+/*
+ * Advance a raw CRC register over AKS_HASH_LANE zero bytes.
+ */
+AKS_INTERNAL uint32_t aks_crc32c_skip(uint32_t crc) {
+  return aks_crc32c_shift[0][crc & 0xff] ^
+          aks_crc32c_shift[1][(crc >> 8) & 0xff] ^
+          aks_crc32c_shift[2][(crc >> 16) & 0xff] ^
+          aks_crc32c_shift[3][crc >> 24];
+}
+#endif
+
+#ifdef AKS_HASH_SSE42
+/*
+ * Check whether the processor supports the SSE 4.2 CRC instructions.
+ * 
+ * Return:
+ * 
+ *   non-zero if supported, zero if not
+ */
+AKS_INTERNAL int aks_crc32c_hw(void) {
+#ifdef AKS_HASH_SSE42_CHECK
+  static int avail = -1;
+#ifdef _MSC_VER
+  int r[4];
+#endif
+  
+  if (avail < 0) {
+#ifdef _MSC_VER
+    __cpuid(r, 1);
+    avail = (r[2] >> 20) & 1;
+#else
+    avail = __builtin_cpu_supports("sse4.2") ? 1 : 0;
+#endif
+  }
+  return avail;
+  
+#else
+  return 1;
+#endif
+}
+
+/*
+ * Update an inverted CRC with the SSE 4.2 instructions.
+ */
+AKS_HASH_SSE42_FN
+AKS_INTERNAL uint32_t aks_crc32c_sse42(
+    uint32_t crc, const unsigned char *p, size_t len) {
+  
+#ifdef AKS_HASH_SSE42_64
+  uint64_t v0 = 0;
+  uint64_t v1 = 0;
+  uint64_t v2 = 0;
+#else
+  uint32_t v0 = 0;
+  uint32_t v1 = 0;
+  uint32_t v2 = 0;
+#endif
+  uint32_t c1 = 0;
+  uint32_t c2 = 0;
+  size_t i = 0;
+  
+  while ((len > 0) && (((uintptr_t) p) & (sizeof(v0) - 1))) {
+    crc = _mm_crc32_u8(crc, *p);
+    p++;
+    len--;
+  }
+  
+  /* Run three streams over each block of three lanes and join them */
+  while (len >= 3 * AKS_HASH_LANE) {
+    c1 = 0;
+    c2 = 0;
+    for(i = 0; i < AKS_HASH_LANE; i += sizeof(v0)) {
+      memcpy(&v0, p + i, sizeof(v0));
+      memcpy(&v1, p + AKS_HASH_LANE + i, sizeof(v0));
+      memcpy(&v2, p + 2 * AKS_HASH_LANE + i, sizeof(v0));
+#ifdef AKS_HASH_SSE42_64
+      crc = (uint32_t) _mm_crc32_u64(crc, v0);
+      c1 = (uint32_t) _mm_crc32_u64(c1, v1);
+      c2 = (uint32_t) _mm_crc32_u64(c2, v2);
+#else
+      crc = _mm_crc32_u32(crc, v0);
+      c1 = _mm_crc32_u32(c1, v1);
+      c2 = _mm_crc32_u32(c2, v2);
+#endif
+    }
+    crc = aks_crc32c_skip(crc) ^ c1;
+    crc = aks_crc32c_skip(crc) ^ c2;
+    p += 3 * AKS_HASH_LANE;
+    len -= 3 * AKS_HASH_LANE;
+  }
+  
+  while (len >= sizeof(v0)) {
+    memcpy(&v0, p, sizeof(v0));
+#ifdef AKS_HASH_SSE42_64
+    crc = (uint32_t) _mm_crc32_u64(crc, v0);
+#else
+    crc = _mm_crc32_u32(crc, v0);
+#endif
+    p += sizeof(v0);
+    len -= sizeof(v0);
+  }
+  
+  while (len > 0) {
+    crc = _mm_crc32_u8(crc, *p);
+    p++;
+    len--;
+  }
+  
+  return crc;
+}
+#endif
+
+#ifdef AKS_HASH_ARMCRC
+/*
+ * Update an inverted CRC with the ARMv8 CRC instructions.
+ */
+AKS_INTERNAL uint32_t aks_crc32c_arm(
+    uint32_t crc, const unsigned char *p, size_t len) {
+  
+  uint64_t v0 = 0;
+  uint64_t v1 = 0;
+  uint64_t v2 = 0;
+  uint32_t c1 = 0;
+  uint32_t c2 = 0;
+  size_t i = 0;
+  
+  while ((len > 0) && (((uintptr_t) p) & 7)) {
+    crc = __crc32cb(crc, *p);
+    p++;
+    len--;
+  }
+  
+  /* Run three streams over each block of three lanes and join them */
+  while (len >= 3 * AKS_HASH_LANE) {
+    c1 = 0;
+    c2 = 0;
+    for(i = 0; i < AKS_HASH_LANE; i += 8) {
+      memcpy(&v0, p + i, 8);
+      memcpy(&v1, p + AKS_HASH_LANE + i, 8);
+      memcpy(&v2, p + 2 * AKS_HASH_LANE + i, 8);
+      crc = __crc32cd(crc, v0);
+      c1 = __crc32cd(c1, v1);
+      c2 = __crc32cd(c2, v2);
+    }
+    crc = aks_crc32c_skip(crc) ^ c1;
+    crc = aks_crc32c_skip(crc) ^ c2;
+    p += 3 * AKS_HASH_LANE;
+    len -= 3 * AKS_HASH_LANE;
+  }
+  
+  while (len >= 8) {
+    memcpy(&v0, p, 8);
+    crc = __crc32cd(crc, v0);
+    p += 8;
+    len -= 8;
+  }
+  
+  while (len > 0) {
+    crc = __crc32cb(crc, *p);
+    p++;
+    len--;
+  }
+  
+  return crc;
+}
+#endif
+
+/*
+ * Compute or continue a CRC-32C (Castagnoli) checksum.
+ * 
+ * To checksum data in chunks, start with zero and pass the result of
+ * each call to the next.  The SSE 4.2 or ARMv8 CRC instructions are
+ * used where available, and slicing-by-8 tables otherwise.
+ * 
+ * Parameters:
+ * 
+ *   crc - zero, or the checksum of the preceding data
+ * 
+ *   pData - the data
+ * 
+ *   len - the length of the data in bytes
+ * 
+ * Return:
+ * 
+ *   the checksum of all the data so far
+ */
+AKS_API uint32_t aks_crc32c(uint32_t crc, const void *pData, size_t len) {
+  
+  const unsigned char *p = (const unsigned char *) pData;
+  
+  crc = ~crc;
+  
+#ifdef AKS_HASH_SSE42
+  if (aks_crc32c_hw()) {
+    return ~aks_crc32c_sse42(crc, p, len);
+  }
+#endif
+#ifdef AKS_HASH_ARMCRC
+  return ~aks_crc32c_arm(crc, p, len);
+#else
+  
+  /* Fold in eight bytes at a time, reading them one by one so that the
+   * result does not depend on byte order */
+  while (len >= 8) {
+    crc ^= ((uint32_t) p[0]) |
+            (((uint32_t) p[1]) << 8) |
+            (((uint32_t) p[2]) << 16) |
+            (((uint32_t) p[3]) << 24);
+    crc = aks_crc32c_tab[7][crc & 0xff] ^
+          aks_crc32c_tab[6][(crc >> 8) & 0xff] ^
+          aks_crc32c_tab[5][(crc >> 16) & 0xff] ^
+          aks_crc32c_tab[4][crc >> 24] ^
+          aks_crc32c_tab[3][p[4]] ^
+          aks_crc32c_tab[2][p[5]] ^
+          aks_crc32c_tab[1][p[6]] ^
+          aks_crc32c_tab[0][p[7]];
+    p += 8;
+    len -= 8;
+  }
+  
+  while (len > 0) {
+    crc = aks_crc32c_tab[0][(crc ^ *p) & 0xff] ^ (crc >> 8);
+    p++;
+    len--;
+  }
+  
+  return ~crc;
+#endif
+}
+
+#endif
+
+/*
+ * The XXH64 primes.
+ */
+#define AKS_HASH_P1 UINT64_C(0x9e3779b185ebca87)
+#define AKS_HASH_P2 UINT64_C(0xc2b2ae3d27d4eb4f)
+#define AKS_HASH_P3 UINT64_C(0x165667b19e3779f9)
+#define AKS_HASH_P4 UINT64_C(0x85ebca77c2b2ae63)
+#define AKS_HASH_P5 UINT64_C(0x27d4eb2f165667c5)
+
+/*
+ * Rotate a 64-bit value left.
+ */
+#define aks_hash_rotl(x, r) (((x) << (r)) | ((x) >> (64 - (r))))
+
+/*
+ * State of a streaming 64-bit hash.
+ */
+typedef struct {
+  
+  /* The four lanes, and the seed they started from */
+  uint64_t v[4];
+  uint64_t seed;
+  
+  /* The total length hashed so far */
+  uint64_t total;
+  
+  /* Bytes waiting for a full 32-byte stripe */
+  unsigned char buf[32];
+  size_t fill;
+  
+} aks_hash64_state;
+
+/* Read words directly on machines known to be little-endian */
+#ifdef __BYTE_ORDER__
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define AKS_HASH_LE
+#endif
+#endif
+#ifdef _MSC_VER
+#define AKS_HASH_LE
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Read a little-endian 64-bit value.
+ */
+AKS_INTERNAL uint64_t aks_hash_read64(const unsigned char *p) {
+#ifdef AKS_HASH_LE
+  uint64_t v = 0;
+  memcpy(&v, p, 8);
+  return v;
+#else
+  return ((uint64_t) p[0]) |
+          (((uint64_t) p[1]) << 8) |
+          (((uint64_t) p[2]) << 16) |
+          (((uint64_t) p[3]) << 24) |
+          (((uint64_t) p[4]) << 32) |
+          (((uint64_t) p[5]) << 40) |
+          (((uint64_t) p[6]) << 48) |
+          (((uint64_t) p[7]) << 56);
+#endif
+}
+
+/*
+ * Read a little-endian 32-bit value.
+ */
+AKS_INTERNAL uint64_t aks_hash_read32(const unsigned char *p) {
+#ifdef AKS_HASH_LE
+  uint32_t v = 0;
+  memcpy(&v, p, 4);
+  return (uint64_t) v;
+#else
+  return ((uint64_t) p[0]) |
+          (((uint64_t) p[1]) << 8) |
+          (((uint64_t) p[2]) << 16) |
+          (((uint64_t) p[3]) << 24);
+#endif
+}
+
+/*
+ * Mix eight bytes of input into a lane.
+ */
+AKS_INTERNAL uint64_t aks_hash_round(uint64_t acc, uint64_t input) {
+  acc += input * AKS_HASH_P2;
+  acc = aks_hash_rotl(acc, 31);
+  return acc * AKS_HASH_P1;
+}
+
+/*
+ * Mix a lane into the combined hash.
+ */
+AKS_INTERNAL uint64_t aks_hash_merge(uint64_t h, uint64_t v) {
+  h ^= aks_hash_round(0, v);
+  return h * AKS_HASH_P1 + AKS_HASH_P4;
+}
+
+/*
+ * Hash whole 32-byte stripes into the four lanes.
+ * 
+ * Return:
+ * 
+ *   the number of bytes consumed
+ */
+AKS_INTERNAL size_t aks_hash_stripes(
+    uint64_t v[4], const unsigned char *p, size_t len) {
+  
+  size_t done = 0;
+  
+  while (len - done >= 32) {
+    v[0] = aks_hash_round(v[0], aks_hash_read64(p + done));
+    v[1] = aks_hash_round(v[1], aks_hash_read64(p + done + 8));
+    v[2] = aks_hash_round(v[2], aks_hash_read64(p + done + 16));
+    v[3] = aks_hash_round(v[3], aks_hash_read64(p + done + 24));
+    done += 32;
+  }
+  
+  return done;
+}
+
+/*
+ * Finish a hash from the lanes or seed, the total length, and the
+ * final partial stripe.
+ */
+AKS_INTERNAL uint64_t aks_hash_finish(
+    const uint64_t        v[4],
+          uint64_t        seed,
+          uint64_t        total,
+    const unsigned char * p,
+          size_t          len) {
+  
+  uint64_t h = 0;
+  
+  /* Combine the lanes if at least one stripe was hashed */
+  if (total >= 32) {
+    h = aks_hash_rotl(v[0], 1) + aks_hash_rotl(v[1], 7) +
+        aks_hash_rotl(v[2], 12) + aks_hash_rotl(v[3], 18);
+    h = aks_hash_merge(h, v[0]);
+    h = aks_hash_merge(h, v[1]);
+    h = aks_hash_merge(h, v[2]);
+    h = aks_hash_merge(h, v[3]);
+  } else {
+    h = seed + AKS_HASH_P5;
+  }
+  h += total;
+  
+  /* Mix in the remaining bytes */
+  while (len >= 8) {
+    h ^= aks_hash_round(0, aks_hash_read64(p));
+    h = aks_hash_rotl(h, 27) * AKS_HASH_P1 + AKS_HASH_P4;
+    p += 8;
+    len -= 8;
+  }
+  if (len >= 4) {
+    h ^= aks_hash_read32(p) * AKS_HASH_P1;
+    h = aks_hash_rotl(h, 23) * AKS_HASH_P2 + AKS_HASH_P3;
+    p += 4;
+    len -= 4;
+  }
+  while (len > 0) {
+    h ^= ((uint64_t) *p) * AKS_HASH_P5;
+    h = aks_hash_rotl(h, 11) * AKS_HASH_P1;
+    p++;
+    len--;
+  }
+  
+  /* Avalanche */
+  h ^= h >> 33;
+  h *= AKS_HASH_P2;
+  h ^= h >> 29;
+  h *= AKS_HASH_P3;
+  h ^= h >> 32;
+  
+  return h;
+}
+
+/*
+ * Start a streaming 64-bit hash.
+ * 
+ * Parameters:
+ * 
+ *   ps - the state to initialize
+ * 
+ *   seed - the seed
+ */
+AKS_API void aks_hash64_init(aks_hash64_state *ps, uint64_t seed) {
+  ps->v[0] = seed + AKS_HASH_P1 + AKS_HASH_P2;
+  ps->v[1] = seed + AKS_HASH_P2;
+  ps->v[2] = seed;
+  ps->v[3] = seed - AKS_HASH_P1;
+  ps->seed = seed;
+  ps->total = 0;
+  ps->fill = 0;
+}
+
+/*
+ * Add data to a streaming 64-bit hash.
+ * 
+ * Parameters:
+ * 
+ *   ps - the state
+ * 
+ *   pData - the data
+ * 
+ *   len - the length of the data in bytes
+ */
+AKS_API void aks_hash64_update(
+    aks_hash64_state *ps, const void *pData, size_t len) {
+  
+  const unsigned char *p = (const unsigned char *) pData;
+  size_t n = 0;
+  
+  ps->total += (uint64_t) len;
+  
+  /* Top up a partial stripe first */
+  if (ps->fill > 0) {
+    n = 32 - ps->fill;
+    if (n > len) {
+      n = len;
+    }
+    memcpy(ps->buf + ps->fill, p, n);
+    ps->fill += n;
+    p += n;
+    len -= n;
+    if (ps->fill < 32) {
+      return;
+    }
+    aks_hash_stripes(ps->v, ps->buf, 32);
+    ps->fill = 0;
+  }
+  
+  /* Hash whole stripes in place and keep the rest */
+  n = aks_hash_stripes(ps->v, p, len);
+  memcpy(ps->buf, p + n, len - n);
+  ps->fill = len - n;
+}
+
+/*
+ * Get the result of a streaming 64-bit hash.  The state is not
+ * changed, so more data may be added afterwards.
+ * 
+ * Parameters:
+ * 
+ *   ps - the state
+ * 
+ * Return:
+ * 
+ *   the hash of all the data added so far
+ */
+AKS_API uint64_t aks_hash64_final(const aks_hash64_state *ps) {
+  return aks_hash_finish(ps->v, ps->seed, ps->total, ps->buf, ps->fill);
+}
+
+/*
+ * Compute a fast 64-bit non-cryptographic hash.
+ * 
+ * The result is the XXH64 hash of the data, and is the same on every
+ * platform and as from the streaming functions.
+ * 
+ * Parameters:
+ * 
+ *   pData - the data
+ * 
+ *   len - the length of the data in bytes
+ * 
+ *   seed - the seed
+ * 
+ * Return:
+ * 
+ *   the hash
+ */
+AKS_API uint64_t aks_hash64(const void *pData, size_t len, uint64_t seed) {
+  
+  const unsigned char *p = (const unsigned char *) pData;
+  uint64_t v[4];
+  size_t n = 0;
+  
+  v[0] = seed + AKS_HASH_P1 + AKS_HASH_P2;
+  v[1] = seed + AKS_HASH_P2;
+  v[2] = seed;
+  v[3] = seed - AKS_HASH_P1;
+  
+  n = aks_hash_stripes(v, p, len);
+  return aks_hash_finish(v, seed, (uint64_t) len, p + n, len - n);
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API uint32_t aks_crc32c(uint32_t crc, const void *pData, size_t len);
+AKS_API void aks_hash64_init(aks_hash64_state *ps, uint64_t seed);
+AKS_API void aks_hash64_update(
+    aks_hash64_state *ps, const void *pData, size_t len);
+AKS_API uint64_t aks_hash64_final(const aks_hash64_state *ps);
+AKS_API uint64_t aks_hash64(const void *pData, size_t len, uint64_t seed);
+
+#endif
+#endif
+
+/* * * * * * * * * *
+ *                 *
+ * String builder  *
+ *                 *
+ * * * * * * * * * */
+
+/* Only proceed if string builder requested and not already defined */
+#ifdef AKS_SBUF
+#ifndef AKS_SBUF_INCLUDED
+#define AKS_SBUF_INCLUDED
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * The capacity of the first buffer allocated for a string builder.
+ * After that, the capacity doubles each time the buffer fills up.
+ */
+#ifndef AKS_SBUF_MINSIZE
+#define AKS_SBUF_MINSIZE 64
+#endif
+
+/*
+ * A growable string builder.
+ * 
+ * pBuf is the nul-terminated string, or NULL if nothing has been
+ * allocated yet.  len is the length of the string, not including the
+ * nul.  cap is the size of the allocated buffer, including room for
+ * the nul.
+ */
+typedef struct {
+  char *pBuf;
+  size_t len;
+  size_t cap;
+} aks_sbuf;
+
+/*
+ * Get the current string of a builder, which is never NULL.
+ */
+#define aks_sbuf_str(ps) (((ps)->pBuf != NULL) ? (ps)->pBuf : "")
+
+#ifdef AKS_BODIES
+
+/*
+ * Initialize a string builder to the empty string.
+ * 
+ * Nothing is allocated until the first append or reserve.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder to initialize
+ */
+AKS_API void aks_sbuf_init(aks_sbuf *ps) {
+  ps->pBuf = NULL;
+  ps->len = 0;
+  ps->cap = 0;
+}
+
+/*
+ * Release the buffer of a string builder and reset it to empty.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder to release
+ */
+AKS_API void aks_sbuf_free(aks_sbuf *ps) {
+  free(ps->pBuf);
+  aks_sbuf_init(ps);
+}
+
+/*
+ * Make sure a string builder has room to append a given number of
+ * characters without reallocating.
+ * 
+ * The buffer grows to at least double its previous capacity, so a
+ * sequence of appends takes time proportional to the final length.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ *   n - the number of characters that will be appended
+ * 
+ * Return:
+ * 
+ *   0 if successful, -1 if allocation failed, in which case the builder
+ *   is unchanged
+ */
+AKS_API int aks_sbuf_reserve(aks_sbuf *ps, size_t n) {
+  
+  size_t need = 0;
+  size_t cap = 0;
+  char *pNew = NULL;
+  
+  /* Compute the required size, including the nul */
+  if (n > ((size_t) -1) - ps->len - 1) {
+    return -1;
+  }
+  need = ps->len + n + 1;
+  if (need <= ps->cap) {
+    return 0;
+  }
+  
+  /* Double the capacity until large enough */
+  cap = (ps->cap > 0) ? ps->cap : AKS_SBUF_MINSIZE;
+  while (cap < need) {
+    if (cap > ((size_t) -1) / 2) {
+      cap = need;
+    } else {
+      cap = cap * 2;
+    }
+  }
+  
+  pNew = (char *) realloc(ps->pBuf, cap);
+  if (pNew == NULL) {
+    return -1;
+  }
+  
+  if (ps->pBuf == NULL) {
+    pNew[0] = (char) 0;
+  }
+  ps->pBuf = pNew;
+  ps->cap = cap;
+  
+  return 0;
+}
+
+/*
+ * Append characters to a string builder.
+ * 
+ * The characters need not be nul-terminated and may not overlap the
+ * buffer of the builder.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ *   pStr - the characters to append
+ * 
+ *   len - the number of characters
+ * 
+ * Return:
+ * 
+ *   0 if successful, -1 if allocation failed, in which case the builder
+ *   is unchanged
+ */
+AKS_API int aks_sbuf_append(aks_sbuf *ps, const char *pStr, size_t len) {
+  
+  if (aks_sbuf_reserve(ps, len)) {
+    return -1;
+  }
+  
+  memcpy(ps->pBuf + ps->len, pStr, len);
+  ps->len += len;
+  ps->pBuf[ps->len] = (char) 0;
+  
+  return 0;
+}
+
+/*
+ * Append a nul-terminated string to a string builder.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ *   pStr - the string to append
+ * 
+ * Return:
+ * 
+ *   0 if successful, -1 if allocation failed
+ */
+AKS_API int aks_sbuf_puts(aks_sbuf *ps, const char *pStr) {
+  return aks_sbuf_append(ps, pStr, strlen(pStr));
+}
+
+/*
+ * Append a single character to a string builder.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ *   c - the character to append
+ * 
+ * Return:
+ * 
+ *   0 if successful, -1 if allocation failed
+ */
+AKS_API int aks_sbuf_putc(aks_sbuf *ps, int c) {
+  
+  if (ps->len + 1 >= ps->cap) {
+    if (aks_sbuf_reserve(ps, 1)) {
+      return -1;
+    }
+  }
+  
+  ps->pBuf[ps->len] = (char) c;
+  ps->len++;
+  ps->pBuf[ps->len] = (char) 0;
+  
+  return 0;
+}
+
+/*
+ * Append an unsigned 64-bit integer in decimal to a string builder.
+ * 
+ * The digits are formatted directly into the buffer.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ *   v - the value to append
+ * 
+ * Return:
+ * 
+ *   0 if successful, -1 if allocation failed
+ */
+AKS_API int aks_sbuf_u64(aks_sbuf *ps, uint64_t v) {
+  
+  if (aks_sbuf_reserve(ps, AKS_FMT_INT_BUFSIZE)) {
+    return -1;
+  }
+  
+  ps->len += aks_fmt_u64(ps->pBuf + ps->len, v);
+  return 0;
+}
+
+/*
+ * Append a signed 64-bit integer in decimal to a string builder.
+ * 
+ * The digits are formatted directly into the buffer.
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ *   v - the value to append
+ * 
+ * Return:
+ * 
+ *   0 if successful, -1 if allocation failed
+ */
+AKS_API int aks_sbuf_i64(aks_sbuf *ps, int64_t v) {
+  
+  if (aks_sbuf_reserve(ps, AKS_FMT_INT_BUFSIZE)) {
+    return -1;
+  }
+  
+  ps->len += aks_fmt_i64(ps->pBuf + ps->len, v);
+  return 0;
+}
+
+/*
+ * Take ownership of the string built by a string builder.
+ * 
+ * The builder is reset to empty and the returned string should
+ * eventually be released with free().
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ * Return:
+ * 
+ *   the dynamically allocated string, or NULL if allocation failed, in
+ *   which case the builder is unchanged
+ */
+AKS_API char *aks_sbuf_detach(aks_sbuf *ps) {
+  
+  char *pResult = NULL;
+  
+  /* Make sure that an empty builder still has a buffer */
+  if (aks_sbuf_reserve(ps, 0)) {
+    return NULL;
+  }
+  
+  pResult = ps->pBuf;
+  aks_sbuf_init(ps);
+  
+  return pResult;
+}
+
+/*
+ * Convert the string built by a string builder to a generic string for
+ * the API, as aks_toapi() would.
+ * 
+ * The builder is reset to empty.  On POSIX and on Windows in ANSI mode,
+ * the buffer of the builder is handed over as the result without any
+ * copying.  On Windows in Unicode mode, the UTF-8 string is converted
+ * into a new UTF-16 string using the known length, and the buffer of
+ * the builder is released.  Either way, the returned string should
+ * eventually be released with free().
+ * 
+ * Parameters:
+ * 
+ *   ps - the builder
+ * 
+ * Return:
+ * 
+ *   the dynamically allocated generic string, or NULL if error, in
+ *   which case the builder is unchanged
+ */
+AKS_API aks_tchar *aks_sbuf_toapi(aks_sbuf *ps) {
+#ifdef AKS_WIN_WAPI
+  aks_tchar *pResult = NULL;
+  int sz = 0;
+  
+  /* The conversion counts in int, and includes the nul */
+  if (ps->len >= (size_t) INT_MAX) {
+    return NULL;
+  }
+  if (ps->pBuf == NULL) {
+    return aks_toapi("");
+  }
+  
+  /* Determine the size of the translation, then perform it */
+  sz = MultiByteToWideChar(
+        CP_UTF8,
+        MB_ERR_INVALID_CHARS,
+        ps->pBuf,
+        (int) (ps->len + 1),
+        NULL,
+        0);
+  
+  if (sz > 0) {
+    pResult = (aks_tchar *) malloc(((size_t) sz) * sizeof(aks_tchar));
+  }
+  
+  if (pResult != NULL) {
+    if (!MultiByteToWideChar(
+          CP_UTF8,
+          MB_ERR_INVALID_CHARS,
+          ps->pBuf,
+          (int) (ps->len + 1),
+          pResult,
+          sz)) {
+      free(pResult);
+      pResult = NULL;
+    }
+  }
+  
+  if (pResult != NULL) {
+    aks_sbuf_free(ps);
+  }
+  
+  return pResult;
+  
+#else
+  return aks_sbuf_detach(ps);
+#endif
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API void aks_sbuf_init(aks_sbuf *ps);
+AKS_API void aks_sbuf_free(aks_sbuf *ps);
+AKS_API int aks_sbuf_reserve(aks_sbuf *ps, size_t n);
+AKS_API int aks_sbuf_append(aks_sbuf *ps, const char *pStr, size_t len);
+AKS_API int aks_sbuf_puts(aks_sbuf *ps, const char *pStr);
+AKS_API int aks_sbuf_putc(aks_sbuf *ps, int c);
+AKS_API int aks_sbuf_u64(aks_sbuf *ps, uint64_t v);
+AKS_API int aks_sbuf_i64(aks_sbuf *ps, int64_t v);
+AKS_API char *aks_sbuf_detach(aks_sbuf *ps);
+AKS_API aks_tchar *aks_sbuf_toapi(aks_sbuf *ps);
+
+#endif
+#endif
+
+/* * * * * * * * * * * *
+ *                     *
+ * Preallocated output *
+ *                     *
+ * * * * * * * * * * * */
+
+/* Only proceed if preallocated output requested and not already
+ * defined */
+#ifdef AKS_PREALLOC
+#ifndef AKS_PREALLOC_INCLUDED
+#define AKS_PREALLOC_INCLUDED
+
+/*
+ * The default number of bytes by which a mapped output file grows when
+ * it fills up.
+ */
+#ifndef AKS_MAPOUT_STEP
+#define AKS_MAPOUT_STEP 67108864
+#endif
+
+#ifdef AKS_POSIX
+/* POSIX implementation of preallocated output ====================== */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Reserving space goes through fileno(), which is only declared when
+ * POSIX declarations are visible */
+#if AKS_POSIX_DECL >= 1
+#ifdef FALLOC_FL_KEEP_SIZE
+#define AKS_PREALLOC_KEEPSIZE
+#endif
+#ifdef F_PREALLOCATE
+#define AKS_PREALLOC_CONTIG
+#endif
+#endif
+
+/* Mapped output files are sized with ftruncate(), which is declared
+ * from the POSIX.1b revision or with the X/Open extensions, and grown
+ * with posix_fallocate() where it is declared, which takes POSIX.1-2001
+ * and the advisory information option */
+#if AKS_POSIX_DECL >= 199309L
+#define AKS_PREALLOC_MAPOUT
+#elif AKS_POSIX_DECL_XOPEN >= 199506L
+#define AKS_PREALLOC_MAPOUT
+#endif
+
+#if AKS_POSIX_DECL >= 200112L
+#ifdef _POSIX_ADVISORY_INFO
+#if _POSIX_ADVISORY_INFO > 0
+#define AKS_PREALLOC_FALLOCATE
+#endif
+#endif
+#endif
+
+/*
+ * A mapped output file.
+ * 
+ * pBase is the mapping of the first cap bytes of the file, or NULL if
+ * nothing has been mapped yet.  len is the number of bytes written so
+ * far, which becomes the size of the file when it is closed.
+ */
+typedef struct {
+  unsigned char *pBase;
+  size_t len;
+  size_t cap;
+  size_t step;
+  int fd;
+} aks_mapout;
+
+#ifdef AKS_BODIES
+
+/*
+ * Reserve disk space for the first len bytes of the file underlying a
+ * stream, without changing the size of the file.
+ * 
+ * On Linux, this uses fallocate() with FALLOC_FL_KEEP_SIZE.  On macOS,
+ * this uses F_PREALLOCATE, asking for contiguous space first.  If the
+ * platform or file system cannot reserve space without changing the
+ * file size, nothing is done and the call succeeds.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ *   len - the number of bytes to reserve from the start of the file
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_prealloc(FILE *fp, aks_off64 len) {
+  
+#ifdef AKS_PREALLOC_KEEPSIZE
+  if (len <= 0) {
+    return 0;
+  }
+  
+  if (fallocate(fileno(fp), FALLOC_FL_KEEP_SIZE, 0, (off_t) len) != 0) {
+    if ((errno != EOPNOTSUPP) && (errno != ENOSYS)) {
+      return -1;
+    }
+  }
+  
+#else
+#ifdef AKS_PREALLOC_CONTIG
+  fstore_t fst;
+  struct stat st;
+  
+  if (fstat(fileno(fp), &st) != 0) {
+    return -1;
+  }
+  if (st.st_size >= len) {
+    return 0;
+  }
+  
+  /* F_PEOFPOSMODE allocates the given length past the current end */
+  memset(&fst, 0, sizeof(fstore_t));
+  fst.fst_flags = F_ALLOCATECONTIG | F_ALLOCATEALL;
+  fst.fst_posmode = F_PEOFPOSMODE;
+  fst.fst_offset = 0;
+  fst.fst_length = len - st.st_size;
+  
+  if (fcntl(fileno(fp), F_PREALLOCATE, &fst) == -1) {
+    fst.fst_flags = F_ALLOCATEALL;
+    if (fcntl(fileno(fp), F_PREALLOCATE, &fst) == -1) {
+      if (errno != ENOTSUP) {
+        return -1;
+      }
+    }
+  }
+  
+#else
+  (void) fp;
+  (void) len;
+#endif
+#endif
+  
+  return 0;
+}
+
+#ifdef AKS_PREALLOC_MAPOUT
+
+/*
+ * Extend a mapped output file so that at least the given number of
+ * bytes are mapped.
+ * 
+ * The file grows to the next multiple of the step size.  The new space
+ * is allocated with posix_fallocate() where available, so that it is
+ * contiguous on disk where the file system allows.  The new mapping is
+ * made before the old one is removed, so the old mapping is intact if
+ * this fails.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ *   need - the number of bytes that must be mapped
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_mapout_grow(aks_mapout *pm, size_t need) {
+  
+  size_t cap = 0;
+  void *pNew = NULL;
+  int extended = 0;
+  int err = 0;
+  
+  /* Round up to the step size, checking that off_t can hold it */
+  cap = need + (pm->step - (need % pm->step)) % pm->step;
+  if ((cap < need) || (((size_t) ((off_t) cap)) != cap) ||
+      (((off_t) cap) < 0)) {
+    errno = EFBIG;
+    return -1;
+  }
+  
+  /* Extend the file, falling back to a sparse extension if the file
+   * system cannot allocate */
+#ifdef AKS_PREALLOC_FALLOCATE
+  err = posix_fallocate(pm->fd, (off_t) pm->cap, (off_t) (cap - pm->cap));
+  if (err == 0) {
+    extended = 1;
+  } else if ((err != EINVAL) && (err != EOPNOTSUPP)) {
+    errno = err;
+    return -1;
+  }
+#else
+  (void) err;
+#endif
+  if (!extended) {
+    if (ftruncate(pm->fd, (off_t) cap) != 0) {
+      return -1;
+    }
+  }
+  
+  /* Map the whole file again and release the old mapping */
+  pNew = mmap(NULL, cap, PROT_READ | PROT_WRITE, MAP_SHARED, pm->fd, 0);
+  if (pNew == MAP_FAILED) {
+    return -1;
+  }
+  if (pm->pBase != NULL) {
+    munmap((void *) pm->pBase, pm->cap);
+  }
+  
+  pm->pBase = (unsigned char *) pNew;
+  pm->cap = cap;
+  
+  return 0;
+}
+
+/*
+ * Create a mapped output file, replacing any existing file.
+ * 
+ * The file is written through a shared memory mapping that grows by
+ * step bytes at a time, and is truncated to the number of bytes
+ * actually written when it is closed.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the file
+ * 
+ *   step - the number of bytes to grow by, or zero for AKS_MAPOUT_STEP
+ * 
+ * Return:
+ * 
+ *   the new mapped output file, or NULL if error
+ */
+AKS_API aks_mapout *aks_mapout_open(const char *pPath, size_t step) {
+  
+  aks_mapout *pm = NULL;
+  int flags = O_RDWR | O_CREAT | O_TRUNC;
+  
+#ifdef O_CLOEXEC
+  flags |= O_CLOEXEC;
+#endif
+  
+  pm = (aks_mapout *) calloc(1, sizeof(aks_mapout));
+  if (pm == NULL) {
+    return NULL;
+  }
+  
+  pm->fd = open(pPath, flags, 0666);
+  if (pm->fd == -1) {
+    free(pm);
+    return NULL;
+  }
+  
+  pm->pBase = NULL;
+  pm->step = (step > 0) ? step : AKS_MAPOUT_STEP;
+  
+  return pm;
+}
+
+/*
+ * Close a mapped output file, truncating it to the number of bytes
+ * written.
+ * 
+ * The mapped output file is released even if there is an error.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_mapout_close(aks_mapout *pm) {
+  
+  int result = 0;
+  
+  if (pm->pBase != NULL) {
+    if (munmap((void *) pm->pBase, pm->cap) != 0) {
+      result = -1;
+    }
+  }
+  
+  if (ftruncate(pm->fd, (off_t) pm->len) != 0) {
+    result = -1;
+  }
+  if (close(pm->fd) != 0) {
+    result = -1;
+  }
+  
+  free(pm);
+  return result;
+}
+
+#endif
+
+#endif
+
+#else
+/* Windows implementation of preallocated output ==================== */
+
+#include <io.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+#define AKS_PREALLOC_MAPOUT
+
+/*
+ * A mapped output file.
+ * 
+ * pBase is the view of the first cap bytes of the file, or NULL if
+ * nothing has been mapped yet.  len is the number of bytes written so
+ * far, which becomes the size of the file when it is closed.
+ */
+typedef struct {
+  unsigned char *pBase;
+  size_t len;
+  size_t cap;
+  size_t step;
+  HANDLE hFile;
+  HANDLE hMap;
+} aks_mapout;
+
+#ifdef AKS_BODIES
+
+/*
+ * Reserve disk space for the first len bytes of the file underlying a
+ * stream, without changing the size of the file.
+ * 
+ * This sets the allocation size with SetFileInformationByHandle().  The
+ * allocation is never set below the current size of the file, since
+ * that would truncate it.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ *   len - the number of bytes to reserve from the start of the file
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_prealloc(FILE *fp, aks_off64 len) {
+  
+  HANDLE h = NULL;
+  LARGE_INTEGER sz;
+  FILE_ALLOCATION_INFO fai;
+  
+  h = (HANDLE) _get_osfhandle(_fileno(fp));
+  if (h == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  
+  if (!GetFileSizeEx(h, &sz)) {
+    return -1;
+  }
+  if (sz.QuadPart >= len) {
+    return 0;
+  }
+  
+  memset(&fai, 0, sizeof(FILE_ALLOCATION_INFO));
+  fai.AllocationSize.QuadPart = len;
+  if (!SetFileInformationByHandle(
+        h,
+        FileAllocationInfo,
+        &fai,
+        (DWORD) sizeof(FILE_ALLOCATION_INFO))) {
+    return -1;
+  }
+  
+  return 0;
+}
+
+/*
+ * Extend a mapped output file so that at least the given number of
+ * bytes are mapped.
+ * 
+ * The file grows to the next multiple of the step size, which happens
+ * when the larger file mapping object is created.  The new view is made
+ * before the old one is removed, so the old view is intact if this
+ * fails.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ *   need - the number of bytes that must be mapped
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_mapout_grow(aks_mapout *pm, size_t need) {
+  
+  size_t cap = 0;
+  HANDLE hMap = NULL;
+  void *pNew = NULL;
+  
+  cap = need + (pm->step - (need % pm->step)) % pm->step;
+  if (cap < need) {
+    return -1;
+  }
+  
+  hMap = CreateFileMapping(
+          pm->hFile,
+          NULL,
+          PAGE_READWRITE,
+          (DWORD) (((uint64_t) cap) >> 32),
+          (DWORD) (((uint64_t) cap) & 0xffffffffUL),
+          NULL);
+  if (hMap == NULL) {
+    return -1;
+  }
+  
+  pNew = MapViewOfFile(hMap, FILE_MAP_WRITE, 0, 0, cap);
+  if (pNew == NULL) {
+    CloseHandle(hMap);
+    return -1;
+  }
+  
+  if (pm->pBase != NULL) {
+    UnmapViewOfFile((LPCVOID) pm->pBase);
+    CloseHandle(pm->hMap);
+  }
+  
+  pm->pBase = (unsigned char *) pNew;
+  pm->hMap = hMap;
+  pm->cap = cap;
+  
+  return 0;
+}
+
+/*
+ * Create a mapped output file, replacing any existing file.
+ * 
+ * The file is written through a view of a file mapping that grows by
+ * step bytes at a time, and is truncated to the number of bytes
+ * actually written when it is closed.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the file
+ * 
+ *   step - the number of bytes to grow by, or zero for AKS_MAPOUT_STEP
+ * 
+ * Return:
+ * 
+ *   the new mapped output file, or NULL if error
+ */
+AKS_API aks_mapout *aks_mapout_open(const char *pPath, size_t step) {
+  
+  aks_mapout *pm = NULL;
+  aks_tchar *pt = NULL;
+  
+  pt = aks_toapi(pPath);
+  if (pt == NULL) {
+    return NULL;
+  }
+  
+  pm = (aks_mapout *) calloc(1, sizeof(aks_mapout));
+  if (pm != NULL) {
+    pm->hFile = CreateFile(
+                  pt,
+                  GENERIC_READ | GENERIC_WRITE,
+                  0,
+                  NULL,
+                  CREATE_ALWAYS,
+                  FILE_ATTRIBUTE_NORMAL,
+                  NULL);
+    if (pm->hFile == INVALID_HANDLE_VALUE) {
+      free(pm);
+      pm = NULL;
+    }
+  }
+  
+  free(pt);
+  pt = NULL;
+  
+  if (pm != NULL) {
+    pm->pBase = NULL;
+    pm->hMap = NULL;
+    pm->step = (step > 0) ? step : AKS_MAPOUT_STEP;
+  }
+  
+  return pm;
+}
+
+/*
+ * Close a mapped output file, truncating it to the number of bytes
+ * written.
+ * 
+ * The mapped output file is released even if there is an error.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_mapout_close(aks_mapout *pm) {
+  
+  int result = 0;
+  LARGE_INTEGER pos;
+  
+  if (pm->pBase != NULL) {
+    if (!UnmapViewOfFile((LPCVOID) pm->pBase)) {
+      result = -1;
+    }
+    CloseHandle(pm->hMap);
+  }
+  
+  pos.QuadPart = (LONGLONG) pm->len;
+  if (!SetFilePointerEx(pm->hFile, pos, NULL, FILE_BEGIN)) {
+    result = -1;
+  } else if (!SetEndOfFile(pm->hFile)) {
+    result = -1;
+  }
+  if (!CloseHandle(pm->hFile)) {
+    result = -1;
+  }
+  
+  free(pm);
+  return result;
+}
+
+#endif
+
+#endif
+
+#ifdef AKS_BODIES
+#ifdef AKS_PREALLOC_MAPOUT
+
+/*
+ * Get a pointer to space for the next n bytes of a mapped output file,
+ * growing the file if necessary.
+ * 
+ * The bytes do not count as written until aks_mapout_commit() is
+ * called.  The pointer is only valid until the next call that may grow
+ * the file.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ *   n - the number of bytes to reserve
+ * 
+ * Return:
+ * 
+ *   pointer to the reserved space, or NULL if error
+ */
+AKS_API void *aks_mapout_reserve(aks_mapout *pm, size_t n) {
+  
+  if (n > ((size_t) -1) - pm->len) {
+    return NULL;
+  }
+  
+  if ((pm->pBase == NULL) || (pm->len + n > pm->cap)) {
+    if (aks_mapout_grow(pm, (pm->len + n > 0) ? (pm->len + n) : 1)) {
+      return NULL;
+    }
+  }
+  
+  return (void *) (pm->pBase + pm->len);
+}
+
+/*
+ * Mark bytes written into space from aks_mapout_reserve() as written.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ *   n - the number of bytes written, which may not be more than were
+ *   reserved
+ */
+AKS_API void aks_mapout_commit(aks_mapout *pm, size_t n) {
+  pm->len += n;
+}
+
+/*
+ * Append bytes to a mapped output file.
+ * 
+ * Parameters:
+ * 
+ *   pm - the mapped output file
+ * 
+ *   pData - the bytes to write
+ * 
+ *   n - the number of bytes
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_mapout_write(aks_mapout *pm, const void *pData, size_t n) {
+  
+  void *p = NULL;
+  
+  p = aks_mapout_reserve(pm, n);
+  if (p == NULL) {
+    return -1;
+  }
+  
+  memcpy(p, pData, n);
+  pm->len += n;
+  
+  return 0;
+}
+
+#endif
+#endif
+
+/* Public function declarations */
+AKS_API int aks_prealloc(FILE *fp, aks_off64 len);
+#ifdef AKS_PREALLOC_MAPOUT
+AKS_API aks_mapout *aks_mapout_open(const char *pPath, size_t step);
+AKS_API int aks_mapout_close(aks_mapout *pm);
+AKS_API void *aks_mapout_reserve(aks_mapout *pm, size_t n);
+AKS_API void aks_mapout_commit(aks_mapout *pm, size_t n);
+AKS_API int aks_mapout_write(aks_mapout *pm, const void *pData, size_t n);
+#endif
+
+#endif
+#endif
+
+/* * * * * * * * *
+ *               *
+ * Event tracing *
+ *               *
+ * * * * * * * * */
+
+/* If tracing is not requested, define the tracing macros to do nothing
+ * so that instrumented code compiles to nothing */
+#ifndef AKS_TRACE
+#ifndef aks_trace_begin
+
+#define aks_trace_begin(name) ((void) 0)
+#define aks_trace_end(name) ((void) 0)
+#define aks_trace_instant(name) ((void) 0)
+#define aks_trace_begin_arg(name, key, v) ((void) 0)
+#define aks_trace_end_arg(name, key, v) ((void) 0)
+#define aks_trace_instant_arg(name, key, v) ((void) 0)
+#define aks_trace_write(pPath) (0)
+
+#endif
+#endif
+
+/* Only proceed if tracing requested and not already defined */
+#ifdef AKS_TRACE
+#ifndef AKS_TRACE_INCLUDED
+#define AKS_TRACE_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef AKS_POSIX
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+/*
+ * The number of events kept for each thread, which must be a power of
+ * two.  When a thread records more, its oldest events are overwritten.
+ */
+#ifndef AKS_TRACE_EVENTS
+#define AKS_TRACE_EVENTS 65536
+#endif
+
+#if ((AKS_TRACE_EVENTS & (AKS_TRACE_EVENTS - 1)) != 0)
+#error aksmacro: AKS_TRACE_EVENTS must be a power of two.
+#endif
+
+/*
+ * The most threads that can record events.  Events from any further
+ * threads are dropped.
+ */
+#ifndef AKS_TRACE_THREADS
+#define AKS_TRACE_THREADS 256
+#endif
+
+/*
+ * The file the trace is written to at exit, unless the AKS_TRACE_FILE
+ * environment variable names another one.
+ */
+#ifndef AKS_TRACE_PATH
+#define AKS_TRACE_PATH "aks_trace.json"
+#endif
+
+/* Select the thread-local storage class */
+#ifdef _MSC_VER
+#define AKS_TRACE_TLS __declspec(thread)
+#else
+#ifdef __GNUC__
+#define AKS_TRACE_TLS __thread
+#else
+#ifdef __STDC_VERSION__
+#if (__STDC_VERSION__ >= 201112L)
+#define AKS_TRACE_TLS _Thread_local
+#endif
+#endif
+#endif
+#endif
+
+#ifndef AKS_TRACE_TLS
+#error aksmacro: AKS_TRACE needs thread-local storage.
+#endif
+
+/*
+ * Define the tracing macros.
+ * 
+ * The name and the argument key must be strings that last until the
+ * trace is written, such as string literals, because only the pointers
+ * are recorded.
+ */
+#define aks_trace_begin(name) aks_trace_emit((name), 'B', NULL, 0)
+#define aks_trace_end(name) aks_trace_emit((name), 'E', NULL, 0)
+#define aks_trace_instant(name) aks_trace_emit((name), 'i', NULL, 0)
+
+#define aks_trace_begin_arg(name, key, v) \
+  aks_trace_emit((name), 'B', (key), (int64_t) (v))
+#define aks_trace_end_arg(name, key, v) \
+  aks_trace_emit((name), 'E', (key), (int64_t) (v))
+#define aks_trace_instant_arg(name, key, v) \
+  aks_trace_emit((name), 'i', (key), (int64_t) (v))
+
+/*
+ * A recorded event.
+ */
+typedef struct {
+  uint64_t ts;
+  const char *pName;
+  const char *pKey;
+  int64_t arg;
+  int phase;
+} aks_trace_event;
+
+/*
+ * The events of one thread.
+ * 
+ * Only the owning thread writes to the buffer.  head counts all the
+ * events ever recorded, and is stored with release ordering after each
+ * event is filled in.
+ */
+typedef struct {
+  volatile size_t head;
+  aks_trace_event ev[AKS_TRACE_EVENTS];
+} aks_trace_buf;
+
+#ifdef AKS_BODIES
+
+/*
+ * The buffers of all threads that have recorded events, as pointers
+ * stored with release ordering, and the number of slots claimed.
+ * 
+ * This state and the exit handler belong to the translation unit that
+ * compiles the bodies.  With the default static linkage, each source
+ * file that defines AKS_TRACE gets its own, and every one of them
+ * writes the same trace file at exit, so only one survives.  Programs
+ * that record events from more than one source file must therefore
+ * use AKS_EXTERN, with AKS_IMPLEMENTATION in exactly one of them.
+ */
+static volatile size_t aks_trace_slot[AKS_TRACE_THREADS];
+static volatile size_t aks_trace_count = 0;
+
+/*
+ * Set once the exit handler has been registered.
+ */
+static volatile size_t aks_trace_registered = 0;
+
+/*
+ * The buffer of the current thread, or NULL if it has none yet.
+ */
+static AKS_TRACE_TLS aks_trace_buf *aks_trace_self = NULL;
+
+/*
+ * Set once the current thread has failed to get a buffer, so that it
+ * drops its events without trying again.
+ */
+static AKS_TRACE_TLS int aks_trace_failed = 0;
+
+/*
+ * Get a monotonic timestamp in nanoseconds.
+ */
+AKS_INTERNAL uint64_t aks_trace_now(void) {
+#ifdef AKS_POSIX
+#ifdef CLOCK_MONOTONIC
+  struct timespec ts;
+  
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (((uint64_t) ts.tv_sec) * 1000000000) + ((uint64_t) ts.tv_nsec);
+#else
+  return ((uint64_t) time(NULL)) * 1000000000;
+#endif
+
+#else
+  static LARGE_INTEGER freq;
+  LARGE_INTEGER c;
+  uint64_t f = 0;
+  
+  if (freq.QuadPart == 0) {
+    QueryPerformanceFrequency(&freq);
+  }
+  QueryPerformanceCounter(&c);
+  
+  f = (uint64_t) freq.QuadPart;
+  return ((((uint64_t) c.QuadPart) / f) * 1000000000) +
+          (((((uint64_t) c.QuadPart) % f) * 1000000000) / f);
+#endif
+}
+
+/*
+ * Write a string to a trace file as a JSON string literal.
+ */
+AKS_INTERNAL void aks_trace_putstr(FILE *fp, const char *pStr) {
+  
+  static const char hex[17] = "0123456789abcdef";
+  const unsigned char *p = (const unsigned char *) pStr;
+  
+  fputc('"', fp);
+  for( ; *p != 0; p++) {
+    if ((*p == '"') || (*p == '\\')) {
+      fputc('\\', fp);
+      fputc(*p, fp);
+    } else if (*p < 0x20) {
+      fputs("\\u00", fp);
+      fputc(hex[*p >> 4], fp);
+      fputc(hex[*p & 0xf], fp);
+    } else {
+      fputc(*p, fp);
+    }
+  }
+  fputc('"', fp);
+}
+
+/*
+ * Write the events recorded so far to a file in the Chrome trace event
+ * format, which Perfetto and chrome://tracing can open.
+ * 
+ * Each buffer is read up to a snapshot of its head taken with acquire
+ * ordering, but the events themselves are read without synchronization.
+ * Other threads must therefore have stopped recording, for example by
+ * being joined, before this is called; a thread that keeps recording
+ * can overwrite events while they are read, which is a data race.  The
+ * same applies to the exit handler, so stop recording threads before
+ * returning from main() or calling exit().
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the file
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_trace_write(const char *pPath) {
+  
+  FILE *fp = NULL;
+  aks_trace_buf *pb = NULL;
+  const aks_trace_event *pe = NULL;
+  char nbuf[AKS_FMT_INT_BUFSIZE];
+  char pbuf[AKS_FMT_INT_BUFSIZE];
+  size_t count = 0;
+  size_t head = 0;
+  size_t i = 0;
+  size_t j = 0;
+  int first = 1;
+  int result = 0;
+  
+  fp = fopent(pPath, "wb");
+  if (fp == NULL) {
+    return -1;
+  }
+  
+#ifdef AKS_POSIX
+  aks_fmt_u64(pbuf, (uint64_t) getpid());
+#else
+  aks_fmt_u64(pbuf, (uint64_t) GetCurrentProcessId());
+#endif
+  
+  fputs("{\"traceEvents\":[", fp);
+  
+  count = aks_ring_load(&aks_trace_count);
+  if (count > AKS_TRACE_THREADS) {
+    count = AKS_TRACE_THREADS;
+  }
+  for(i = 0; i < count; i++) {
+    pb = (aks_trace_buf *) aks_ring_load(&(aks_trace_slot[i]));
+    if (pb == NULL) {
+      continue;
+    }
+    
+    /* Write the events still in the buffer, oldest first, up to a
+     * snapshot of the head */
+    head = aks_ring_load(&(pb->head));
+    j = (head > AKS_TRACE_EVENTS) ? (head - AKS_TRACE_EVENTS) : 0;
+    for( ; j < head; j++) {
+      pe = &(pb->ev[j & (AKS_TRACE_EVENTS - 1)]);
+      
+      fputs(first ? "\n{\"name\":" : ",\n{\"name\":", fp);
+      first = 0;
+      aks_trace_putstr(fp, pe->pName);
+      
+      fputs(",\"ph\":\"", fp);
+      fputc(pe->phase, fp);
+      if (pe->phase == 'i') {
+        fputs("\",\"s\":\"t", fp);
+      }
+      
+      /* Timestamps are in microseconds */
+      fputs("\",\"ts\":", fp);
+      aks_fmt_u64(nbuf, pe->ts / 1000);
+      fputs(nbuf, fp);
+      /* Format the fraction with a leading 1 to keep its zeros, then
+       * replace the 1 with the decimal point */
+      aks_fmt_u64(nbuf, 1000 + (pe->ts % 1000));
+      nbuf[0] = '.';
+      fputs(nbuf, fp);
+      
+      fputs(",\"pid\":", fp);
+      fputs(pbuf, fp);
+      fputs(",\"tid\":", fp);
+      aks_fmt_u64(nbuf, (uint64_t) (i + 1));
+      fputs(nbuf, fp);
+      
+      if (pe->pKey != NULL) {
+        fputs(",\"args\":{", fp);
+        aks_trace_putstr(fp, pe->pKey);
+        fputc(':', fp);
+        aks_fmt_i64(nbuf, pe->arg);
+        fputs(nbuf, fp);
+        fputc('}', fp);
+      }
+      fputc('}', fp);
+    }
+  }
+  
+  fputs("\n],\"displayTimeUnit\":\"ns\"}\n", fp);
+  
+  if (ferror(fp)) {
+    result = -1;
+  }
+  if (fclose(fp) != 0) {
+    result = -1;
+  }
+  
+  return result;
+}
+
+/*
+ * Write the trace when the program exits.
+ */
+AKS_INTERNAL void aks_trace_atexit(void) {
+  
+  const char *pPath = NULL;
+  
+  pPath = getenvt("AKS_TRACE_FILE");
+  if (pPath == NULL) {
+    pPath = AKS_TRACE_PATH;
+  } else if (pPath[0] == 0) {
+    pPath = AKS_TRACE_PATH;
+  }
+  
+  aks_trace_write(pPath);
+}
+
+/*
+ * Allocate and publish the buffer of the current thread, registering
+ * the exit handler the first time.
+ * 
+ * The buffer is allocated before a slot is claimed, so that a failed
+ * allocation does not use up a slot.  Either failure is remembered for
+ * the thread.
+ * 
+ * Return:
+ * 
+ *   the buffer, or NULL if it could not be allocated or all the slots
+ *   are taken
+ */
+AKS_INTERNAL aks_trace_buf *aks_trace_attach(void) {
+  
+  aks_trace_buf *pb = NULL;
+  size_t slot = 0;
+  
+  if (aks_ring_load(&aks_trace_count) >= AKS_TRACE_THREADS) {
+    aks_trace_failed = 1;
+    return NULL;
+  }
+  
+  pb = (aks_trace_buf *) calloc(1, sizeof(aks_trace_buf));
+  if (pb == NULL) {
+    aks_trace_failed = 1;
+    return NULL;
+  }
+  
+  /* Claim a slot */
+  do {
+    slot = aks_ring_load(&aks_trace_count);
+    if (slot >= AKS_TRACE_THREADS) {
+      free(pb);
+      aks_trace_failed = 1;
+      return NULL;
+    }
+  } while (!aks_ring_cas(&aks_trace_count, slot, slot + 1));
+  
+  /* size_t is as wide as a pointer on the supported platforms */
+  aks_ring_store(&(aks_trace_slot[slot]), (size_t) pb);
+  aks_trace_self = pb;
+  
+  if (aks_ring_cas(&aks_trace_registered, 0, 1)) {
+    atexit(aks_trace_atexit);
+  }
+  
+  return pb;
+}
+
+/*
+ * Record an event in the buffer of the current thread.
+ * 
+ * This is normally called through the tracing macros.
+ * 
+ * Parameters:
+ * 
+ *   pName - the name of the event
+ * 
+ *   phase - 'B' for the beginning of a span, 'E' for the end, or 'i'
+ *   for an instant event
+ * 
+ *   pKey - the name of the argument, or NULL if there is none
+ * 
+ *   arg - the value of the argument
+ */
+AKS_API void aks_trace_emit(
+    const char     * pName,
+          int        phase,
+    const char     * pKey,
+          int64_t    arg) {
+  
+  aks_trace_buf *pb = aks_trace_self;
+  aks_trace_event *pe = NULL;
+  size_t h = 0;
+  
+  if (pb == NULL) {
+    if (aks_trace_failed) {
+      return;
+    }
+    pb = aks_trace_attach();
+    if (pb == NULL) {
+      return;
+    }
+  }
+  
+  h = pb->head;
+  pe = &(pb->ev[h & (AKS_TRACE_EVENTS - 1)]);
+  pe->ts = aks_trace_now();
+  pe->pName = pName;
+  pe->pKey = pKey;
+  pe->arg = arg;
+  pe->phase = phase;
+  
+  aks_ring_store(&(pb->head), h + 1);
+}
+
+/*
+ * Call removet() inside a traced span.
+ */
+AKS_API int aks_trace_removet(const char *f) {
+  
+  int result = 0;
+  
+  aks_trace_begin("removet");
+  result = removet(f);
+  aks_trace_end("removet");
+  
+  return result;
+}
+
+/*
+ * Call renamet() inside a traced span.
+ */
+AKS_API int aks_trace_renamet(const char *t, const char *v) {
+  
+  int result = 0;
+  
+  aks_trace_begin("renamet");
+  result = renamet(t, v);
+  aks_trace_end("renamet");
+  
+  return result;
+}
+
+/*
+ * Call tmpnamt() inside a traced span.
+ */
+AKS_API char *aks_trace_tmpnamt(char *s) {
+  
+  char *pResult = NULL;
+  
+  aks_trace_begin("tmpnamt");
+  pResult = tmpnamt(s);
+  aks_trace_end("tmpnamt");
+  
+  return pResult;
+}
+
+/*
+ * Call fopent() inside a traced span.
+ */
+AKS_API FILE *aks_trace_fopent(const char *f, const char *m) {
+  
+  FILE *pResult = NULL;
+  
+  aks_trace_begin("fopent");
+  pResult = fopent(f, m);
+  aks_trace_end("fopent");
+  
+  return pResult;
+}
+
+/*
+ * Call freopent() inside a traced span.
+ */
+AKS_API FILE *aks_trace_freopent(const char *f, const char *m, FILE *s) {
+  
+  FILE *pResult = NULL;
+  
+  aks_trace_begin("freopent");
+  pResult = freopent(f, m, s);
+  aks_trace_end("freopent");
+  
+  return pResult;
+}
+
+/*
+ * Call getenvt() inside a traced span.
+ */
+AKS_API char *aks_trace_getenvt(const char *n) {
+  
+  char *pResult = NULL;
+  
+  aks_trace_begin("getenvt");
+  pResult = getenvt(n);
+  aks_trace_end("getenvt");
+  
+  return pResult;
+}
+
+/*
+ * Call systemt() inside a traced span with its result as an argument.
+ */
+AKS_API int aks_trace_systemt(const char *s) {
+  
+  int result = 0;
+  
+  aks_trace_begin("systemt");
+  result = systemt(s);
+  aks_trace_end_arg("systemt", "status", result);
+  
+  return result;
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API int aks_trace_write(const char *pPath);
+AKS_API void aks_trace_emit(
+    const char     * pName,
+          int        phase,
+    const char     * pKey,
+          int64_t    arg);
+AKS_API int aks_trace_removet(const char *f);
+AKS_API int aks_trace_renamet(const char *t, const char *v);
+AKS_API char *aks_trace_tmpnamt(char *s);
+AKS_API FILE *aks_trace_fopent(const char *f, const char *m);
+AKS_API FILE *aks_trace_freopent(const char *f, const char *m, FILE *s);
+AKS_API char *aks_trace_getenvt(const char *n);
+AKS_API int aks_trace_systemt(const char *s);
+
+/* Route the translation functions through the traced versions */
+#undef removet
+#undef renamet
+#undef tmpnamt
+#undef fopent
+#undef freopent
+#undef getenvt
+#undef systemt
+
+#define removet(f) aks_trace_removet(f)
+#define renamet(t, v) aks_trace_renamet(t, v)
+#define tmpnamt(s) aks_trace_tmpnamt(s)
+#define fopent(f, m) aks_trace_fopent(f, m)
+#define freopent(f, m, s) aks_trace_freopent(f, m, s)
+
+#define getenvt(n) aks_trace_getenvt(n)
+#define systemt(s) aks_trace_systemt(s)
+
+#endif
+#endif
+
+/* * * * * * * * * * *
+ *                   *
+ * Readiness polling *
+ *                   *
+ * * * * * * * * * * */
+
+/* Only proceed if readiness polling requested and not already
+ * defined */
+#ifdef AKS_POLL
+#ifndef AKS_POLL_INCLUDED
+#define AKS_POLL_INCLUDED
+
+#include <stddef.h>
+#include <stdio.h>
+
+/*
+ * A descriptor reported ready by aks_poll(), along with the pointer it
+ * was registered with.
+ */
+typedef struct {
+  int fd;
+  void *pUser;
+} aks_poll_event;
+
+/*
+ * Size in bytes of the read-ahead buffer of each descriptor on Windows.
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_POLL_BUFSIZE
+#define AKS_POLL_BUFSIZE 65536
+#endif
+
+#ifdef AKS_POSIX
+/* POSIX implementation of readiness polling ======================== */
+
+#include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* On Linux, wait with epoll so that the cost of each wait does not
+ * grow with the number of descriptors */
+#ifdef __linux__
+#define AKS_POLL_EPOLL
+#include <sys/epoll.h>
+#endif
+
+/*
+ * A registered descriptor.  Descriptors that epoll refuses, such as
+ * regular files, never block on reading and are always ready.  id is
+ * unique to each registration in the set.
+ */
+typedef struct {
+  int fd;
+  int always;
+  uint32_t id;
+  void *pUser;
+} aks_poll_ent;
+
+/*
+ * The epoll data of an entry, which holds its registration id and its
+ * current index, so that events left over from an earlier registration
+ * can be told apart from those of the entry now at that index.
+ */
+#define aks_poll_tag(id, i) ((((uint64_t) (id)) << 32) | ((uint64_t) (i)))
+
+/*
+ * A set of descriptors to wait on.
+ */
+typedef struct {
+  aks_poll_ent *pEnt;
+  size_t count;
+  size_t cap;
+  size_t next;
+#ifdef AKS_POLL_EPOLL
+  int ep;
+  size_t nalways;
+  uint32_t nextid;
+  struct epoll_event *pEv;
+#else
+  struct pollfd *pPfd;
+#endif
+} aks_poller;
+
+#ifdef AKS_BODIES
+
+/*
+ * Double the capacity of the registration arrays of a set.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_poll_grow(aks_poller *pp) {
+  
+  aks_poll_ent *pe = NULL;
+  size_t cap = 0;
+#ifdef AKS_POLL_EPOLL
+  struct epoll_event *pv = NULL;
+#else
+  struct pollfd *pv = NULL;
+#endif
+  
+  cap = (pp->cap > 0) ? (pp->cap * 2) : 8;
+  
+  pe = (aks_poll_ent *) realloc(pp->pEnt, cap * sizeof(aks_poll_ent));
+  if (pe == NULL) {
+    return -1;
+  }
+  pp->pEnt = pe;
+  
+#ifdef AKS_POLL_EPOLL
+  pv = (struct epoll_event *) realloc(
+          pp->pEv, cap * sizeof(struct epoll_event));
+  if (pv == NULL) {
+    return -1;
+  }
+  pp->pEv = pv;
+#else
+  pv = (struct pollfd *) realloc(pp->pPfd, cap * sizeof(struct pollfd));
+  if (pv == NULL) {
+    return -1;
+  }
+  pp->pPfd = pv;
+#endif
+  
+  pp->cap = cap;
+  return 0;
+}
+
+/*
+ * Create an empty set of descriptors to wait on.
+ * 
+ * Return:
+ * 
+ *   the new set, or NULL if error
+ */
+AKS_API aks_poller *aks_poll_new(void) {
+  
+  aks_poller *pp = NULL;
+  
+  pp = (aks_poller *) calloc(1, sizeof(aks_poller));
+  if (pp == NULL) {
+    return NULL;
+  }
+  
+#ifdef AKS_POLL_EPOLL
+  pp->ep = epoll_create1(EPOLL_CLOEXEC);
+  if (pp->ep < 0) {
+    free(pp);
+    return NULL;
+  }
+#endif
+  
+  return pp;
+}
+
+/*
+ * Register a descriptor to be waited on for reading.
+ * 
+ * Each descriptor may be registered at most once in a set.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   fd - the descriptor
+ * 
+ *   pUser - a pointer reported along with the descriptor
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_poll_add(aks_poller *pp, int fd, void *pUser) {
+  
+  aks_poll_ent *pe = NULL;
+#ifdef AKS_POLL_EPOLL
+  struct epoll_event ev;
+#endif
+  
+  if (fd < 0) {
+    errno = EBADF;
+    return -1;
+  }
+  if (pp->count >= pp->cap) {
+    if (aks_poll_grow(pp) != 0) {
+      return -1;
+    }
+  }
+  
+  pe = &(pp->pEnt[pp->count]);
+  pe->fd = fd;
+  pe->always = 0;
+  pe->id = 0;
+  pe->pUser = pUser;
+  
+#ifdef AKS_POLL_EPOLL
+  /* The event carries the index of the entry, which aks_poll_del()
+   * keeps up to date when it moves entries, tagged with a new
+   * registration id */
+  pe->id = pp->nextid++;
+  memset(&ev, 0, sizeof(ev));
+  ev.events = EPOLLIN;
+  ev.data.u64 = aks_poll_tag(pe->id, pp->count);
+  if (epoll_ctl(pp->ep, EPOLL_CTL_ADD, fd, &ev) != 0) {
+    if (errno != EPERM) {
+      return -1;
+    }
+    pe->always = 1;
+    pp->nalways++;
+  }
+#else
+  pp->pPfd[pp->count].fd = fd;
+  pp->pPfd[pp->count].events = POLLIN;
+  pp->pPfd[pp->count].revents = 0;
+#endif
+  
+  pp->count++;
+  return 0;
+}
+
+/*
+ * Remove a descriptor from a set.
+ * 
+ * The descriptor itself is not closed.  It must be removed before it
+ * is closed, since epoll keeps watching a closed descriptor while
+ * another descriptor still refers to the same open file.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   fd - the descriptor
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if the descriptor is not registered
+ */
+AKS_API int aks_poll_del(aks_poller *pp, int fd) {
+  
+  size_t i = 0;
+  size_t last = 0;
+#ifdef AKS_POLL_EPOLL
+  struct epoll_event ev;
+#endif
+  
+  for(i = 0; i < pp->count; i++) {
+    if (pp->pEnt[i].fd == fd) {
+      break;
+    }
+  }
+  if (i >= pp->count) {
+    errno = ENOENT;
+    return -1;
+  }
+  
+#ifdef AKS_POLL_EPOLL
+  /* If the descriptor was closed anyway, this fails and any events that
+   * are still delivered for it are ignored by aks_poll() */
+  memset(&ev, 0, sizeof(ev));
+  if (pp->pEnt[i].always) {
+    pp->nalways--;
+  } else {
+    epoll_ctl(pp->ep, EPOLL_CTL_DEL, fd, &ev);
+  }
+#endif
+  
+  /* Move the last entry into the gap */
+  last = pp->count - 1;
+  if (i != last) {
+    pp->pEnt[i] = pp->pEnt[last];
+#ifdef AKS_POLL_EPOLL
+    if (!(pp->pEnt[i].always)) {
+      ev.events = EPOLLIN;
+      ev.data.u64 = aks_poll_tag(pp->pEnt[i].id, i);
+      epoll_ctl(pp->ep, EPOLL_CTL_MOD, pp->pEnt[i].fd, &ev);
+    }
+#else
+    pp->pPfd[i] = pp->pPfd[last];
+#endif
+  }
+  pp->count--;
+  
+  return 0;
+}
+
+/*
+ * Wait until at least one descriptor in a set can be read without
+ * blocking.
+ * 
+ * Readiness is level-triggered: a descriptor is reported on every call
+ * until its data is read, and at end of file it is reported on every
+ * call until it is removed.  When more descriptors are ready than fit,
+ * successive calls take turns among them.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   pEv - receives the ready descriptors
+ * 
+ *   max - the number of entries pEv can hold
+ * 
+ *   timeout - the longest time to wait in milliseconds, zero to only
+ *   check, or -1 to wait with no limit
+ * 
+ * Return:
+ * 
+ *   the number of ready descriptors, zero if the time ran out, the
+ *   wait was interrupted, or the set is empty, or -1 if error
+ */
+AKS_API int aks_poll(
+    aks_poller       * pp,
+    aks_poll_event   * pEv,
+    int                max,
+    int                timeout) {
+  
+  size_t i = 0;
+  size_t k = 0;
+  int got = 0;
+  int r = 0;
+#ifdef AKS_POLL_EPOLL
+  uint64_t tag = 0;
+  int j = 0;
+#endif
+  
+  if ((pEv == NULL) || (max < 1)) {
+    errno = EINVAL;
+    return -1;
+  }
+  if (pp->count < 1) {
+    return 0;
+  }
+  
+#ifdef AKS_POLL_EPOLL
+  /* Wait on the epoll set, but only check it if some descriptors are
+   * always ready */
+  if (pp->count > pp->nalways) {
+    k = pp->cap;
+    if (k > (size_t) INT_MAX) {
+      k = (size_t) INT_MAX;
+    }
+    r = epoll_wait(
+          pp->ep, pp->pEv, (int) k, (pp->nalways > 0) ? 0 : timeout);
+    if (r < 0) {
+      if (errno != EINTR) {
+        return -1;
+      }
+      r = 0;
+    }
+    /* Skip events whose tag no longer matches the entry at its index,
+     * which come from descriptors that were closed before removal.  The
+     * wait takes in more events than fit so that these cannot crowd out
+     * the rest, and the scan starts at a different event on each call
+     * so that ready descriptors take turns. */
+    for(j = 0; (j < r) && (got < max); j++) {
+      tag = pp->pEv[(pp->next + (size_t) j) % (size_t) r].data.u64;
+      k = (size_t) (tag & UINT64_C(0xffffffff));
+      if (k >= pp->count) {
+        continue;
+      }
+      if ((pp->pEnt[k].always) ||
+          (tag != aks_poll_tag(pp->pEnt[k].id, k))) {
+        continue;
+      }
+      pEv[got].fd = pp->pEnt[k].fd;
+      pEv[got].pUser = pp->pEnt[k].pUser;
+      got++;
+    }
+  }
+  
+  /* Fill the remaining room with the descriptors that are always
+   * ready */
+  for(i = 0; (i < pp->count) && (got < max) && (pp->nalways > 0); i++) {
+    k = (pp->next + i) % pp->count;
+    if (pp->pEnt[k].always) {
+      pEv[got].fd = pp->pEnt[k].fd;
+      pEv[got].pUser = pp->pEnt[k].pUser;
+      got++;
+    }
+  }
+  
+#else
+  r = poll(pp->pPfd, (nfds_t) pp->count, timeout);
+  if (r < 0) {
+    if (errno != EINTR) {
+      return -1;
+    }
+    r = 0;
+  }
+  for(i = 0; (i < pp->count) && (got < max) && (got < r); i++) {
+    k = (pp->next + i) % pp->count;
+    if (pp->pPfd[k].revents != 0) {
+      pEv[got].fd = pp->pEnt[k].fd;
+      pEv[got].pUser = pp->pEnt[k].pUser;
+      got++;
+    }
+  }
+#endif
+  
+  pp->next = (pp->next + 1) % pp->count;
+  return got;
+}
+
+/*
+ * Read whatever a ready descriptor has available.
+ * 
+ * On POSIX this is a single read() that is retried if interrupted.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set the descriptor is registered in
+ * 
+ *   fd - a descriptor that aks_poll() reported ready
+ * 
+ *   pBuf - the buffer to read into
+ * 
+ *   n - the size of the buffer
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_API long aks_poll_read(aks_poller *pp, int fd, void *pBuf, size_t n) {
+  
+  ssize_t r = 0;
+  
+  (void) pp;
+  
+  if (n > (size_t) LONG_MAX) {
+    n = (size_t) LONG_MAX;
+  }
+  
+  do {
+    r = read(fd, pBuf, n);
+  } while ((r < 0) && (errno == EINTR));
+  
+  return (long) r;
+}
+
+/*
+ * Release a set.  The registered descriptors are not closed.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set, or NULL
+ */
+AKS_API void aks_poll_free(aks_poller *pp) {
+  
+  if (pp == NULL) {
+    return;
+  }
+  
+#ifdef AKS_POLL_EPOLL
+  close(pp->ep);
+  free(pp->pEv);
+#else
+  free(pp->pPfd);
+#endif
+  free(pp->pEnt);
+  free(pp);
+}
+
+#endif
+
+#else
+/* Windows implementation of readiness polling ====================== */
+
+#include <errno.h>
+#include <io.h>
+#include <stdlib.h>
+#include <string.h>
+#include <windows.h>
+
+/*
+ * A registered descriptor.
+ * 
+ * Anonymous pipes and consoles cannot be waited on for data, so each
+ * descriptor has a thread that reads ahead into the buffer with
+ * blocking reads and posts a completion packet to the I/O completion
+ * port of the set when the buffer is filled.  Once the buffer has been
+ * drained, the hGo event lets the thread read again.
+ */
+typedef struct {
+  int fd;
+  void *pUser;
+  HANDLE h;
+  HANDLE hThread;
+  HANDLE hGo;
+  HANDLE hPort;
+  ULONG_PTR id;
+  volatile LONG stop;
+  int ready;
+  int state;
+  DWORD len;
+  DWORD pos;
+  char buf[AKS_POLL_BUFSIZE];
+} aks_poll_ent;
+
+/*
+ * A set of descriptors to wait on.
+ */
+typedef struct {
+  aks_poll_ent **ppEnt;
+  size_t count;
+  size_t cap;
+  size_t next;
+  HANDLE hPort;
+  ULONG_PTR lastid;
+} aks_poller;
+
+#ifdef AKS_BODIES
+
+/*
+ * Read ahead on one descriptor.
+ * 
+ * The state is 1 when the buffer holds data, 0 at end of file, or -1
+ * after an error; the thread finishes after the end of file or an
+ * error, or when asked to stop.
+ * 
+ * Parameters:
+ * 
+ *   pArg - the aks_poll_ent to read for
+ * 
+ * Return:
+ * 
+ *   zero
+ */
+AKS_INTERNAL DWORD WINAPI aks_poll_run(LPVOID pArg) {
+  
+  aks_poll_ent *pe = (aks_poll_ent *) pArg;
+  DWORD got = 0;
+  DWORD err = 0;
+  BOOL ok = FALSE;
+  
+  for(;;) {
+    WaitForSingleObject(pe->hGo, INFINITE);
+    if (pe->stop) {
+      break;
+    }
+    
+    got = 0;
+    ok = ReadFile(pe->h, pe->buf, AKS_POLL_BUFSIZE, &got, NULL);
+    err = ok ? 0 : GetLastError();
+    if (pe->stop) {
+      break;
+    }
+    
+    /* A closed pipe reads as an error, but means end of file */
+    if (ok && (got > 0)) {
+      pe->state = 1;
+    } else if (ok || (err == ERROR_BROKEN_PIPE) ||
+                (err == ERROR_HANDLE_EOF)) {
+      pe->state = 0;
+    } else {
+      pe->state = -1;
+    }
+    pe->len = got;
+    pe->pos = 0;
+    
+    PostQueuedCompletionStatus(pe->hPort, 0, pe->id, NULL);
+    if (pe->state != 1) {
+      break;
+    }
+  }
+  
+  return 0;
+}
+
+/*
+ * Stop the thread of a registered descriptor and release the entry.
+ * 
+ * The thread is either waiting to be let go, or blocked in a read,
+ * which is cancelled; cancelling is repeated in case the thread had
+ * not yet started the read.  A completion packet the thread already
+ * posted is ignored by aks_poll(), since no entry has its id any more.
+ * 
+ * Parameters:
+ * 
+ *   pe - the entry
+ */
+AKS_INTERNAL void aks_poll_stop(aks_poll_ent *pe) {
+  
+  InterlockedExchange(&(pe->stop), 1);
+  SetEvent(pe->hGo);
+  do {
+    CancelSynchronousIo(pe->hThread);
+  } while (WaitForSingleObject(pe->hThread, 10) == WAIT_TIMEOUT);
+  
+  CloseHandle(pe->hThread);
+  CloseHandle(pe->hGo);
+  free(pe);
+}
+
+/*
+ * Find the registered entry of a descriptor.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   fd - the descriptor
+ * 
+ * Return:
+ * 
+ *   the index of the entry, or the count of the set if not found
+ */
+AKS_INTERNAL size_t aks_poll_find(aks_poller *pp, int fd) {
+  
+  size_t i = 0;
+  
+  for(i = 0; i < pp->count; i++) {
+    if (pp->ppEnt[i]->fd == fd) {
+      break;
+    }
+  }
+  
+  return i;
+}
+
+/*
+ * Create an empty set of descriptors to wait on.
+ * 
+ * Return:
+ * 
+ *   the new set, or NULL if error
+ */
+AKS_API aks_poller *aks_poll_new(void) {
+  
+  aks_poller *pp = NULL;
+  
+  pp = (aks_poller *) calloc(1, sizeof(aks_poller));
+  if (pp == NULL) {
+    return NULL;
+  }
+  
+  pp->hPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+  if (pp->hPort == NULL) {
+    free(pp);
+    return NULL;
+  }
+  
+  return pp;
+}
+
+/*
+ * Register a descriptor to be waited on for reading.
+ * 
+ * Each descriptor may be registered at most once in a set.  Its thread
+ * starts reading ahead straight away.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   fd - the descriptor
+ * 
+ *   pUser - a pointer reported along with the descriptor
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_poll_add(aks_poller *pp, int fd, void *pUser) {
+  
+  aks_poll_ent **ppe = NULL;
+  aks_poll_ent *pe = NULL;
+  HANDLE h = INVALID_HANDLE_VALUE;
+  size_t cap = 0;
+  
+  h = (HANDLE) _get_osfhandle(fd);
+  if (h == INVALID_HANDLE_VALUE) {
+    errno = EBADF;
+    return -1;
+  }
+  
+  if (pp->count >= pp->cap) {
+    cap = (pp->cap > 0) ? (pp->cap * 2) : 8;
+    ppe = (aks_poll_ent **) realloc(
+            pp->ppEnt, cap * sizeof(aks_poll_ent *));
+    if (ppe == NULL) {
+      return -1;
+    }
+    pp->ppEnt = ppe;
+    pp->cap = cap;
+  }
+  
+  pe = (aks_poll_ent *) calloc(1, sizeof(aks_poll_ent));
+  if (pe == NULL) {
+    return -1;
+  }
+  pe->fd = fd;
+  pe->pUser = pUser;
+  pe->h = h;
+  pe->hPort = pp->hPort;
+  pe->id = ++(pp->lastid);
+  
+  /* The event starts signalled so that the thread reads at once */
+  pe->hGo = CreateEvent(NULL, FALSE, TRUE, NULL);
+  if (pe->hGo == NULL) {
+    free(pe);
+    return -1;
+  }
+  
+  pe->hThread = CreateThread(
+                  NULL,
+                  65536,
+                  &aks_poll_run,
+                  pe,
+                  STACK_SIZE_PARAM_IS_A_RESERVATION,
+                  NULL);
+  if (pe->hThread == NULL) {
+    CloseHandle(pe->hGo);
+    free(pe);
+    return -1;
+  }
+  
+  pp->ppEnt[pp->count] = pe;
+  pp->count++;
+  return 0;
+}
+
+/*
+ * Remove a descriptor from a set.
+ * 
+ * The descriptor itself is not closed, but any data that was read
+ * ahead and not yet returned by aks_poll_read() is lost.  It must be
+ * removed before it is closed.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   fd - the descriptor
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if the descriptor is not registered
+ */
+AKS_API int aks_poll_del(aks_poller *pp, int fd) {
+  
+  size_t i = 0;
+  
+  i = aks_poll_find(pp, fd);
+  if (i >= pp->count) {
+    errno = ENOENT;
+    return -1;
+  }
+  
+  aks_poll_stop(pp->ppEnt[i]);
+  pp->ppEnt[i] = pp->ppEnt[pp->count - 1];
+  pp->count--;
+  
+  return 0;
+}
+
+/*
+ * Wait until at least one descriptor in a set can be read without
+ * blocking.
+ * 
+ * Readiness is level-triggered: a descriptor is reported on every call
+ * until its read-ahead buffer is drained, and at end of file it is
+ * reported on every call until it is removed.  When more descriptors
+ * are ready than fit, successive calls take turns among them.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set
+ * 
+ *   pEv - receives the ready descriptors
+ * 
+ *   max - the number of entries pEv can hold
+ * 
+ *   timeout - the longest time to wait in milliseconds, zero to only
+ *   check, or -1 to wait with no limit
+ * 
+ * Return:
+ * 
+ *   the number of ready descriptors, zero if the time ran out or the
+ *   set is empty, or -1 if error
+ */
+AKS_API int aks_poll(
+    aks_poller       * pp,
+    aks_poll_event   * pEv,
+    int                max,
+    int                timeout) {
+  
+  LPOVERLAPPED pov = NULL;
+  ULONG_PTR key = 0;
+  DWORD n = 0;
+  DWORD wait = 0;
+  size_t i = 0;
+  size_t k = 0;
+  int got = 0;
+  
+  if ((pEv == NULL) || (max < 1)) {
+    errno = EINVAL;
+    return -1;
+  }
+  if (pp->count < 1) {
+    return 0;
+  }
+  
+  /* Only wait if nothing is ready already */
+  wait = (timeout < 0) ? INFINITE : (DWORD) timeout;
+  for(i = 0; i < pp->count; i++) {
+    if (pp->ppEnt[i]->ready) {
+      wait = 0;
+      break;
+    }
+  }
+  
+  /* Collect the completion packets, waiting only for the first */
+  while (GetQueuedCompletionStatus(pp->hPort, &n, &key, &pov, wait)) {
+    for(i = 0; i < pp->count; i++) {
+      if (pp->ppEnt[i]->id == key) {
+        pp->ppEnt[i]->ready = 1;
+        break;
+      }
+    }
+    wait = 0;
+  }
+  
+  for(i = 0; (i < pp->count) && (got < max); i++) {
+    k = (pp->next + i) % pp->count;
+    if (pp->ppEnt[k]->ready) {
+      pEv[got].fd = pp->ppEnt[k]->fd;
+      pEv[got].pUser = pp->ppEnt[k]->pUser;
+      got++;
+    }
+  }
+  
+  pp->next = (pp->next + 1) % pp->count;
+  return got;
+}
+
+/*
+ * Read whatever a ready descriptor has available.
+ * 
+ * On Windows this copies out of the read-ahead buffer, and lets the
+ * thread of the descriptor read again once the buffer is drained.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set the descriptor is registered in
+ * 
+ *   fd - a descriptor that aks_poll() reported ready
+ * 
+ *   pBuf - the buffer to read into
+ * 
+ *   n - the size of the buffer
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_API long aks_poll_read(aks_poller *pp, int fd, void *pBuf, size_t n) {
+  
+  aks_poll_ent *pe = NULL;
+  size_t i = 0;
+  size_t k = 0;
+  
+  i = aks_poll_find(pp, fd);
+  if (i >= pp->count) {
+    errno = EBADF;
+    return -1;
+  }
+  pe = pp->ppEnt[i];
+  
+  /* Reading before the descriptor was reported would have to block */
+  if (!(pe->ready)) {
+    errno = EAGAIN;
+    return -1;
+  }
+  if (pe->state == 0) {
+    return 0;
+  }
+  if (pe->state < 0) {
+    errno = EIO;
+    return -1;
+  }
+  
+  k = (size_t) (pe->len - pe->pos);
+  if (k > n) {
+    k = n;
+  }
+  memcpy(pBuf, pe->buf + pe->pos, k);
+  pe->pos += (DWORD) k;
+  
+  if (pe->pos >= pe->len) {
+    pe->ready = 0;
+    SetEvent(pe->hGo);
+  }
+  
+  return (long) k;
+}
+
+/*
+ * Release a set, stopping the threads of the registered descriptors.
+ * The descriptors are not closed.
+ * 
+ * Parameters:
+ * 
+ *   pp - the set, or NULL
+ */
+AKS_API void aks_poll_free(aks_poller *pp) {
+  
+  size_t i = 0;
+  
+  if (pp == NULL) {
+    return;
+  }
+  
+  for(i = 0; i < pp->count; i++) {
+    aks_poll_stop(pp->ppEnt[i]);
+  }
+  CloseHandle(pp->hPort);
+  free(pp->ppEnt);
+  free(pp);
+}
+
+#endif
+
+#endif
+
+/*
+ * Register a stream to be waited on for reading.
+ * 
+ * Data already in the buffer of the stream cannot be seen by the
+ * wait, so the stream should only be read through aks_poll_read()
+ * while it is registered.
+ */
+#ifdef AKS_POSIX
+#define aks_poll_addf(pp, fp, pUser) aks_poll_add((pp), fileno(fp), (pUser))
+#else
+#define aks_poll_addf(pp, fp, pUser) \
+  aks_poll_add((pp), _fileno(fp), (pUser))
+#endif
+
+/* Public function declarations */
+AKS_API aks_poller *aks_poll_new(void);
+AKS_API int aks_poll_add(aks_poller *pp, int fd, void *pUser);
+AKS_API int aks_poll_del(aks_poller *pp, int fd);
+AKS_API int aks_poll(
+    aks_poller       * pp,
+    aks_poll_event   * pEv,
+    int                max,
+    int                timeout);
+AKS_API long aks_poll_read(aks_poller *pp, int fd, void *pBuf, size_t n);
+AKS_API void aks_poll_free(aks_poller *pp);
+
+#endif
+#endif
+
+/* * * * * * * * * * * * *
+ *                       *
+ * Unlocked standard I/O *
+ *                       *
+ * * * * * * * * * * * * */
+
+/* Only proceed if unlocked standard I/O requested and not already
+ * defined */
+#ifdef AKS_STDIO_UNLOCKED
+#ifndef AKS_STDIO_UNLOCKED_INCLUDED
+#define AKS_STDIO_UNLOCKED_INCLUDED
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/*
+ * Default size in bytes of the buffer installed by aks_stdio_buffer().
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_STDIO_BUFSIZE
+#define AKS_STDIO_BUFSIZE 1048576
+#endif
+
+#ifdef AKS_POSIX
+/* POSIX implementation of unlocked standard I/O ==================== */
+
+#include <unistd.h>
+
+/* The unlocked character functions and explicit stream locking come
+ * with the thread-safe functions option, and are declared from the
+ * POSIX.1c revision on */
+#ifdef _POSIX_THREAD_SAFE_FUNCTIONS
+#if _POSIX_THREAD_SAFE_FUNCTIONS > 0
+#if AKS_POSIX_DECL >= 199506L
+#define AKS_STDIO_POSIX_UNLOCKED
+#endif
+#endif
+#endif
+
+/* glibc also has unlocked block functions, which it declares along
+ * with its other extensions, and an unlocked fputs() that it only
+ * declares for _GNU_SOURCE */
+#ifdef __GLIBC__
+#ifdef AKS_POSIX_DECL_MISC
+#define AKS_STDIO_GLIBC_UNLOCKED
+#endif
+#ifdef _GNU_SOURCE
+#define AKS_STDIO_GLIBC_FPUTS
+#endif
+#endif
+
+#ifdef AKS_STDIO_POSIX_UNLOCKED
+#define aks_getc_u(fp) getc_unlocked(fp)
+#define aks_putc_u(c, fp) putc_unlocked((c), (fp))
+#define aks_getchar_u() getchar_unlocked()
+#define aks_putchar_u(c) putchar_unlocked(c)
+#define aks_lock_stream(fp) flockfile(fp)
+#define aks_unlock_stream(fp) funlockfile(fp)
+
+#else
+#define aks_getc_u(fp) getc(fp)
+#define aks_putc_u(c, fp) putc((c), (fp))
+#define aks_getchar_u() getchar()
+#define aks_putchar_u(c) putchar(c)
+#define aks_lock_stream(fp) ((void) (fp))
+#define aks_unlock_stream(fp) ((void) (fp))
+#endif
+
+#ifdef AKS_STDIO_GLIBC_UNLOCKED
+#define aks_fread_u(p, sz, n, fp) fread_unlocked((p), (sz), (n), (fp))
+#define aks_fwrite_u(p, sz, n, fp) fwrite_unlocked((p), (sz), (n), (fp))
+#define aks_fflush_u(fp) fflush_unlocked(fp)
+
+#else
+#define aks_fread_u(p, sz, n, fp) fread((p), (sz), (n), (fp))
+#define aks_fwrite_u(p, sz, n, fp) fwrite((p), (sz), (n), (fp))
+#define aks_fflush_u(fp) fflush(fp)
+#endif
+
+#ifdef AKS_STDIO_GLIBC_FPUTS
+#define aks_fputs_u(s, fp) fputs_unlocked((s), (fp))
+#else
+#define aks_fputs_u(s, fp) fputs((s), (fp))
+#endif
+
+#else
+/* Windows implementation of unlocked standard I/O ================== */
+
+/* The CRT has no unlocked fputs(), so the locked one is used */
+#define aks_getc_u(fp) _getc_nolock(fp)
+#define aks_putc_u(c, fp) _putc_nolock((c), (fp))
+#define aks_getchar_u() _getchar_nolock()
+#define aks_putchar_u(c) _putchar_nolock(c)
+#define aks_lock_stream(fp) _lock_file(fp)
+#define aks_unlock_stream(fp) _unlock_file(fp)
+
+#define aks_fread_u(p, sz, n, fp) _fread_nolock((p), (sz), (n), (fp))
+#define aks_fwrite_u(p, sz, n, fp) _fwrite_nolock((p), (sz), (n), (fp))
+#define aks_fputs_u(s, fp) fputs((s), (fp))
+#define aks_fflush_u(fp) _fflush_nolock(fp)
+
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Give a stream a large buffer and make it fully buffered.
+ * 
+ * This must be called before anything is read from or written to the
+ * stream.  The buffer must outlive the stream, so it is returned for
+ * the caller to release with free() after the stream is closed; for a
+ * standard stream that stays open until the program exits, it may
+ * simply never be released.
+ * 
+ * Parameters:
+ * 
+ *   fp - the stream
+ * 
+ *   size - the size of the buffer in bytes, or zero for
+ *   AKS_STDIO_BUFSIZE
+ * 
+ * Return:
+ * 
+ *   the buffer, or NULL if error, in which case the stream is unchanged
+ */
+AKS_API char *aks_stdio_buffer(FILE *fp, size_t size) {
+  
+  char *pBuf = NULL;
+  
+  if (size < 1) {
+    size = AKS_STDIO_BUFSIZE;
+  }
+  
+  /* The Windows CRT takes sizes up to INT_MAX */
+  if (size > (size_t) INT_MAX) {
+    size = (size_t) INT_MAX;
+  }
+  
+  pBuf = (char *) malloc(size);
+  if (pBuf == NULL) {
+    return NULL;
+  }
+  
+  if (setvbuf(fp, pBuf, _IOFBF, size) != 0) {
+    free(pBuf);
+    return NULL;
+  }
+  
+  return pBuf;
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API char *aks_stdio_buffer(FILE *fp, size_t size);
+
+#endif
+#endif
+
+/* * * * * * * *
+ *             *
+ * Direct I/O  *
+ *             *
+ * * * * * * * */
+
+/* Only proceed if direct I/O requested and not already defined */
+#ifdef AKS_DIRECT
+#ifndef AKS_DIRECT_INCLUDED
+#define AKS_DIRECT_INCLUDED
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Alignment in bytes of the buffer, file offsets and read sizes of
+ * direct reads, which covers the sector sizes of current devices.
+ * 
+ * Size in bytes of the aligned buffer of each reader, which must be a
+ * multiple of the alignment.
+ * 
+ * Both may be overridden by defining them before including the header.
+ */
+#ifndef AKS_DIRECT_ALIGN
+#define AKS_DIRECT_ALIGN 4096
+#endif
+
+#ifndef AKS_DIRECT_BUFSIZE
+#define AKS_DIRECT_BUFSIZE 1048576
+#endif
+
+#if ((AKS_DIRECT_BUFSIZE % AKS_DIRECT_ALIGN) != 0)
+#error aksmacro: AKS_DIRECT_BUFSIZE must be a multiple of AKS_DIRECT_ALIGN.
+#endif
+
+/*
+ * Flag for aks_open_direct() to fail rather than fall back to cached
+ * reads where the file cannot be opened for direct I/O.
+ */
+#define AKS_DIRECT_STRICT 1
+
+#ifdef AKS_POSIX
+/* POSIX implementation of direct I/O =============================== */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* Where direct reads are not available, cached reads can at least drop
+ * the pages behind them with posix_fadvise(), which is declared along
+ * with its advice values */
+#ifdef POSIX_FADV_DONTNEED
+#define AKS_DIRECT_DROPBEHIND
+#endif
+
+/* posix_memalign() is only declared from POSIX.1-2001; otherwise the
+ * buffer is over-allocated and aligned by hand */
+#if AKS_POSIX_DECL >= 200112L
+#define AKS_DIRECT_MEMALIGN
+#endif
+
+/* Keep the descriptor out of spawned children where possible */
+#ifdef O_CLOEXEC
+#define AKS_DIRECT_OFLAGS (O_RDONLY | O_CLOEXEC)
+#else
+#define AKS_DIRECT_OFLAGS O_RDONLY
+#endif
+
+/*
+ * A file opened for direct reading.
+ * 
+ * direct is non-zero while reads bypass the page cache.  pBuf holds
+ * len bytes, of which the first pos have been consumed.  pAlloc is the
+ * allocation that pBuf is aligned within.
+ */
+typedef struct {
+  int fd;
+  int direct;
+  int eof;
+  void *pAlloc;
+  char *pBuf;
+  size_t len;
+  size_t pos;
+  off_t off;
+} aks_direct;
+
+#ifdef AKS_BODIES
+
+/*
+ * Switch a reader to cached reads, for when the file offset is no
+ * longer aligned.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader
+ */
+AKS_INTERNAL void aks_direct_uncache(aks_direct *pd) {
+  
+  int fl = 0;
+  
+#ifdef O_DIRECT
+  fl = fcntl(pd->fd, F_GETFL);
+  if (fl != -1) {
+    fcntl(pd->fd, F_SETFL, fl & ~O_DIRECT);
+  }
+#else
+#ifdef F_NOCACHE
+  fcntl(pd->fd, F_NOCACHE, 0);
+#endif
+  (void) fl;
+#endif
+  
+  pd->direct = 0;
+}
+
+/*
+ * Refill the buffer of a reader with the next aligned block of the
+ * file.
+ * 
+ * The last block of a file is usually shorter than the buffer.  Once a
+ * read leaves the file offset unaligned, the reader switches to cached
+ * reads so that a file that is still growing can be read further.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader
+ * 
+ * Return:
+ * 
+ *   zero if successful, including at end of file, or -1 if error
+ */
+AKS_INTERNAL int aks_direct_fill(aks_direct *pd) {
+  
+  ssize_t r = 0;
+  
+  pd->len = 0;
+  pd->pos = 0;
+  
+  for(;;) {
+    r = read(pd->fd, pd->pBuf, AKS_DIRECT_BUFSIZE);
+    if (r >= 0) {
+      break;
+    }
+    if ((errno == EINVAL) && pd->direct) {
+      aks_direct_uncache(pd);
+    } else if (errno != EINTR) {
+      return -1;
+    }
+  }
+  
+  if (r == 0) {
+    pd->eof = 1;
+    return 0;
+  }
+  
+  if (pd->direct && ((r % AKS_DIRECT_ALIGN) != 0)) {
+    aks_direct_uncache(pd);
+  }
+  
+#ifdef AKS_DIRECT_DROPBEHIND
+  if (!(pd->direct)) {
+    posix_fadvise(pd->fd, pd->off, (off_t) r, POSIX_FADV_DONTNEED);
+  }
+#endif
+  
+  pd->off += (off_t) r;
+  pd->len = (size_t) r;
+  return 0;
+}
+
+/*
+ * Open a file for one-pass reading that bypasses the page cache.
+ * 
+ * Linux uses O_DIRECT, which glibc only defines with _GNU_SOURCE;
+ * macOS uses F_NOCACHE.  Elsewhere, or where the file system refuses
+ * direct I/O, the file is read through the cache, dropping each block
+ * from the cache after it is read, unless AKS_DIRECT_STRICT is given.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the file
+ * 
+ *   flags - zero or AKS_DIRECT_STRICT
+ * 
+ * Return:
+ * 
+ *   the reader, or NULL if error
+ */
+AKS_API aks_direct *aks_open_direct(const char *pPath, int flags) {
+  
+  aks_direct *pd = NULL;
+  void *pBuf = NULL;
+  int err = 0;
+  
+  pd = (aks_direct *) calloc(1, sizeof(aks_direct));
+  if (pd == NULL) {
+    return NULL;
+  }
+  
+#ifdef AKS_DIRECT_MEMALIGN
+  err = posix_memalign(&pBuf, AKS_DIRECT_ALIGN, AKS_DIRECT_BUFSIZE);
+  if (err != 0) {
+    free(pd);
+    errno = err;
+    return NULL;
+  }
+  pd->pAlloc = pBuf;
+  pd->pBuf = (char *) pBuf;
+#else
+  pBuf = malloc(AKS_DIRECT_BUFSIZE + AKS_DIRECT_ALIGN - 1);
+  if (pBuf == NULL) {
+    free(pd);
+    return NULL;
+  }
+  pd->pAlloc = pBuf;
+  pd->pBuf = (char *) pBuf;
+  if ((((uintptr_t) pBuf) % AKS_DIRECT_ALIGN) != 0) {
+    pd->pBuf += AKS_DIRECT_ALIGN - (((uintptr_t) pBuf) % AKS_DIRECT_ALIGN);
+  }
+#endif
+  
+#ifdef O_DIRECT
+  pd->fd = open(pPath, AKS_DIRECT_OFLAGS | O_DIRECT);
+  if (pd->fd >= 0) {
+    pd->direct = 1;
+  } else if ((errno == EINVAL) && (!(flags & AKS_DIRECT_STRICT))) {
+    pd->fd = open(pPath, AKS_DIRECT_OFLAGS);
+  }
+#else
+  pd->fd = open(pPath, AKS_DIRECT_OFLAGS);
+#ifdef F_NOCACHE
+  if (pd->fd >= 0) {
+    if (fcntl(pd->fd, F_NOCACHE, 1) != -1) {
+      pd->direct = 1;
+    }
+  }
+#endif
+#endif
+  
+  if ((pd->fd >= 0) && (!(pd->direct)) && (flags & AKS_DIRECT_STRICT)) {
+    close(pd->fd);
+    pd->fd = -1;
+    errno = EINVAL;
+  }
+  if (pd->fd < 0) {
+    err = errno;
+    free(pd->pAlloc);
+    free(pd);
+    errno = err;
+    return NULL;
+  }
+  
+#ifdef AKS_DIRECT_DROPBEHIND
+  if (!(pd->direct)) {
+    posix_fadvise(pd->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  }
+#endif
+  
+  return pd;
+}
+
+/*
+ * Close a reader.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader, or NULL
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_direct_close(aks_direct *pd) {
+  
+  int result = 0;
+  
+  if (pd == NULL) {
+    return 0;
+  }
+  
+  result = close(pd->fd);
+  free(pd->pAlloc);
+  free(pd);
+  
+  return (result == 0) ? 0 : -1;
+}
+
+#endif
+
+#else
+/* Windows implementation of direct I/O ============================= */
+
+#include <windows.h>
+
+/*
+ * A file opened for direct reading.
+ * 
+ * direct is non-zero while reads bypass the file cache.  pBuf holds
+ * len bytes, of which the first pos have been consumed.
+ */
+typedef struct {
+  HANDLE h;
+  int direct;
+  int eof;
+  char *pBuf;
+  size_t len;
+  size_t pos;
+  LARGE_INTEGER off;
+} aks_direct;
+
+#ifdef AKS_BODIES
+
+/*
+ * Switch a reader to cached reads, for when the file offset is no
+ * longer aligned.
+ * 
+ * A handle cannot drop FILE_FLAG_NO_BUFFERING, so the file is opened
+ * again without it and positioned at the current offset.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_direct_uncache(aks_direct *pd) {
+  
+  HANDLE h = INVALID_HANDLE_VALUE;
+  
+  h = ReOpenFile(
+        pd->h,
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        FILE_FLAG_SEQUENTIAL_SCAN);
+  if (h == INVALID_HANDLE_VALUE) {
+    return -1;
+  }
+  if (!SetFilePointerEx(h, pd->off, NULL, FILE_BEGIN)) {
+    CloseHandle(h);
+    return -1;
+  }
+  
+  CloseHandle(pd->h);
+  pd->h = h;
+  pd->direct = 0;
+  return 0;
+}
+
+/*
+ * Refill the buffer of a reader with the next aligned block of the
+ * file.
+ * 
+ * The last block of a file is usually shorter than the buffer.  Once a
+ * read leaves the file offset unaligned, the reader switches to cached
+ * reads so that a file that is still growing can be read further.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader
+ * 
+ * Return:
+ * 
+ *   zero if successful, including at end of file, or -1 if error
+ */
+AKS_INTERNAL int aks_direct_fill(aks_direct *pd) {
+  
+  DWORD got = 0;
+  DWORD err = 0;
+  
+  pd->len = 0;
+  pd->pos = 0;
+  
+  for(;;) {
+    if (ReadFile(pd->h, pd->pBuf, AKS_DIRECT_BUFSIZE, &got, NULL)) {
+      break;
+    }
+    err = GetLastError();
+    if (err == ERROR_HANDLE_EOF) {
+      got = 0;
+      break;
+    }
+    if ((err != ERROR_INVALID_PARAMETER) || (!(pd->direct))) {
+      return -1;
+    }
+    if (aks_direct_uncache(pd) != 0) {
+      return -1;
+    }
+  }
+  
+  if (got == 0) {
+    pd->eof = 1;
+    return 0;
+  }
+  
+  pd->off.QuadPart += got;
+  pd->len = (size_t) got;
+  
+  /* If this fails, the next read fails and tries again */
+  if (pd->direct && ((got % AKS_DIRECT_ALIGN) != 0)) {
+    aks_direct_uncache(pd);
+  }
+  
+  return 0;
+}
+
+/*
+ * Open a file for one-pass reading that bypasses the file cache.
+ * 
+ * The file is opened with FILE_FLAG_NO_BUFFERING.  If that fails, the
+ * file is opened for sequential cached reads instead, unless
+ * AKS_DIRECT_STRICT is given.
+ * 
+ * Parameters:
+ * 
+ *   pPath - the UTF-8 path of the file
+ * 
+ *   flags - zero or AKS_DIRECT_STRICT
+ * 
+ * Return:
+ * 
+ *   the reader, or NULL if error
+ */
+AKS_API aks_direct *aks_open_direct(const char *pPath, int flags) {
+  
+  aks_direct *pd = NULL;
+  aks_tchar *pt = NULL;
+  
+  pt = aks_toapi(pPath);
+  if (pt == NULL) {
+    return NULL;
+  }
+  
+  pd = (aks_direct *) calloc(1, sizeof(aks_direct));
+  if (pd != NULL) {
+    pd->pBuf = (char *) VirtualAlloc(
+                NULL,
+                AKS_DIRECT_BUFSIZE,
+                MEM_COMMIT | MEM_RESERVE,
+                PAGE_READWRITE);
+    if (pd->pBuf == NULL) {
+      free(pd);
+      pd = NULL;
+    }
+  }
+  
+  if (pd != NULL) {
+    pd->h = CreateFile(
+              pt,
+              GENERIC_READ,
+              FILE_SHARE_READ | FILE_SHARE_WRITE,
+              NULL,
+              OPEN_EXISTING,
+              FILE_FLAG_NO_BUFFERING | FILE_FLAG_SEQUENTIAL_SCAN,
+              NULL);
+    if (pd->h != INVALID_HANDLE_VALUE) {
+      pd->direct = 1;
+    } else if (!(flags & AKS_DIRECT_STRICT)) {
+      pd->h = CreateFile(
+                pt,
+                GENERIC_READ,
+                FILE_SHARE_READ | FILE_SHARE_WRITE,
+                NULL,
+                OPEN_EXISTING,
+                FILE_FLAG_SEQUENTIAL_SCAN,
+                NULL);
+    }
+    
+    if (pd->h == INVALID_HANDLE_VALUE) {
+      VirtualFree(pd->pBuf, 0, MEM_RELEASE);
+      free(pd);
+      pd = NULL;
+    }
+  }
+  
+  free(pt);
+  return pd;
+}
+
+/*
+ * Close a reader.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader, or NULL
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_API int aks_direct_close(aks_direct *pd) {
+  
+  BOOL ok = TRUE;
+  
+  if (pd == NULL) {
+    return 0;
+  }
+  
+  ok = CloseHandle(pd->h);
+  VirtualFree(pd->pBuf, 0, MEM_RELEASE);
+  free(pd);
+  
+  return ok ? 0 : -1;
+}
+
+#endif
+
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Get the next piece of a file straight from the aligned buffer of a
+ * reader, without copying.
+ * 
+ * The data stays valid until the next call on the reader.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader
+ * 
+ *   ppData - receives a pointer to the data
+ * 
+ * Return:
+ * 
+ *   the number of bytes available, zero at end of file, or -1 if error
+ */
+AKS_API long aks_direct_next(aks_direct *pd, const char **ppData) {
+  
+  size_t k = 0;
+  
+  if (pd->pos >= pd->len) {
+    if (pd->eof) {
+      return 0;
+    }
+    if (aks_direct_fill(pd) != 0) {
+      return -1;
+    }
+  }
+  
+  k = pd->len - pd->pos;
+  *ppData = pd->pBuf + pd->pos;
+  pd->pos = pd->len;
+  
+  return (long) k;
+}
+
+/*
+ * Read from a reader into a buffer of any size and alignment.
+ * 
+ * Parameters:
+ * 
+ *   pd - the reader
+ * 
+ *   pBuf - the buffer to read into
+ * 
+ *   n - the number of bytes to read
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, which is less than n only at end of file
+ *   or on error, or -1 if an error occurred before anything was read
+ */
+AKS_API long aks_direct_read(aks_direct *pd, void *pBuf, size_t n) {
+  
+  char *pc = (char *) pBuf;
+  size_t done = 0;
+  size_t k = 0;
+  
+  if (n > (size_t) LONG_MAX) {
+    n = (size_t) LONG_MAX;
+  }
+  
+  while (done < n) {
+    if (pd->pos >= pd->len) {
+      if (pd->eof) {
+        break;
+      }
+      if (aks_direct_fill(pd) != 0) {
+        return (done > 0) ? (long) done : -1;
+      }
+      continue;
+    }
+    
+    k = pd->len - pd->pos;
+    if (k > n - done) {
+      k = n - done;
+    }
+    memcpy(pc + done, pd->pBuf + pd->pos, k);
+    pd->pos += k;
+    done += k;
+  }
+  
+  return (long) done;
+}
+
+#endif
+
+/* Public function declarations */
+AKS_API aks_direct *aks_open_direct(const char *pPath, int flags);
+AKS_API int aks_direct_close(aks_direct *pd);
+AKS_API long aks_direct_next(aks_direct *pd, const char **ppData);
+AKS_API long aks_direct_read(aks_direct *pd, void *pBuf, size_t n);
+
+#endif
+#endif
+
+/* * * * * * * * *
+ *               *
+ * Vectored I/O  *
+ *               *
+ * * * * * * * * */
+
+/* Only proceed if vectored I/O requested and not already defined */
+#ifdef AKS_VECIO
+#ifndef AKS_VECIO_INCLUDED
+#define AKS_VECIO_INCLUDED
+
+#include <errno.h>
+#include <limits.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * Largest number of segments handed to a single system call.  Longer
+ * arrays are transferred in several calls.
+ * 
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_VECIO_BATCH
+#define AKS_VECIO_BATCH 64
+#endif
+
+/*
+ * One segment of a scatter or gather list.  On POSIX this is the system
+ * iovec structure, so that lists can be handed to the system unchanged,
+ * and on Windows it is a structure with the same fields.
+ */
+#ifdef AKS_POSIX
+#include <sys/uio.h>
+typedef struct iovec aks_iovec;
+#else
+typedef struct {
+  void *iov_base;
+  size_t iov_len;
+} aks_iovec;
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Check a segment list and add up its length.
+ * 
+ * Parameters:
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ * Return:
+ * 
+ *   the total length in bytes, or -1 if the count is negative or the
+ *   total does not fit in a long
+ */
+AKS_INTERNAL long aks_vecio_total(const aks_iovec *pIov, int cnt) {
+  
+  size_t total = 0;
+  int i = 0;
+  
+  if (cnt < 0) {
+    errno = EINVAL;
+    return -1;
+  }
+  
+  for(i = 0; i < cnt; i++) {
+    if (pIov[i].iov_len > ((size_t) LONG_MAX) - total) {
+      errno = EINVAL;
+      return -1;
+    }
+    total += pIov[i].iov_len;
+  }
+  
+  return (long) total;
+}
+
+#endif
+
+#ifdef AKS_POSIX
+/* POSIX implementation of vectored I/O ============================= */
+
+#include <sys/types.h>
+#include <unistd.h>
+
+/* The system may accept fewer segments per call than the batch size;
+ * POSIX guarantees at least 16 */
+#ifdef IOV_MAX
+#define AKS_VECIO_MAX IOV_MAX
+#else
+#define AKS_VECIO_MAX 16
+#endif
+
+/* pread() and pwrite() are only declared with the X/Open extensions or
+ * POSIX.1-2008, and the positional functions are only provided where
+ * they are */
+#ifdef AKS_FILE64
+#if AKS_POSIX_DECL >= 200809L
+#define AKS_VECIO_POSITIONAL
+#elif AKS_POSIX_DECL_XOPEN >= 199506L
+#define AKS_VECIO_POSITIONAL
+#endif
+#endif
+
+/* glibc declares the positional vectored functions along with its
+ * other extensions; elsewhere they are emulated with pread() and
+ * pwrite() */
+#ifdef __GLIBC__
+#ifdef AKS_POSIX_DECL_MISC
+#define AKS_VECIO_GLIBC_POSITIONAL
+#endif
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Copy the next batch of the segments that remain to be transferred,
+ * trimming the first of them by the bytes already transferred from it.
+ * 
+ * Parameters:
+ * 
+ *   pDst - receives at most AKS_VECIO_BATCH segments
+ * 
+ *   pIov - the remaining segments
+ * 
+ *   cnt - the number of remaining segments, greater than zero
+ * 
+ *   skip - the bytes already transferred from the first segment
+ * 
+ *   pLen - receives the total length of the batch
+ * 
+ * Return:
+ * 
+ *   the number of segments in the batch
+ */
+AKS_INTERNAL int aks_vecio_batch(
+    aks_iovec         * pDst,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    size_t              skip,
+    size_t            * pLen) {
+  
+  int i = 0;
+  
+  if (cnt > AKS_VECIO_BATCH) {
+    cnt = AKS_VECIO_BATCH;
+  }
+  if (cnt > AKS_VECIO_MAX) {
+    cnt = AKS_VECIO_MAX;
+  }
+  
+  *pLen = 0;
+  for(i = 0; i < cnt; i++) {
+    pDst[i] = pIov[i];
+    *pLen += pIov[i].iov_len;
+  }
+  
+  pDst[0].iov_base = ((char *) pDst[0].iov_base) + skip;
+  pDst[0].iov_len -= skip;
+  *pLen -= skip;
+  
+  return cnt;
+}
+
+/*
+ * Move past the bytes transferred by one call.
+ * 
+ * Parameters:
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   pi - the index of the current segment, updated
+ * 
+ *   pSkip - the bytes already transferred from the current segment,
+ *   updated
+ * 
+ *   n - the number of bytes transferred
+ */
+AKS_INTERNAL void aks_vecio_advance(
+    const aks_iovec   * pIov,
+    int                 cnt,
+    int               * pi,
+    size_t            * pSkip,
+    size_t              n) {
+  
+  size_t left = 0;
+  
+  while (*pi < cnt) {
+    left = pIov[*pi].iov_len - *pSkip;
+    if (n < left) {
+      *pSkip += n;
+      break;
+    }
+    n -= left;
+    (*pi)++;
+    *pSkip = 0;
+  }
+}
+
+#ifdef AKS_VECIO_POSITIONAL
+
+/*
+ * Make one positional gather write.
+ * 
+ * Without pwritev(), only the first non-empty segment is written,
+ * which the caller treats as a short write.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   off - the file offset to write at
+ * 
+ * Return:
+ * 
+ *   the number of bytes written, or -1 if error
+ */
+AKS_INTERNAL ssize_t aks_vecio_pwrite(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off) {
+  
+#ifdef AKS_VECIO_GLIBC_POSITIONAL
+  return pwritev(fd, pIov, cnt, off);
+#else
+  int i = 0;
+  
+  for(i = 0; i < cnt; i++) {
+    if (pIov[i].iov_len > 0) {
+      return pwrite(fd, pIov[i].iov_base, pIov[i].iov_len, off);
+    }
+  }
+  return 0;
+#endif
+}
+
+/*
+ * Make one positional scatter read.
+ * 
+ * Without preadv(), the segments are read into one after another with
+ * pread() until one of them is not filled.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   off - the file offset to read from
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_INTERNAL ssize_t aks_vecio_pread(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off) {
+  
+#ifdef AKS_VECIO_GLIBC_POSITIONAL
+  return preadv(fd, pIov, cnt, off);
+#else
+  ssize_t done = 0;
+  ssize_t r = 0;
+  int i = 0;
+  
+  /* Positional reads are only of seekable files, where reading further
+   * after a segment is filled can never block */
+  for(i = 0; i < cnt; i++) {
+    r = pread(
+          fd, pIov[i].iov_base, pIov[i].iov_len, off + (aks_off64) done);
+    if (r < 0) {
+      return (done > 0) ? done : -1;
+    }
+    done += r;
+    if (((size_t) r) < pIov[i].iov_len) {
+      break;
+    }
+  }
+  return done;
+#endif
+}
+
+#endif
+
+/*
+ * Write a list of segments to a file descriptor, in order, as if they
+ * were one contiguous buffer.
+ * 
+ * Each call to writev() takes up to AKS_VECIO_BATCH segments, and
+ * short writes are continued until everything is written, so a record
+ * assembled from a few separate buffers is normally written with a
+ * single system call.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ * Return:
+ * 
+ *   the total number of bytes written, or -1 if error, in which case
+ *   part of the data may have been written
+ */
+AKS_API long aks_writev(int fd, const aks_iovec *pIov, int cnt) {
+  
+  aks_iovec v[AKS_VECIO_BATCH];
+  long total = 0;
+  size_t len = 0;
+  size_t skip = 0;
+  ssize_t r = 0;
+  int i = 0;
+  int k = 0;
+  
+  total = aks_vecio_total(pIov, cnt);
+  if (total < 0) {
+    return -1;
+  }
+  
+  while (i < cnt) {
+    k = aks_vecio_batch(v, pIov + i, cnt - i, skip, &len);
+    r = writev(fd, v, k);
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    if ((r == 0) && (len > 0)) {
+      errno = EIO;
+      return -1;
+    }
+    aks_vecio_advance(pIov, cnt, &i, &skip, (size_t) r);
+  }
+  
+  return total;
+}
+
+/*
+ * Read from a file descriptor into a list of segments, filling each in
+ * order before moving to the next.
+ * 
+ * This is a single readv() call, so like read() it may return fewer
+ * bytes than the segments can hold.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_API long aks_readv(int fd, const aks_iovec *pIov, int cnt) {
+  
+  aks_iovec v[AKS_VECIO_BATCH];
+  size_t len = 0;
+  ssize_t r = 0;
+  int k = 0;
+  
+  if (aks_vecio_total(pIov, cnt) <= 0) {
+    return (cnt < 0) ? -1 : 0;
+  }
+  
+  /* Skip empty segments, so that a batch of them does not look like
+   * the end of the file */
+  while (pIov->iov_len == 0) {
+    pIov++;
+    cnt--;
+  }
+  
+  k = aks_vecio_batch(v, pIov, cnt, 0, &len);
+  do {
+    r = readv(fd, v, k);
+  } while ((r < 0) && (errno == EINTR));
+  
+  return (long) r;
+}
+
+#ifdef AKS_VECIO_POSITIONAL
+
+/*
+ * Write a list of segments at a given offset in a file, without using
+ * or moving the file position.
+ * 
+ * Short writes are continued until everything is written.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   off - the file offset to write at
+ * 
+ * Return:
+ * 
+ *   the total number of bytes written, or -1 if error, in which case
+ *   part of the data may have been written
+ */
+AKS_API long aks_pwritev64(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off) {
+  
+  aks_iovec v[AKS_VECIO_BATCH];
+  long total = 0;
+  size_t len = 0;
+  size_t skip = 0;
+  ssize_t r = 0;
+  int i = 0;
+  int k = 0;
+  
+  total = aks_vecio_total(pIov, cnt);
+  if (total < 0) {
+    return -1;
+  }
+  
+  while (i < cnt) {
+    k = aks_vecio_batch(v, pIov + i, cnt - i, skip, &len);
+    r = aks_vecio_pwrite(fd, v, k, off);
+    if (r < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    if ((r == 0) && (len > 0)) {
+      errno = EIO;
+      return -1;
+    }
+    aks_vecio_advance(pIov, cnt, &i, &skip, (size_t) r);
+    off += (aks_off64) r;
+  }
+  
+  return total;
+}
+
+/*
+ * Read from a given offset in a file into a list of segments, without
+ * using or moving the file position.
+ * 
+ * Like pread(), this may return fewer bytes than the segments can hold.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   off - the file offset to read from
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_API long aks_preadv64(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off) {
+  
+  aks_iovec v[AKS_VECIO_BATCH];
+  size_t len = 0;
+  ssize_t r = 0;
+  int k = 0;
+  
+  if (aks_vecio_total(pIov, cnt) <= 0) {
+    return (cnt < 0) ? -1 : 0;
+  }
+  
+  /* Skip empty segments, so that a batch of them does not look like
+   * the end of the file */
+  while (pIov->iov_len == 0) {
+    pIov++;
+    cnt--;
+  }
+  
+  k = aks_vecio_batch(v, pIov, cnt, 0, &len);
+  do {
+    r = aks_vecio_pread(fd, v, k, off);
+  } while ((r < 0) && (errno == EINTR));
+  
+  return (long) r;
+}
+
+#endif
+
+#endif
+
+#else
+/* Windows implementation of vectored I/O =========================== */
+
+#include <io.h>
+
+#ifdef AKS_FILE64
+#define AKS_VECIO_POSITIONAL
+#endif
+
+/*
+ * Size in bytes of the stack buffer that small segments are gathered
+ * into so that they are written in a single call.
+ * 
+ * May be overridden by defining it before including the header.
+ */
+#ifndef AKS_VECIO_STAGE
+#define AKS_VECIO_STAGE 8192
+#endif
+
+#ifdef AKS_BODIES
+
+/*
+ * Write a whole buffer to a file descriptor.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pc - the data
+ * 
+ *   n - the number of bytes, at most LONG_MAX
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_vecio_putall(int fd, const char *pc, size_t n) {
+  
+  int r = 0;
+  
+  while (n > 0) {
+    r = _write(fd, pc, (unsigned int) n);
+    if (r < 0) {
+      return -1;
+    }
+    if (r == 0) {
+      errno = ENOSPC;
+      return -1;
+    }
+    pc += r;
+    n -= (size_t) r;
+  }
+  
+  return 0;
+}
+
+/*
+ * Write a list of segments to a file descriptor at its current
+ * position.
+ * 
+ * Windows has no gather write for ordinary files, so segments are
+ * copied into a stack buffer and written together whenever they fit,
+ * and segments too large for the buffer are written directly.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ * Return:
+ * 
+ *   zero if successful, -1 if error
+ */
+AKS_INTERNAL int aks_vecio_gather(int fd, const aks_iovec *pIov, int cnt) {
+  
+  char stage[AKS_VECIO_STAGE];
+  size_t used = 0;
+  size_t n = 0;
+  int i = 0;
+  
+  for(i = 0; i < cnt; i++) {
+    n = pIov[i].iov_len;
+    
+    if (n > AKS_VECIO_STAGE - used) {
+      if (aks_vecio_putall(fd, stage, used) != 0) {
+        return -1;
+      }
+      used = 0;
+      
+      if (n >= AKS_VECIO_STAGE) {
+        if (aks_vecio_putall(fd, (const char *) pIov[i].iov_base, n)
+              != 0) {
+          return -1;
+        }
+        continue;
+      }
+    }
+    
+    memcpy(stage + used, pIov[i].iov_base, n);
+    used += n;
+  }
+  
+  return aks_vecio_putall(fd, stage, used);
+}
+
+/*
+ * Write a list of segments to a file descriptor, in order, as if they
+ * were one contiguous buffer.
+ * 
+ * Segments that fit together in AKS_VECIO_STAGE bytes are copied into
+ * a stack buffer and written with a single call.  Short writes are
+ * continued until everything is written.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ * Return:
+ * 
+ *   the total number of bytes written, or -1 if error, in which case
+ *   part of the data may have been written
+ */
+AKS_API long aks_writev(int fd, const aks_iovec *pIov, int cnt) {
+  
+  long total = 0;
+  
+  total = aks_vecio_total(pIov, cnt);
+  if (total < 0) {
+    return -1;
+  }
+  
+  if (aks_vecio_gather(fd, pIov, cnt) != 0) {
+    return -1;
+  }
+  
+  return total;
+}
+
+/*
+ * Read from a file descriptor into a list of segments, filling each in
+ * order before moving to the next.
+ * 
+ * Segments that fit together in AKS_VECIO_STAGE bytes are read with a
+ * single call into a stack buffer and then copied out.  Otherwise only
+ * the first non-empty segment is read into, which is a short read as
+ * far as the caller is concerned.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_API long aks_readv(int fd, const aks_iovec *pIov, int cnt) {
+  
+  char stage[AKS_VECIO_STAGE];
+  const char *pc = NULL;
+  long total = 0;
+  size_t n = 0;
+  size_t k = 0;
+  int r = 0;
+  int i = 0;
+  
+  total = aks_vecio_total(pIov, cnt);
+  if (total <= 0) {
+    return total;
+  }
+  
+  while (pIov[i].iov_len == 0) {
+    i++;
+  }
+  
+  if ((((long) pIov[i].iov_len) == total) || (total > AKS_VECIO_STAGE)) {
+    return (long) _read(
+                    fd, pIov[i].iov_base, (unsigned int) pIov[i].iov_len);
+  }
+  
+  r = _read(fd, stage, (unsigned int) total);
+  if (r <= 0) {
+    return (long) r;
+  }
+  
+  pc = stage;
+  n = (size_t) r;
+  for( ; n > 0; i++) {
+    k = pIov[i].iov_len;
+    if (k > n) {
+      k = n;
+    }
+    memcpy(pIov[i].iov_base, pc, k);
+    pc += k;
+    n -= k;
+  }
+  
+  return (long) r;
+}
+
+#ifdef AKS_VECIO_POSITIONAL
+
+/*
+ * Write a list of segments at a given offset in a file, leaving the
+ * file position where it was.
+ * 
+ * Windows has no positional write for file descriptors, so the file
+ * position is moved to the offset for the write and then restored.
+ * Unlike on POSIX, this must not race with other threads using the
+ * same descriptor.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   off - the file offset to write at
+ * 
+ * Return:
+ * 
+ *   the total number of bytes written, or -1 if error, in which case
+ *   part of the data may have been written
+ */
+AKS_API long aks_pwritev64(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off) {
+  
+  aks_off64 pos = 0;
+  long total = 0;
+  int err = 0;
+  
+  total = aks_vecio_total(pIov, cnt);
+  if (total < 0) {
+    return -1;
+  }
+  
+  pos = _lseeki64(fd, 0, SEEK_CUR);
+  if (pos < 0) {
+    return -1;
+  }
+  if (_lseeki64(fd, off, SEEK_SET) < 0) {
+    return -1;
+  }
+  
+  if (aks_vecio_gather(fd, pIov, cnt) != 0) {
+    err = errno;
+    total = -1;
+  }
+  
+  _lseeki64(fd, pos, SEEK_SET);
+  if (total < 0) {
+    errno = err;
+  }
+  
+  return total;
+}
+
+/*
+ * Read from a given offset in a file into a list of segments, leaving
+ * the file position where it was.
+ * 
+ * The file position is moved to the offset for the read and then
+ * restored, so unlike on POSIX, this must not race with other threads
+ * using the same descriptor.  The segments are read into one after
+ * another until one of them is not filled, so fewer bytes than the
+ * segments can hold are only returned near the end of the file.
+ * 
+ * Parameters:
+ * 
+ *   fd - the file descriptor
+ * 
+ *   pIov - the segments
+ * 
+ *   cnt - the number of segments
+ * 
+ *   off - the file offset to read from
+ * 
+ * Return:
+ * 
+ *   the number of bytes read, zero at end of file, or -1 if error
+ */
+AKS_API long aks_preadv64(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off) {
+  
+  aks_off64 pos = 0;
+  long result = 0;
+  int err = 0;
+  int r = 0;
+  int i = 0;
+  
+  if (aks_vecio_total(pIov, cnt) < 0) {
+    return -1;
+  }
+  
+  pos = _lseeki64(fd, 0, SEEK_CUR);
+  if (pos < 0) {
+    return -1;
+  }
+  if (_lseeki64(fd, off, SEEK_SET) < 0) {
+    return -1;
+  }
+  
+  for(i = 0; i < cnt; i++) {
+    r = _read(fd, pIov[i].iov_base, (unsigned int) pIov[i].iov_len);
+    if (r < 0) {
+      if (result == 0) {
+        err = errno;
+        result = -1;
+      }
+      break;
+    }
+    result += r;
+    if (((size_t) r) < pIov[i].iov_len) {
+      break;
+    }
+  }
+  
+  _lseeki64(fd, pos, SEEK_SET);
+  if (result < 0) {
+    errno = err;
+  }
+  
+  return result;
+}
+
+#endif
+
+#endif
+
+#endif
+
+/*
+ * Write a record from separate buffers through a stream, which must be
+ * flushed first so that its buffered output stays in order.
+ * 
+ * fileno() is only declared when POSIX declarations are visible, so on
+ * POSIX this is only defined then.
+ */
+#ifdef AKS_POSIX
+#if AKS_POSIX_DECL >= 1
+#define AKS_VECIO_STREAMS
+#define aks_fwritev(fp, pIov, cnt) \
+  ((fflush(fp) == 0) ? aks_writev(fileno(fp), (pIov), (cnt)) : -1L)
+#endif
+#else
+#define AKS_VECIO_STREAMS
+#define aks_fwritev(fp, pIov, cnt) \
+  ((fflush(fp) == 0) ? aks_writev(_fileno(fp), (pIov), (cnt)) : -1L)
+#endif
+
+/* Public function declarations */
+AKS_API long aks_writev(int fd, const aks_iovec *pIov, int cnt);
+AKS_API long aks_readv(int fd, const aks_iovec *pIov, int cnt);
+#ifdef AKS_VECIO_POSITIONAL
+AKS_API long aks_pwritev64(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off);
+AKS_API long aks_preadv64(
+    int                 fd,
+    const aks_iovec   * pIov,
+    int                 cnt,
+    aks_off64           off);
+#endif
+
+#endif
+#endif
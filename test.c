@@ -21,6 +21,14 @@
  * characters on POSIX, depending on whether the shell is interpreting
  * UTF-8 or not.
  * 
+ * NOTE 4: Define AKS_TRACE while compiling to record the translated
+ * functions called by this program, which are written to
+ * aks_trace.json in the Chrome trace format at exit.
+ * 
+ * NOTE 5: Define AKS_EMULATE_WIN_UNICODE while compiling on POSIX to
+ * run the Windows Unicode translation layer, including the wmain
+ * argument translation, over the emulated wide-character API.
+ * 
  * The program begins by setting binary mode on standard input and text
  * mode on standard output using the portable macro functions.  Then, it
  * prints the platform determined by the macro definitions.  Finally, it
@@ -37,6 +45,26 @@
 #define AKS_BINMODE
 #define AKS_TRANSLATE_MAIN
 #define AKS_SETERR
+#define AKS_ASCII
+#define AKS_INTFMT
+#define AKS_DBLFMT
+#define AKS_TMPFILE
+#define AKS_DIR
+#define AKS_STAT
+#define AKS_SPAWN
+#define AKS_SYNC
+#define AKS_ADVISE
+#define AKS_HUGE
+#define AKS_RING
+#define AKS_HASH
+#define AKS_SBUF
+#define AKS_POLL
+#define AKS_STDIO_UNLOCKED
+#define AKS_DIRECT
+#define AKS_VECIO
+#ifdef AKS_FILE64
+#define AKS_PREALLOC
+#endif
 #include "aksmacro.h"
 
 /* Include the header again just to check it works */
@@ -45,6 +73,7 @@
 /* Other includes */
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 /* (Translated) program entrypoint */
 static int maint(int argc, char *argv[]) {
@@ -53,12 +82,55 @@ static int maint(int argc, char *argv[]) {
   char tfile[L_tmpnam + 1];
   char *pResult = NULL;
   const char *pVar = NULL;
+  char abuf[300];
+  char lbuf[300];
+  int i = 0;
+  int ok = 0;
+  char nbuf[AKS_FMT_INT_BUFSIZE];
+  int64_t iv = 0;
+  uint64_t uv = 0;
+  char dbuf[AKS_FMT_DBL_BUFSIZE];
+  double dv = 0.0;
+  aks_dir *pDir = NULL;
+  aks_dirent dent[64];
+  long dcount = 0;
+  const char *spath[2];
+  aks_stat64 sres[2];
+  aks_proc proc;
+  char *pHuge = NULL;
+  aks_spsc *pSpsc = NULL;
+  aks_mpmc *pMpmc = NULL;
+  void *rbuf[8];
+  aks_hash64_state hst;
+  aks_sbuf sb;
+  aks_tchar *pApi = NULL;
+  aks_poller *pPoll = NULL;
+  aks_poll_event pev[4];
+  long got = 0;
+  int pfd = -1;
+  char *pIobuf = NULL;
+  aks_direct *pDirect = NULL;
+  const char *pData = NULL;
+  aks_iovec viov[90];
+#ifdef AKS_PREALLOC_MAPOUT
+  aks_mapout *pMap = NULL;
+  char *pOut = NULL;
+#endif
+#ifdef AKS_POSIX
+  const char *sargv[] = {"sh", "-c", "exit 3", NULL};
+  const char *pargv[] = {"sh", "-c", "echo piped", NULL};
+#else
+  const char *sargv[] = {"cmd", "/c", "exit 3", NULL};
+  const char *pargv[] = {"cmd", "/c", "echo piped", NULL};
+#endif
 #ifdef AKS_FILE64
   aks_off64 fs = 0;
 #else
   long fs = 0;
 #endif
 
+  aks_trace_begin("maint");
+  
   /* Set binary and text mode */
   if (aks_textmode(stdout) != -1) {
     printf("Changed standard output to text mode.\n");
@@ -110,6 +182,757 @@ static int maint(int argc, char *argv[]) {
   }
   aks_seterr(0);
   
+  /* Reopen a file in another mode and rename it with the translated
+   * functions */
+  ok = 0;
+  fh = fopent("aks_rename_test.tmp", "wb");
+  if (fh != NULL) {
+    fputs("renamed", fh);
+    fh = freopent("aks_rename_test.tmp", "rb", fh);
+    if (fh != NULL) {
+      if (fgets(abuf, (int) sizeof(abuf), fh) != NULL) {
+        if (strcmp(abuf, "renamed") == 0) {
+          ok = 1;
+        }
+      }
+      fclose(fh);
+      fh = NULL;
+    }
+  }
+  if (ok) {
+    if (renamet("aks_rename_test.tmp", "aks_rename_test.dat") != 0) {
+      ok = 0;
+    }
+    fh = fopent("aks_rename_test.dat", "rb");
+    if (fh != NULL) {
+      fclose(fh);
+      fh = NULL;
+    } else {
+      ok = 0;
+    }
+  }
+  removet("aks_rename_test.tmp");
+  removet("aks_rename_test.dat");
+  if (ok) {
+    printf("Rename test passed.\n");
+  } else {
+    printf("Rename test FAILED.\n");
+  }
+  
+  /* Test the US-ASCII classes and the bulk case functions over every
+   * byte value */
+  ok = 1;
+  for(i = 0; i < 300; i++) {
+    abuf[i] = (char) (i & 0xff);
+    lbuf[i] = abuf[i];
+  }
+  aks_ascii_lower(lbuf, 300);
+  for(i = 0; i < 300; i++) {
+    if ((i & 0xff) >= 'A' && (i & 0xff) <= 'Z') {
+      if ((!aks_isupper(abuf[i])) || (lbuf[i] != abuf[i] + 32)) {
+        ok = 0;
+      }
+    } else if (lbuf[i] != abuf[i]) {
+      ok = 0;
+    }
+    if ((!aks_isdigit(abuf[i])) != (((i & 0xff) < '0') ||
+                                    ((i & 0xff) > '9'))) {
+      ok = 0;
+    }
+  }
+  aks_ascii_upper(lbuf, 300);
+  for(i = 0; i < 300; i++) {
+    if (lbuf[i] != (char) aks_toupper(abuf[i])) {
+      ok = 0;
+    }
+  }
+  strcpy(abuf, "12345678901234567890 \t\t \n              \tx");
+  if (aks_ascii_span(abuf, strlen(abuf), AKS_ASCII_DIGIT) != 20) {
+    ok = 0;
+  }
+  if (aks_ascii_span(abuf + 20, strlen(abuf + 20), AKS_ASCII_SPACE)
+        != strlen(abuf + 20) - 1) {
+    ok = 0;
+  }
+  if (aks_ascii_cspan(abuf, strlen(abuf), AKS_ASCII_ALPHA)
+        != strlen(abuf) - 1) {
+    ok = 0;
+  }
+  if (ok) {
+    printf("ASCII test passed.\n");
+  } else {
+    printf("ASCII test FAILED.\n");
+  }
+  
+  /* Test integer formatting and parsing at the limits */
+  ok = 1;
+  aks_fmt_i64(nbuf, INT64_MIN);
+  if (strcmp(nbuf, "-9223372036854775808") != 0) {
+    ok = 0;
+  }
+  if (aks_fmt_u64(nbuf, UINT64_MAX) != 20) {
+    ok = 0;
+  }
+  if (aks_parse_u64(nbuf, strlen(nbuf), &uv) || (uv != UINT64_MAX)) {
+    ok = 0;
+  }
+  if (aks_parse_u64("18446744073709551616", 20, &uv) != ERANGE) {
+    ok = 0;
+  }
+  if (aks_parse_i64("-9223372036854775808", 20, &iv) ||
+        (iv != INT64_MIN)) {
+    ok = 0;
+  }
+  if (aks_parse_i64("9223372036854775808", 19, &iv) != ERANGE) {
+    ok = 0;
+  }
+  if (aks_parse_i64("+0012x", 6, &iv) != EINVAL) {
+    ok = 0;
+  }
+  aks_fmt_i64(nbuf, 0);
+  if (strcmp(nbuf, "0") != 0) {
+    ok = 0;
+  }
+  if (ok) {
+    printf("Integer format test passed.\n");
+  } else {
+    printf("Integer format test FAILED.\n");
+  }
+  
+  /* Test shortest floating-point formatting and correctly rounded
+   * parsing */
+  ok = 1;
+  aks_fmt_double(dbuf, 0.1);
+  if (strcmp(dbuf, "0.1") != 0) {
+    ok = 0;
+  }
+  aks_fmt_double(dbuf, -1e23);
+  if (strcmp(dbuf, "-1e+23") != 0) {
+    ok = 0;
+  }
+  aks_fmt_double(dbuf, 5e-324);
+  if (strcmp(dbuf, "5e-324") != 0) {
+    ok = 0;
+  }
+  aks_fmt_double(dbuf, 1.0 / 3.0);
+  if (aks_parse_double(dbuf, strlen(dbuf), &dv) || (dv != 1.0 / 3.0)) {
+    ok = 0;
+  }
+  if (aks_parse_double("9007199254740993", 16, &dv) ||
+        (dv != 9007199254740992.0)) {
+    ok = 0;
+  }
+  if (aks_parse_double("1e400", 5, &dv) != ERANGE) {
+    ok = 0;
+  }
+  if (aks_parse_double("1,5", 3, &dv) != EINVAL) {
+    ok = 0;
+  }
+  if (ok) {
+    printf("Floating-point format test passed.\n");
+  } else {
+    printf("Floating-point format test FAILED.\n");
+  }
+  
+  /* Test anonymous scratch files */
+  fh = aks_tmpfile_fast(NULL);
+  if (fh != NULL) {
+    ok = 0;
+    if (fputs("scratch", fh) != EOF) {
+      rewind(fh);
+      if (fgets(abuf, (int) sizeof(abuf), fh) != NULL) {
+        if (strcmp(abuf, "scratch") == 0) {
+          ok = 1;
+        }
+      }
+    }
+    fclose(fh);
+    fh = NULL;
+    if (ok) {
+      printf("Scratch file test passed.\n");
+    } else {
+      printf("Scratch file test FAILED.\n");
+    }
+  } else {
+    printf("Failed to create scratch file!\n");
+  }
+  
+  /* Test directory enumeration on the current directory */
+  pDir = aks_dir_open(".");
+  if (pDir != NULL) {
+    dcount = 0;
+    while ((i = aks_dir_read(pDir, dent, 64)) > 0) {
+      dcount += i;
+    }
+    aks_dir_close(pDir);
+    pDir = NULL;
+    if (i == 0) {
+      printf("Directory test listed %ld entries.\n", dcount);
+    } else {
+      printf("Directory test FAILED.\n");
+    }
+  } else {
+    printf("Failed to open current directory!\n");
+  }
+  
+  /* Test metadata queries on a directory and a missing path */
+  spath[0] = ".";
+  spath[1] = "no-such-file-for-aksmacro-test";
+  if ((aks_stat64_many(spath, 2, sres) == 1) &&
+      (sres[0].err == 0) && (sres[0].type == AKS_DIR_DIR) &&
+      (sres[1].err == ENOENT)) {
+    printf("Metadata test passed.\n");
+  } else {
+    printf("Metadata test FAILED.\n");
+  }
+  
+  /* Test spawning a command and collecting its exit status */
+  i = -1;
+  if ((aks_spawn(sargv, NULL, NULL, &proc) == 0) &&
+      (aks_spawn_wait(&proc, &i) == 0) && (i == 3)) {
+    printf("Spawn test passed.\n");
+  } else {
+    printf("Spawn test FAILED.\n");
+  }
+  
+  /* Test capturing the output of a command through a pipe */
+  ok = 0;
+#ifdef AKS_SPAWN_STREAMS
+  if (aks_spawn_pipe(pargv, NULL, AKS_SPAWN_STDOUT, &proc, &fh, NULL) == 0) {
+    memset(lbuf, 0, sizeof(lbuf));
+    if (fread(lbuf, 1, sizeof(lbuf) - 1, fh) >= 6) {
+      if (memcmp(lbuf, "piped", 5) == 0) {
+        ok = 1;
+      }
+    }
+    fclose(fh);
+    fh = NULL;
+    if (aks_spawn_wait(&proc, &i) != 0) {
+      ok = 0;
+    }
+  }
+#else
+  /* Without streams, which only happens on POSIX, read the descriptor
+   * directly until end of file */
+  if (aks_spawn_pipefd(pargv, NULL, AKS_SPAWN_STDOUT, &proc, &pfd, NULL)
+        == 0) {
+    memset(lbuf, 0, sizeof(lbuf));
+    dcount = 0;
+    while ((got = (long) read(pfd, lbuf + dcount,
+              sizeof(lbuf) - 1 - (size_t) dcount)) > 0) {
+      dcount += got;
+    }
+    if ((got == 0) && (dcount >= 6) && (memcmp(lbuf, "piped", 5) == 0)) {
+      ok = 1;
+    }
+    aks_spawn_closefd(pfd);
+    pfd = -1;
+    if (aks_spawn_wait(&proc, &i) != 0) {
+      ok = 0;
+    }
+  }
+#endif
+  if (ok) {
+    printf("Pipe capture test passed.\n");
+  } else {
+    printf("Pipe capture test FAILED.\n");
+  }
+  
+  /* Test draining the output of a command by waiting for readiness */
+  ok = 0;
+  pPoll = aks_poll_new();
+  if (pPoll != NULL) {
+    if (aks_spawn_pipefd(pargv, NULL, AKS_SPAWN_STDOUT, &proc, &pfd, NULL)
+          == 0) {
+      if (aks_poll_add(pPoll, pfd, &proc) == 0) {
+        memset(lbuf, 0, sizeof(lbuf));
+        dcount = 0;
+        got = 1;
+        while ((got > 0) && (aks_poll(pPoll, pev, 4, 10000) == 1) &&
+                (pev[0].fd == pfd) && (pev[0].pUser == &proc)) {
+          got = aks_poll_read(pPoll, pfd, lbuf + dcount,
+                  sizeof(lbuf) - 1 - (size_t) dcount);
+          if (got > 0) {
+            dcount += got;
+          }
+        }
+        if ((got == 0) && (memcmp(lbuf, "piped", 5) == 0)) {
+          ok = 1;
+        }
+        aks_poll_del(pPoll, pfd);
+      }
+      aks_spawn_closefd(pfd);
+      if (aks_spawn_wait(&proc, &i) != 0) {
+        ok = 0;
+      }
+    }
+    aks_poll_free(pPoll);
+    pPoll = NULL;
+  }
+  if (ok) {
+    printf("Readiness polling test passed.\n");
+  } else {
+    printf("Readiness polling test FAILED.\n");
+  }
+  
+  /* Test a durable write that atomically replaces a file */
+  ok = 0;
+  fh = fopent("aks_sync_test.tmp", "wb");
+  if (fh != NULL) {
+    fputs("durable", fh);
+#ifdef AKS_SYNC_STREAMS
+    if ((aks_fdatasync(fh) == 0) && (aks_sync_many(&fh, 1) == 0) &&
+        (aks_fsync(fh) == 0)) {
+      ok = 1;
+    }
+#else
+    if (fflush(fh) == 0) {
+      ok = 1;
+    }
+#endif
+    fclose(fh);
+    fh = NULL;
+  }
+  if (ok) {
+    if (aks_atomic_replace("aks_sync_test.tmp", "aks_sync_test.dat") != 0) {
+      ok = 0;
+    }
+    removet("aks_sync_test.tmp");
+    removet("aks_sync_test.dat");
+  }
+  if (ok) {
+    printf("Durable write test passed.\n");
+  } else {
+    printf("Durable write test FAILED.\n");
+  }
+  
+  /* Test access-pattern hints on a scratch file */
+  fh = aks_tmpfile_fast(NULL);
+  if (fh != NULL) {
+    ok = 0;
+    if (fputs("hinted", fh) != EOF) {
+      fflush(fh);
+      if ((aks_fadvise(fh, 0, 0, AKS_SEQUENTIAL | AKS_WILLNEED) == 0) &&
+          (aks_fadvise(fh, 0, 0, AKS_DONTNEED) == 0)) {
+        ok = 1;
+      }
+    }
+    fclose(fh);
+    fh = NULL;
+    if (ok) {
+      printf("Access hint test passed.\n");
+    } else {
+      printf("Access hint test FAILED.\n");
+    }
+  } else {
+    printf("Failed to create scratch file!\n");
+  }
+  
+  /* Test a huge-page allocation with a read-ahead hint over it and
+   * report the backing obtained */
+  i = -1;
+  pHuge = (char *) aks_huge_alloc(4194304, &i);
+  if (pHuge != NULL) {
+    ok = 0;
+    pHuge[0] = 1;
+    pHuge[4194303] = 1;
+    if (aks_madvise(pHuge, 4194304, AKS_SEQUENTIAL | AKS_WILLNEED) == 0) {
+      ok = 1;
+    }
+    aks_huge_free(pHuge, 4194304);
+    pHuge = NULL;
+    if (ok) {
+      printf("Huge-page test passed with backing %d.\n", i);
+    } else {
+      printf("Huge-page test FAILED.\n");
+    }
+  } else {
+    printf("Huge-page test FAILED.\n");
+  }
+  
+  /* Test the lock-free rings from a single thread */
+  ok = 0;
+  pSpsc = aks_spsc_new(3);
+  pMpmc = aks_mpmc_new(3);
+  if ((pSpsc != NULL) && (pMpmc != NULL)) {
+    for(i = 0; i < 8; i++) {
+      rbuf[i] = &(abuf[i]);
+    }
+    if ((aks_spsc_push(pSpsc, rbuf, 8) == 4) &&
+        (aks_mpmc_push(pMpmc, rbuf, 8) == 4)) {
+      memset(rbuf, 0, sizeof(rbuf));
+      if ((aks_spsc_pop(pSpsc, rbuf, 8) == 4) &&
+          (rbuf[3] == &(abuf[3])) &&
+          (aks_mpmc_pop(pMpmc, rbuf + 4, 8) == 4) &&
+          (rbuf[7] == &(abuf[3])) &&
+          (aks_spsc_pop(pSpsc, rbuf, 8) == 0) &&
+          (aks_mpmc_pop(pMpmc, rbuf, 8) == 0)) {
+        ok = 1;
+      }
+    }
+  }
+  aks_spsc_free(pSpsc);
+  aks_mpmc_free(pMpmc);
+  pSpsc = NULL;
+  pMpmc = NULL;
+  if (ok) {
+    printf("Ring test passed.\n");
+  } else {
+    printf("Ring test FAILED.\n");
+  }
+  
+  /* Test the checksum and hash against known values, in one piece and
+   * in chunks */
+  ok = 0;
+  aks_hash64_init(&hst, 0);
+  aks_hash64_update(&hst, "a", 1);
+  aks_hash64_update(&hst, "bc", 2);
+  if ((aks_crc32c(0, "123456789", 9) == 0xe3069283UL) &&
+      (aks_crc32c(aks_crc32c(0, "1234", 4), "56789", 5) == 0xe3069283UL) &&
+      (aks_hash64("abc", 3, 0) == UINT64_C(0x44bc2cf5ad770999)) &&
+      (aks_hash64_final(&hst) == UINT64_C(0x44bc2cf5ad770999))) {
+    ok = 1;
+  }
+  if (ok) {
+    printf("Hash test passed.\n");
+  } else {
+    printf("Hash test FAILED.\n");
+  }
+  
+  /* Build a path with the string builder, growing it past the first
+   * allocation, and hand it to the translation layer */
+  ok = 0;
+  aks_sbuf_init(&sb);
+  for(i = 0; i < 20; i++) {
+    aks_sbuf_puts(&sb, "dir/");
+  }
+  aks_sbuf_append(&sb, "part-xyz", 5);
+  aks_sbuf_i64(&sb, -42);
+  aks_sbuf_putc(&sb, '-');
+  aks_sbuf_u64(&sb, UINT64_C(18446744073709551615));
+  if ((sb.len == 109) &&
+      (strcmp(sb.pBuf + 80,
+        "part--42-18446744073709551615") == 0)) {
+    pApi = aks_sbuf_toapi(&sb);
+    if (pApi != NULL) {
+      pResult = aks_fromapi(pApi);
+      if (pResult != NULL) {
+        if ((sb.len == 0) && (strlen(pResult) == 109) &&
+            (strcmp(pResult + 76, "dir/part--42-18446744073709551615")
+              == 0)) {
+          ok = 1;
+        }
+        free(pResult);
+        pResult = NULL;
+      }
+      free(pApi);
+      pApi = NULL;
+    }
+  }
+  aks_sbuf_free(&sb);
+  
+  /* Detaching an empty builder still gives an empty string */
+  pResult = aks_sbuf_detach(&sb);
+  if (pResult != NULL) {
+    if (pResult[0] != 0) {
+      ok = 0;
+    }
+    free(pResult);
+    pResult = NULL;
+  } else {
+    ok = 0;
+  }
+  if (ok) {
+    printf("String builder test passed.\n");
+  } else {
+    printf("String builder test FAILED.\n");
+  }
+  
+  /* Write records through a large buffer with the unlocked functions
+   * while holding the stream lock, then read them back */
+  ok = 0;
+  fh = fopent("aks_unlocked_test.tmp", "w+b");
+  if (fh != NULL) {
+    pIobuf = aks_stdio_buffer(fh, 0);
+    if (pIobuf != NULL) {
+      aks_lock_stream(fh);
+      for(i = 0; i < 1000; i++) {
+        aks_putc_u('a' + (i % 26), fh);
+        aks_fwrite_u("xyz", 1, 3, fh);
+      }
+      aks_fputs_u("end", fh);
+      aks_fflush_u(fh);
+      aks_unlock_stream(fh);
+      
+      rewind(fh);
+      ok = 1;
+      for(i = 0; i < 1000; i++) {
+        if ((aks_getc_u(fh) != 'a' + (i % 26)) ||
+            (aks_fread_u(lbuf, 1, 3, fh) != 3) ||
+            (memcmp(lbuf, "xyz", 3) != 0)) {
+          ok = 0;
+          break;
+        }
+      }
+      if ((aks_fread_u(lbuf, 1, 4, fh) != 3) ||
+          (memcmp(lbuf, "end", 3) != 0)) {
+        ok = 0;
+      }
+    }
+    fclose(fh);
+    fh = NULL;
+    free(pIobuf);
+    pIobuf = NULL;
+    removet("aks_unlocked_test.tmp");
+  }
+  if (ok) {
+    printf("Unlocked stdio test passed.\n");
+  } else {
+    printf("Unlocked stdio test FAILED.\n");
+  }
+  
+  /* Write a file longer than the direct I/O buffer that ends with an
+   * unaligned tail, then read it back in odd-sized pieces followed by
+   * whole buffers */
+  ok = 0;
+  fh = fopent("aks_direct_test.tmp", "wb");
+  if (fh != NULL) {
+    for(dcount = 0; dcount < AKS_DIRECT_BUFSIZE + 12345; dcount++) {
+      putc((int) (dcount % 251), fh);
+    }
+    if (fclose(fh) == 0) {
+      ok = 1;
+    }
+    fh = NULL;
+  }
+  if (ok) {
+    ok = 0;
+    pDirect = aks_open_direct("aks_direct_test.tmp", 0);
+  }
+  if (pDirect != NULL) {
+    ok = 1;
+    dcount = 0;
+    while ((got = aks_direct_read(pDirect, lbuf, 257)) > 0) {
+      for(i = 0; i < (int) got; i++) {
+        if ((unsigned char) lbuf[i] != (unsigned char) (dcount % 251)) {
+          ok = 0;
+        }
+        dcount++;
+      }
+      if (dcount >= 3000) {
+        break;
+      }
+    }
+    while ((got = aks_direct_next(pDirect, &pData)) > 0) {
+      for(i = 0; i < (int) got; i++) {
+        if ((unsigned char) pData[i] != (unsigned char) (dcount % 251)) {
+          ok = 0;
+        }
+        dcount++;
+      }
+    }
+    if ((got != 0) || (dcount != AKS_DIRECT_BUFSIZE + 12345)) {
+      ok = 0;
+    }
+    if (aks_direct_close(pDirect) != 0) {
+      ok = 0;
+    }
+    pDirect = NULL;
+  }
+  removet("aks_direct_test.tmp");
+  if (ok) {
+    printf("Direct I/O test passed.\n");
+  } else {
+    printf("Direct I/O test FAILED.\n");
+  }
+  
+  /* Write thirty records of header, payload and trailer from separate
+   * buffers in a single list longer than one batch, then scatter the
+   * first two records back into separate buffers */
+  ok = 0;
+  memset(lbuf, 'x', 30);
+  for(i = 0; i < 30; i++) {
+    viov[3 * i].iov_base = (void *) "HDR:";
+    viov[3 * i].iov_len = 4;
+    viov[3 * i + 1].iov_base = lbuf;
+    viov[3 * i + 1].iov_len = (size_t) i;
+    viov[3 * i + 2].iov_base = (void *) ";\n";
+    viov[3 * i + 2].iov_len = 2;
+  }
+#ifdef AKS_VECIO_STREAMS
+  fh = fopent("aks_vecio_test.tmp", "w+b");
+  if (fh != NULL) {
+#ifdef AKS_POSIX
+    pfd = fileno(fh);
+#else
+    pfd = _fileno(fh);
+#endif
+  }
+#else
+  /* Without streams, which only happens on POSIX, open the file
+   * directly */
+  pfd = open("aks_vecio_test.tmp", O_RDWR | O_CREAT | O_TRUNC, 0666);
+#endif
+  if (pfd >= 0) {
+#ifdef AKS_VECIO_STREAMS
+    if (aks_fwritev(fh, viov, 90) == 615) {
+      ok = 1;
+    }
+    rewind(fh);
+#else
+    if (aks_writev(pfd, viov, 90) == 615) {
+      ok = 1;
+    }
+    lseek(pfd, 0, SEEK_SET);
+#endif
+    viov[0].iov_base = abuf;
+    viov[0].iov_len = 4;
+    viov[1].iov_base = abuf + 4;
+    viov[1].iov_len = 0;
+    viov[2].iov_base = abuf + 4;
+    viov[2].iov_len = 9;
+    if ((aks_readv(pfd, viov, 3) != 13) ||
+        (memcmp(abuf, "HDR:;\nHDR:x;\n", 13) != 0)) {
+      ok = 0;
+    }
+#ifdef AKS_VECIO_POSITIONAL
+    /* Overwrite the second header in place and read it back, without
+     * moving the file position from the start of the third record */
+    viov[0].iov_base = (void *) "hdr";
+    viov[0].iov_len = 3;
+    viov[1].iov_base = (void *) "=";
+    viov[1].iov_len = 1;
+    if (aks_pwritev64(pfd, viov, 2, 6) != 4) {
+      ok = 0;
+    }
+    viov[0].iov_base = abuf;
+    viov[0].iov_len = 2;
+    viov[1].iov_base = abuf + 2;
+    viov[1].iov_len = 3;
+    if ((aks_preadv64(pfd, viov, 2, 5) != 5) ||
+        (memcmp(abuf, "\nhdr=", 5) != 0)) {
+      ok = 0;
+    }
+#endif
+    viov[0].iov_base = abuf;
+    viov[0].iov_len = 6;
+    if ((aks_readv(pfd, viov, 1) != 6) ||
+        (memcmp(abuf, "HDR:xx", 6) != 0)) {
+      ok = 0;
+    }
+#ifdef AKS_VECIO_STREAMS
+    fclose(fh);
+    fh = NULL;
+#else
+    close(pfd);
+#endif
+    pfd = -1;
+  }
+  removet("aks_vecio_test.tmp");
+  if (ok) {
+    printf("Vectored I/O test passed.\n");
+  } else {
+    printf("Vectored I/O test FAILED.\n");
+  }
+  
+#ifdef AKS_PREALLOC
+  /* Reserve space for a scratch file, then write a mapped output file
+   * across several growth steps and check it is truncated on close */
+  ok = 0;
+  fh = aks_tmpfile_fast(NULL);
+  if (fh != NULL) {
+    if (aks_prealloc(fh, 1048576) == 0) {
+      ok = 1;
+    }
+    fclose(fh);
+    fh = NULL;
+  }
+#ifdef AKS_PREALLOC_MAPOUT
+  pMap = aks_mapout_open("aks_mapout_test.dat", 256);
+  if (pMap == NULL) {
+    ok = 0;
+  } else {
+    for(i = 0; i < 300; i++) {
+      if (aks_mapout_write(pMap, "0123456789", 3) != 0) {
+        ok = 0;
+      }
+    }
+    
+    /* Reserve more than is written, so only the committed tail counts */
+    pOut = (char *) aks_mapout_reserve(pMap, 10);
+    if (pOut != NULL) {
+      memcpy(pOut, "tail", 4);
+      aks_mapout_commit(pMap, 4);
+      pOut = NULL;
+    } else {
+      ok = 0;
+    }
+    if (aks_mapout_close(pMap) != 0) {
+      ok = 0;
+    }
+    pMap = NULL;
+    
+    fh = fopent("aks_mapout_test.dat", "rb");
+    if (fh != NULL) {
+      if ((fseekw(fh, 0, SEEK_END) != 0) || (ftellw(fh) != 904)) {
+        ok = 0;
+      }
+      if ((fseekw(fh, -4, SEEK_END) != 0) ||
+          (fread(abuf, 1, 4, fh) != 4) || (memcmp(abuf, "tail", 4) != 0)) {
+        ok = 0;
+      }
+      fclose(fh);
+      fh = NULL;
+    } else {
+      ok = 0;
+    }
+    removet("aks_mapout_test.dat");
+  }
+#endif
+  if (ok) {
+    printf("Preallocated output test passed.\n");
+  } else {
+    printf("Preallocated output test FAILED.\n");
+  }
+#endif
+  
+#ifdef AKS_EMULATE_WIN_UNICODE
+  /* Round-trip characters of each UTF-8 length, including one that
+   * needs a surrogate pair, then check that an overlong form and an
+   * encoded surrogate are both refused */
+  ok = 0;
+  pApi = aks_toapi("a\xc3\xb6\xe2\x82\xac\xf0\x9f\x98\x80");
+  if (pApi != NULL) {
+    if ((pApi[0] == 0x61) && (pApi[1] == 0xf6) && (pApi[2] == 0x20ac) &&
+        (pApi[3] == 0xd83d) && (pApi[4] == 0xde00) && (pApi[5] == 0)) {
+      pResult = aks_fromapi(pApi);
+      if (pResult != NULL) {
+        if (strcmp(pResult,
+              "a\xc3\xb6\xe2\x82\xac\xf0\x9f\x98\x80") == 0) {
+          ok = 1;
+        }
+        free(pResult);
+        pResult = NULL;
+      }
+    }
+    free(pApi);
+    pApi = NULL;
+  }
+  for(i = 0; i < 2; i++) {
+    pApi = aks_toapi((i == 0) ? "/\xc0\xaf" : "\xed\xa0\x80");
+    if (pApi != NULL) {
+      ok = 0;
+      free(pApi);
+      pApi = NULL;
+    }
+  }
+  if (ok) {
+    printf("Unicode emulation test passed.\n");
+  } else {
+    printf("Unicode emulation test FAILED.\n");
+  }
+#endif
+  
   /* Try to get the PATH environment variable */
   pVar = getenvt("PATH");
   if (pVar != NULL) {
@@ -145,11 +968,8 @@ static int maint(int argc, char *argv[]) {
     if (!fseekw(fh, 0, SEEK_END)) {
       fs = ftellw(fh);
       if (fs >= 0) {
-#ifdef AKS_WIN
-        printf("File size: %I64d\n", fs);
-#else
-        printf("File size: %lld\n", (long long) fs);
-#endif
+        aks_fmt_i64(nbuf, (int64_t) fs);
+        printf("File size: %s\n", nbuf);
         
       } else {
         fprintf(stderr, "File tell failed!\n");
@@ -193,6 +1013,8 @@ static int maint(int argc, char *argv[]) {
     fprintf(stderr, "Not expecting more than one program argument!\n");
   }
   
+  aks_trace_end("maint");
+  
   /* Return successfully */
   return 0;
 }